@@ -0,0 +1,1098 @@
+#pragma once
+
+#include "rbtree_base.h"
+
+#include <stdexcept>
+
+namespace uxs {
+
+namespace detail {
+
+//-----------------------------------------------------------------------------
+// B-tree implementation
+
+struct btree_node_t {
+    btree_node_t* parent;
+    std::uint8_t pos;    // index in parent's child array
+    std::uint8_t count;  // number of values
+    bool leaf;
+};
+
+template<typename Val, unsigned N>
+struct btree_leaf_node_type : btree_node_t {
+    alignas(Val) std::uint8_t storage[N * sizeof(Val)];
+};
+
+template<typename Val, unsigned N>
+struct btree_internal_node_type : btree_leaf_node_type<Val, N> {
+    btree_node_t* children[N + 1];
+};
+
+template<typename Val>
+struct btree_node_traits_base {
+    // Node capacity is chosen to keep leaf nodes about 512 bytes, but within 16 to 64 values
+    enum : unsigned {
+        capacity = 512 / sizeof(Val) < 16 ? 16 : (512 / sizeof(Val) > 64 ? 64 : 512 / sizeof(Val)),
+        min_count = capacity / 2,
+    };
+    using leaf_node_t = btree_leaf_node_type<Val, capacity>;
+    using internal_node_t = btree_internal_node_type<Val, capacity>;
+    using node_t = leaf_node_t;
+    static Val& get_value(btree_node_t* node, unsigned pos) {
+        return reinterpret_cast<Val*>(static_cast<leaf_node_t*>(node)->storage)[pos];
+    }
+    static btree_node_t*& get_child(btree_node_t* node, unsigned pos) {
+        return static_cast<internal_node_t*>(node)->children[pos];
+    }
+    static btree_node_t* left_bound(btree_node_t* node) {
+        while (!node->leaf) { node = get_child(node, 0); }
+        return node;
+    }
+    static btree_node_t* right_bound(btree_node_t* node) {
+        while (!node->leaf) { node = get_child(node, node->count); }
+        return node;
+    }
+};
+
+template<typename Key>
+struct btree_set_node_traits : btree_node_traits_base<Key> {
+    using key_type = Key;
+    using value_type = Key;
+    static const key_type& get_key(const value_type& v) { return v; }
+    static key_type& get_lref_value(value_type& v) { return v; }
+    static key_type&& get_rref_value(value_type& v) { return std::move(v); }
+    using is_nothrow_relocatable = std::is_nothrow_move_constructible<Key>;
+};
+
+template<typename Key, typename Ty>
+struct btree_map_node_traits : btree_node_traits_base<std::pair<const Key, Ty>> {
+    using key_type = Key;
+    using mapped_type = Ty;
+    using value_type = std::pair<const Key, Ty>;
+    static const key_type& get_key(const value_type& v) { return v.first; }
+    static std::pair<Key&, Ty&> get_lref_value(value_type& v) {
+        return std::pair<Key&, Ty&>(const_cast<Key&>(v.first), v.second);
+    }
+    static std::pair<Key&&, Ty&&> get_rref_value(value_type& v) {
+        return std::pair<Key&&, Ty&&>(std::move(const_cast<Key&>(v.first)), std::move(v.second));
+    }
+    using is_nothrow_relocatable = std::integral_constant<bool, std::is_nothrow_move_constructible<Key>::value &&
+                                                                    std::is_nothrow_move_constructible<Ty>::value>;
+};
+
+//-----------------------------------------------------------------------------
+// B-tree iterator
+
+template<typename Traits, typename NodeTraits, bool Const>
+class btree_iterator : public container_iterator_facade<Traits, btree_iterator<Traits, NodeTraits, Const>,  //
+                                                        std::bidirectional_iterator_tag, Const> {
+ private:
+    using super = container_iterator_facade<Traits, btree_iterator, std::bidirectional_iterator_tag, Const>;
+
+ public:
+    using reference = typename super::reference;
+
+    template<typename, typename, bool>
+    friend class btree_iterator;
+
+    btree_iterator() noexcept = default;
+    btree_iterator(btree_node_t* node, unsigned pos) noexcept : node_(node), pos_(pos) {}
+
+    // This iterator consists of a pointer and an index,
+    // so explicit copy constructor and operator are not needed
+
+    template<bool Const_ = Const>
+    btree_iterator(const std::enable_if_t<Const_, btree_iterator<Traits, NodeTraits, false>>& it) noexcept
+        : node_(it.node_), pos_(it.pos_) {}
+    template<bool Const_ = Const>
+    btree_iterator& operator=(const std::enable_if_t<Const_, btree_iterator<Traits, NodeTraits, false>>& it) noexcept {
+        node_ = it.node_, pos_ = it.pos_;
+        return *this;
+    }
+
+    void increment() noexcept {
+        uxs_iterator_assert(node_ && pos_ < node_->count);
+        if (!node_->leaf) {
+            node_ = NodeTraits::left_bound(NodeTraits::get_child(node_, pos_ + 1)), pos_ = 0;
+            return;
+        }
+        if (++pos_ < node_->count) { return; }
+        // the end of leaf is reached: find the first parent, which has the next value,
+        // or stay at the end of the rightmost leaf
+        auto* node = node_;
+        unsigned pos = pos_;
+        while (pos == node->count) {
+            if (!node->parent) { return; }
+            pos = node->pos, node = node->parent;
+        }
+        node_ = node, pos_ = pos;
+    }
+
+    void decrement() noexcept {
+        uxs_iterator_assert(node_);
+        if (!node_->leaf) {
+            node_ = NodeTraits::right_bound(NodeTraits::get_child(node_, pos_)), pos_ = node_->count - 1;
+            return;
+        }
+        if (pos_ > 0) {
+            --pos_;
+            return;
+        }
+        while (pos_ == 0) {
+            uxs_iterator_assert(node_->parent);
+            pos_ = node_->pos, node_ = node_->parent;
+        }
+        --pos_;
+    }
+
+    template<bool Const2>
+    bool is_equal_to(const btree_iterator<Traits, NodeTraits, Const2>& it) const noexcept {
+        return node_ == it.node_ && pos_ == it.pos_;
+    }
+
+    reference dereference() const noexcept {
+        uxs_iterator_assert(node_ && pos_ < node_->count);
+        return NodeTraits::get_value(node_, pos_);
+    }
+
+    btree_node_t* node() const noexcept { return node_; }
+    unsigned pos() const noexcept { return pos_; }
+
+ private:
+    btree_node_t* node_ = nullptr;
+    unsigned pos_ = 0;
+};
+
+//-----------------------------------------------------------------------------
+// B-tree node handle implementation: the value is kept inside the handle
+
+template<typename NodeTraits, typename Alloc, typename NodeHandle, typename = void>
+class btree_node_handle_getters
+    : protected std::allocator_traits<Alloc>::template rebind_alloc<typename NodeTraits::node_t> {
+ protected:
+    using node_traits = NodeTraits;
+    using alloc_type = typename std::allocator_traits<Alloc>::template rebind_alloc<typename node_traits::node_t>;
+
+ public:
+    using value_type = typename node_traits::value_type;
+    btree_node_handle_getters() noexcept(std::is_nothrow_default_constructible<alloc_type>::value)
+        : alloc_type(Alloc()) {}
+    explicit btree_node_handle_getters(const alloc_type& alloc) noexcept : alloc_type(alloc) {}
+    value_type& value() const { return *static_cast<const NodeHandle*>(this)->get(); }
+};
+
+template<typename NodeTraits, typename Alloc, typename NodeHandle>
+class btree_node_handle_getters<NodeTraits, Alloc, NodeHandle, std::void_t<typename NodeTraits::mapped_type>>
+    : protected std::allocator_traits<Alloc>::template rebind_alloc<typename NodeTraits::node_t> {
+ protected:
+    using node_traits = NodeTraits;
+    using alloc_type = typename std::allocator_traits<Alloc>::template rebind_alloc<typename node_traits::node_t>;
+
+ public:
+    using key_type = typename node_traits::key_type;
+    using mapped_type = typename node_traits::mapped_type;
+    btree_node_handle_getters() noexcept(std::is_nothrow_default_constructible<alloc_type>::value)
+        : alloc_type(Alloc()) {}
+    explicit btree_node_handle_getters(const alloc_type& alloc) noexcept : alloc_type(alloc) {}
+    key_type& key() const { return node_traits::get_lref_value(*static_cast<const NodeHandle*>(this)->get()).first; }
+    mapped_type& mapped() const { return static_cast<const NodeHandle*>(this)->get()->second; }
+};
+
+template<typename NodeTraits, typename Alloc>
+class btree_node_handle : public btree_node_handle_getters<NodeTraits, Alloc, btree_node_handle<NodeTraits, Alloc>> {
+ private:
+    using super = btree_node_handle_getters<NodeTraits, Alloc, btree_node_handle>;
+    using node_traits = NodeTraits;
+    using alloc_type = typename super::alloc_type;
+    using alloc_traits = std::allocator_traits<alloc_type>;
+    using value_type = typename node_traits::value_type;
+
+ public:
+    using allocator_type = Alloc;
+
+    btree_node_handle() noexcept(noexcept(super())) : super() {}
+    btree_node_handle(btree_node_handle&& nh) noexcept(std::is_nothrow_move_constructible<value_type>::value)
+        : super(static_cast<const alloc_type&>(nh)) {
+        if (nh.has_value_) { construct_from(nh); }
+    }
+
+    btree_node_handle& operator=(btree_node_handle&& nh) noexcept(
+        std::is_nothrow_move_constructible<value_type>::value) {
+        assert(std::addressof(nh) != this);
+        if (std::addressof(nh) == this) { return *this; }
+        if (has_value_) { tidy(); }
+        alloc_type::operator=(static_cast<const alloc_type&>(nh));
+        if (nh.has_value_) { construct_from(nh); }
+        return *this;
+    }
+
+    ~btree_node_handle() {
+        if (has_value_) { tidy(); }
+    }
+
+    allocator_type get_allocator() const noexcept { return allocator_type(*this); }
+    bool empty() const noexcept { return !has_value_; }
+    explicit operator bool() const noexcept { return has_value_; }
+    void swap(btree_node_handle& nh) {
+        if (std::addressof(nh) == this) { return; }
+        btree_node_handle tmp(std::move(nh));
+        nh = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+ private:
+    alignas(value_type) std::uint8_t storage_[sizeof(value_type)];
+    bool has_value_ = false;
+
+    template<typename, typename, typename, typename>
+    friend class btree_node_handle_getters;
+    template<typename, typename, typename>
+    friend class btree_base;
+    template<typename, typename, typename>
+    friend class btree_unique;
+    template<typename, typename, typename>
+    friend class btree_multi;
+
+    explicit btree_node_handle(const alloc_type& alloc) noexcept : super(alloc) {}
+
+    value_type* get() const { return reinterpret_cast<value_type*>(const_cast<std::uint8_t*>(storage_)); }
+
+    template<typename... Args>
+    void construct(Args&&... args) {
+        alloc_traits::construct(*this, get(), std::forward<Args>(args)...);
+        has_value_ = true;
+    }
+
+    void construct_from(btree_node_handle& nh) {
+        construct(node_traits::get_rref_value(*nh.get()));
+        nh.tidy();
+    }
+
+    void tidy() {
+        alloc_traits::destroy(*this, get());
+        has_value_ = false;
+    }
+};
+
+//-----------------------------------------------------------------------------
+// B-tree base
+
+template<typename NodeTraits, typename Alloc, typename Comp>
+class btree_base : protected rbtree_compare<NodeTraits, Alloc, Comp> {
+ protected:
+    using node_traits = NodeTraits;
+    using super = rbtree_compare<node_traits, Alloc, Comp>;
+    using alloc_type = typename super::alloc_type;
+    using alloc_traits = std::allocator_traits<alloc_type>;
+    using internal_alloc_type = typename alloc_traits::template rebind_alloc<typename node_traits::internal_node_t>;
+    using internal_alloc_traits = std::allocator_traits<internal_alloc_type>;
+    using value_alloc_type =
+        typename std::allocator_traits<Alloc>::template rebind_alloc<typename node_traits::value_type>;
+    using value_alloc_traits = std::allocator_traits<value_alloc_type>;
+
+    enum : unsigned { capacity = node_traits::capacity, min_count = node_traits::min_count };
+
+    // Values are moved between nodes when nodes are split or merged, and these moves can't be undone
+    static_assert(node_traits::is_nothrow_relocatable::value, "B-tree values must be nothrow move constructible");
+
+ public:
+    using key_type = typename node_traits::key_type;
+    using value_type = typename node_traits::value_type;
+    using allocator_type = Alloc;
+    using key_compare = Comp;
+    using size_type = typename alloc_traits::size_type;
+    using difference_type = typename alloc_traits::difference_type;
+    using pointer = typename value_alloc_traits::pointer;
+    using const_pointer = typename value_alloc_traits::const_pointer;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using iterator = btree_iterator<btree_base, node_traits, std::is_same<key_type, value_type>::value>;
+    using const_iterator = btree_iterator<btree_base, node_traits, true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using node_type = btree_node_handle<node_traits, Alloc>;
+
+    btree_base() noexcept(noexcept(super())) : super() { init(); }
+    explicit btree_base(const allocator_type& alloc) noexcept(noexcept(super(alloc))) : super(alloc) { init(); }
+    explicit btree_base(const key_compare& comp, const allocator_type& alloc) : super(alloc, comp) { init(); }
+
+    btree_base(const btree_base& other)
+        : super(alloc_traits::select_on_container_copy_construction(other), other.get_compare()) {
+        init();
+        append_range(other, node_traits::get_lref_value);
+    }
+
+    btree_base(const btree_base& other, const allocator_type& alloc) : super(alloc, other.get_compare()) {
+        init();
+        append_range(other, node_traits::get_lref_value);
+    }
+
+    btree_base& operator=(const btree_base& other) {
+        if (std::addressof(other) == this) { return *this; }
+        this->change_compare(other.get_compare());
+        tidy();
+        if (alloc_traits::propagate_on_container_copy_assignment::value && !is_same_alloc(other)) {
+            alloc_type::operator=(other);
+        }
+        append_range(other, node_traits::get_lref_value);
+        return *this;
+    }
+
+    btree_base(btree_base&& other) noexcept(noexcept(super(std::move(other)))) : super(std::move(other)) {
+        init();
+        steal_data(other);
+    }
+
+    btree_base(btree_base&& other, const allocator_type& alloc) : super(alloc, std::move(other.get_compare())) {
+        init();
+        if (is_alloc_always_equal<alloc_type>::value || is_same_alloc(other)) {
+            steal_data(other);
+        } else {
+            append_range(other, node_traits::get_rref_value);
+            other.tidy();
+        }
+    }
+
+    btree_base& operator=(btree_base&& other) noexcept(std::is_nothrow_move_assignable<super>::value &&
+                                                       (alloc_traits::propagate_on_container_move_assignment::value ||
+                                                        is_alloc_always_equal<alloc_type>::value)) {
+        if (std::addressof(other) == this) { return *this; }
+        this->change_compare(std::move(other.get_compare()));
+        tidy();
+        if (alloc_traits::propagate_on_container_move_assignment::value) {
+            alloc_type::operator=(std::move(other));
+            steal_data(other);
+        } else if (is_alloc_always_equal<alloc_type>::value || is_same_alloc(other)) {
+            steal_data(other);
+        } else {
+            append_range(other, node_traits::get_rref_value);
+            other.tidy();
+        }
+        return *this;
+    }
+
+    ~btree_base() { tidy(); }
+
+    allocator_type get_allocator() const noexcept { return allocator_type(*this); }
+    key_compare key_comp() const { return this->get_compare(); }
+
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+    size_type max_size() const noexcept { return value_alloc_traits::max_size(value_alloc_type(*this)); }
+
+    iterator begin() noexcept { return iterator(leftmost_, 0); }
+    const_iterator begin() const noexcept { return const_iterator(leftmost_, 0); }
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator end() noexcept { return iterator(rightmost_, rightmost_->count); }
+    const_iterator end() const noexcept { return const_iterator(rightmost_, rightmost_->count); }
+    const_iterator cend() const noexcept { return end(); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    reference front() {
+        assert(size_);
+        return node_traits::get_value(leftmost_, 0);
+    }
+    const_reference front() const {
+        assert(size_);
+        return node_traits::get_value(leftmost_, 0);
+    }
+
+    reference back() {
+        assert(size_);
+        return node_traits::get_value(rightmost_, rightmost_->count - 1);
+    }
+    const_reference back() const {
+        assert(size_);
+        return node_traits::get_value(rightmost_, rightmost_->count - 1);
+    }
+
+    // - find
+
+    iterator find(const key_type& key) { return to_iterator(find_impl(key)); }
+
+    template<typename Key, typename Comp_ = key_compare>
+    est::type_identity_t<iterator, typename Comp_::is_transparent> find(const Key& key) {
+        return to_iterator(find_impl(key));
+    }
+
+    const_iterator find(const key_type& key) const { return find_impl(key); }
+
+    template<typename Key, typename Comp_ = key_compare>
+    est::type_identity_t<const_iterator, typename Comp_::is_transparent> find(const Key& key) const {
+        return find_impl(key);
+    }
+
+    // - lower_bound
+
+    iterator lower_bound(const key_type& key) { return to_iterator(lower_bound_impl(key)); }
+
+    template<typename Key, typename Comp_ = key_compare>
+    est::type_identity_t<iterator, typename Comp_::is_transparent> lower_bound(const Key& key) {
+        return to_iterator(lower_bound_impl(key));
+    }
+
+    const_iterator lower_bound(const key_type& key) const { return lower_bound_impl(key); }
+
+    template<typename Key, typename Comp_ = key_compare>
+    est::type_identity_t<const_iterator, typename Comp_::is_transparent> lower_bound(const Key& key) const {
+        return lower_bound_impl(key);
+    }
+
+    // - upper_bound
+
+    iterator upper_bound(const key_type& key) { return to_iterator(upper_bound_impl(key)); }
+
+    template<typename Key, typename Comp_ = key_compare>
+    est::type_identity_t<iterator, typename Comp_::is_transparent> upper_bound(const Key& key) {
+        return to_iterator(upper_bound_impl(key));
+    }
+
+    const_iterator upper_bound(const key_type& key) const { return upper_bound_impl(key); }
+
+    template<typename Key, typename Comp_ = key_compare>
+    est::type_identity_t<const_iterator, typename Comp_::is_transparent> upper_bound(const Key& key) const {
+        return upper_bound_impl(key);
+    }
+
+    // - equal_range
+
+    std::pair<iterator, iterator> equal_range(const key_type& key) {
+        return std::make_pair(to_iterator(lower_bound_impl(key)), to_iterator(upper_bound_impl(key)));
+    }
+
+    template<typename Key, typename Comp_ = key_compare>
+    est::type_identity_t<std::pair<iterator, iterator>, typename Comp_::is_transparent> equal_range(const Key& key) {
+        return std::make_pair(to_iterator(lower_bound_impl(key)), to_iterator(upper_bound_impl(key)));
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+        return std::make_pair(lower_bound_impl(key), upper_bound_impl(key));
+    }
+
+    template<typename Key, typename Comp_ = key_compare>
+    est::type_identity_t<std::pair<const_iterator, const_iterator>, typename Comp_::is_transparent> equal_range(
+        const Key& key) const {
+        return std::make_pair(lower_bound_impl(key), upper_bound_impl(key));
+    }
+
+    // - count
+
+    size_type count(const key_type& key) const {
+        size_type count = 0;
+        for (auto it : make_range(equal_range(key))) { ++count, (void)it; }
+        return count;
+    }
+
+    template<typename Key, typename Comp_ = key_compare>
+    est::type_identity_t<size_type, typename Comp_::is_transparent> count(const Key& key) const {
+        size_type count = 0;
+        for (auto it : make_range(equal_range(key))) { ++count, (void)it; }
+        return count;
+    }
+
+    // - contains
+
+    bool contains(const key_type& key) const { return find(key) != end(); }
+
+    template<typename Key, typename Comp_ = key_compare>
+    est::type_identity_t<bool, typename Comp_::is_transparent> contains(const Key& key) const {
+        return find(key) != end();
+    }
+
+    // - clear, erase
+
+    void clear() { tidy(); }
+
+    iterator erase(const_iterator pos) {
+        assert(pos != end());
+        return erase_impl(pos.node(), pos.pos());
+    }
+
+    template<typename Key_ = key_type>
+    iterator erase(std::enable_if_t<!std::is_same<Key_, value_type>::value, iterator> pos) {
+        return erase(static_cast<const_iterator>(pos));
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        // values are moved by erasure, so the last position is tracked by the number of erased values
+        size_type n = 0;
+        for (auto it = first; it != last; ++it) { ++n; }
+        iterator it(first.node(), first.pos());
+        for (; n; --n) { it = erase_impl(it.node(), it.pos()); }
+        return it;
+    }
+
+    size_type erase(const key_type& key) { return erase_key_impl(key); }
+
+    template<typename Key, typename Comp_ = key_compare>
+    est::type_identity_t<size_type, typename Comp_::is_transparent> erase(const Key& key) {
+        return erase_key_impl(key);
+    }
+
+    node_type extract(const_iterator pos) {
+        assert(pos != end());
+        node_type nh(*this);
+        nh.construct(node_traits::get_rref_value(node_traits::get_value(pos.node(), pos.pos())));
+        erase_impl(pos.node(), pos.pos());
+        return nh;
+    }
+
+    node_type extract(const key_type& key) {
+        auto it = find(key);
+        if (it != end()) { return extract(it); }
+        return node_type(*this);
+    }
+
+    template<typename Key, typename Comp_ = key_compare>
+    est::type_identity_t<node_type, typename Comp_::is_transparent> extract(const Key& key) {
+        auto it = find(key);
+        if (it != end()) { return extract(it); }
+        return node_type(*this);
+    }
+
+ protected:
+    struct value_compare_func {
+        using result_type = bool;
+        using first_argument_type = value_type;
+        using second_argument_type = value_type;
+        value_compare_func(const key_compare& comp_) : comp(comp_) {}
+        bool operator()(const value_type& lhs, const value_type& rhs) const {
+            return comp(node_traits::get_key(lhs), node_traits::get_key(rhs));
+        }
+        key_compare comp;
+    };
+
+    // Temporary value used to obtain the key before insertion position is known
+    struct temp_value_t {
+        btree_base* tree;
+        alignas(value_type) std::uint8_t storage[sizeof(value_type)];
+        template<typename... Args>
+        explicit temp_value_t(btree_base* t, Args&&... args) : tree(t) {
+            alloc_traits::construct(*tree, get(), std::forward<Args>(args)...);
+        }
+        ~temp_value_t() { alloc_traits::destroy(*tree, get()); }
+        temp_value_t(const temp_value_t&) = delete;
+        temp_value_t& operator=(const temp_value_t&) = delete;
+        value_type* get() { return reinterpret_cast<value_type*>(storage); }
+        const key_type& key() { return node_traits::get_key(*get()); }
+    };
+
+    btree_node_t head_;  // represents the end of empty tree
+    btree_node_t* root_ = nullptr;
+    btree_node_t* leftmost_ = nullptr;
+    btree_node_t* rightmost_ = nullptr;
+    size_type size_ = 0;
+
+    const key_type& key_at(btree_node_t* node, unsigned pos) const {
+        return node_traits::get_key(node_traits::get_value(node, pos));
+    }
+
+    template<typename Key>
+    unsigned lower_index(btree_node_t* node, const Key& key) const {
+        // branch-free binary search: nodes are small, so mispredictions cost more than extra comparisons
+        unsigned base = 0, n = node->count;
+        while (n > 1) {
+            const unsigned half = n >> 1;
+            base = this->get_compare()(key_at(node, base + half), key) ? base + half : base;
+            n -= half;
+        }
+        return n && this->get_compare()(key_at(node, base), key) ? base + 1 : base;
+    }
+
+    template<typename Key>
+    unsigned upper_index(btree_node_t* node, const Key& key) const {
+        // branch-free binary search: nodes are small, so mispredictions cost more than extra comparisons
+        unsigned base = 0, n = node->count;
+        while (n > 1) {
+            const unsigned half = n >> 1;
+            base = !this->get_compare()(key, key_at(node, base + half)) ? base + half : base;
+            n -= half;
+        }
+        return n && !this->get_compare()(key, key_at(node, base)) ? base + 1 : base;
+    }
+
+    template<typename Key>
+    const_iterator lower_bound_impl(const Key& key) const {
+        const_iterator result = end();
+        for (auto* node = root_; node;) {
+            const unsigned pos = lower_index(node, key);
+            if (pos < node->count) { result = const_iterator(node, pos); }
+            if (node->leaf) { break; }
+            node = node_traits::get_child(node, pos);
+        }
+        return result;
+    }
+
+    template<typename Key>
+    const_iterator upper_bound_impl(const Key& key) const {
+        const_iterator result = end();
+        for (auto* node = root_; node;) {
+            const unsigned pos = upper_index(node, key);
+            if (pos < node->count) { result = const_iterator(node, pos); }
+            if (node->leaf) { break; }
+            node = node_traits::get_child(node, pos);
+        }
+        return result;
+    }
+
+    template<typename Key>
+    const_iterator find_impl(const Key& key) const {
+        for (auto* node = root_; node;) {
+            const unsigned pos = lower_index(node, key);
+            if (pos < node->count && !this->get_compare()(key, key_at(node, pos))) {
+                // for multiple keys the first equal value can be in the left subtree
+                if (node->leaf) { return const_iterator(node, pos); }
+                return lower_bound_impl(key);
+            }
+            if (node->leaf) { break; }
+            node = node_traits::get_child(node, pos);
+        }
+        return end();
+    }
+
+    template<typename Key>
+    size_type erase_key_impl(const Key& key) {
+        size_type n = 0;
+        auto it = lower_bound_impl(key);
+        for (; it != end() && !this->get_compare()(key, node_traits::get_key(*it)); ++n) {
+            it = erase_impl(it.node(), it.pos());
+        }
+        return n;
+    }
+
+    // Returns leaf insertion position for unique key, or the position of existing equal key
+    template<typename Key>
+    std::pair<const_iterator, bool> find_insert_unique_pos(const Key& key) const {
+        if (!root_) { return std::make_pair(end(), true); }
+        for (auto* node = root_;;) {
+            const unsigned pos = lower_index(node, key);
+            if (pos < node->count && !this->get_compare()(key, key_at(node, pos))) {
+                return std::make_pair(const_iterator(node, pos), false);
+            }
+            if (node->leaf) { return std::make_pair(const_iterator(node, pos), true); }
+            node = node_traits::get_child(node, pos);
+        }
+    }
+
+    // Returns leaf insertion position after all equal keys
+    template<typename Key>
+    const_iterator find_insert_pos(const Key& key) const {
+        if (!root_) { return end(); }
+        auto* node = root_;
+        while (true) {
+            const unsigned pos = upper_index(node, key);
+            if (node->leaf) { return const_iterator(node, pos); }
+            node = node_traits::get_child(node, pos);
+        }
+    }
+
+    // Converts iterator to leaf insertion position before it
+    static const_iterator leaf_pos_before(const_iterator it) {
+        if (it.node()->leaf) { return it; }
+        auto* node = node_traits::right_bound(node_traits::get_child(it.node(), it.pos()));
+        return const_iterator(node, node->count);
+    }
+
+    template<typename Key>
+    std::pair<const_iterator, bool> find_insert_unique_pos(const_iterator hint, const Key& key) const {
+        if (!root_) { return std::make_pair(end(), true); }
+        const auto& comp = this->get_compare();
+        if (hint == end() || comp(key, node_traits::get_key(*hint))) {
+            if (hint == begin()) { return std::make_pair(leaf_pos_before(hint), true); }
+            auto prev = std::prev(hint);
+            if (comp(node_traits::get_key(*prev), key)) { return std::make_pair(leaf_pos_before(hint), true); }
+            if (!comp(key, node_traits::get_key(*prev))) { return std::make_pair(prev, false); }
+        } else if (!comp(node_traits::get_key(*hint), key)) {
+            return std::make_pair(hint, false);
+        } else {
+            auto next = std::next(hint);
+            if (next == end() || comp(key, node_traits::get_key(*next))) {
+                return std::make_pair(leaf_pos_before(next), true);
+            }
+        }
+        return find_insert_unique_pos(key);
+    }
+
+    template<typename Key>
+    const_iterator find_insert_pos(const_iterator hint, const Key& key) const {
+        if (!root_) { return end(); }
+        const auto& comp = this->get_compare();
+        if ((hint == end() || !comp(node_traits::get_key(*hint), key)) &&
+            (hint == begin() || !comp(key, node_traits::get_key(*std::prev(hint))))) {
+            return leaf_pos_before(hint);
+        }
+        return find_insert_pos(key);
+    }
+
+    static iterator to_iterator(const_iterator it) { return iterator(it.node(), it.pos()); }
+
+    static value_type& node_value(node_type& nh) { return *nh.get(); }
+    static void node_reset(node_type& nh) { nh.tidy(); }
+
+    template<typename... Args>
+    iterator insert_at(const_iterator pos, Args&&... args);
+    iterator erase_impl(btree_node_t* node, unsigned pos);
+
+    template<typename Src, typename CopyFunc>
+    void append_range(Src&& src, CopyFunc fn) {
+        // appending sorted values produces dense nodes
+        try {
+            for (auto it = src.begin(); it != src.end(); ++it) {
+                insert_at(end(), fn(node_traits::get_value(it.node(), it.pos())));
+            }
+        } catch (...) {
+            tidy();
+            throw;
+        }
+    }
+
+    void tidy() {
+        if (!root_) { return; }
+        delete_recursive(root_);
+        reset();
+    }
+
+    void swap_impl(btree_base& other, std::true_type) noexcept(std::is_nothrow_swappable<key_compare>::value) {
+        std::swap(static_cast<alloc_type&>(*this), static_cast<alloc_type&>(other));
+        swap_impl(other, std::false_type());
+    }
+
+    void swap_impl(btree_base& other, std::false_type) noexcept(std::is_nothrow_swappable<key_compare>::value) {
+        this->swap_compare(other.get_compare());
+        std::swap(root_, other.root_);
+        std::swap(leftmost_, other.leftmost_);
+        std::swap(rightmost_, other.rightmost_);
+        std::swap(size_, other.size_);
+        if (!root_) { leftmost_ = rightmost_ = &head_; }
+        if (!other.root_) { other.leftmost_ = other.rightmost_ = &other.head_; }
+    }
+
+    bool is_same_alloc(const alloc_type& alloc) { return static_cast<alloc_type&>(*this) == alloc; }
+
+    template<typename InputIt>
+    static bool check_iterator_range(InputIt first, InputIt last, std::true_type) {
+        return first <= last;
+    }
+
+    template<typename InputIt>
+    static bool check_iterator_range(InputIt /*first*/, InputIt /*last*/, std::false_type) {
+        return true;
+    }
+
+ private:
+    template<typename, typename, typename>
+    friend class btree_base;
+    template<typename, typename, typename>
+    friend class btree_unique;
+    template<typename, typename, typename>
+    friend class btree_multi;
+
+    void init() {
+        head_.parent = nullptr, head_.pos = 0, head_.count = 0, head_.leaf = true;
+        leftmost_ = rightmost_ = &head_;
+    }
+
+    void reset() {
+        root_ = nullptr;
+        leftmost_ = rightmost_ = &head_;
+        size_ = 0;
+    }
+
+    void steal_data(btree_base& other) {
+        if (!other.root_) { return; }
+        root_ = other.root_, leftmost_ = other.leftmost_, rightmost_ = other.rightmost_, size_ = other.size_;
+        other.reset();
+    }
+
+    btree_node_t* new_node(bool leaf) {
+        btree_node_t* node = nullptr;
+        if (leaf) {
+            node = static_cast<btree_node_t*>(std::addressof(*alloc_traits::allocate(*this, 1)));
+        } else {
+            internal_alloc_type alloc(*this);
+            node = static_cast<btree_node_t*>(std::addressof(*internal_alloc_traits::allocate(alloc, 1)));
+        }
+        node->parent = nullptr, node->pos = 0, node->count = 0, node->leaf = leaf;
+        return node;
+    }
+
+    void delete_node(btree_node_t* node) {
+        if (node->leaf) {
+            alloc_traits::deallocate(*this, static_cast<typename node_traits::leaf_node_t*>(node), 1);
+        } else {
+            internal_alloc_type alloc(*this);
+            internal_alloc_traits::deallocate(alloc, static_cast<typename node_traits::internal_node_t*>(node), 1);
+        }
+    }
+
+    void delete_recursive(btree_node_t* node) {
+        for (unsigned pos = 0; pos < node->count; ++pos) {
+            alloc_traits::destroy(*this, std::addressof(node_traits::get_value(node, pos)));
+        }
+        if (!node->leaf) {
+            for (unsigned pos = 0; pos <= node->count; ++pos) { delete_recursive(node_traits::get_child(node, pos)); }
+        }
+        delete_node(node);
+    }
+
+    void relocate(btree_node_t* dst_node, unsigned dst_pos, btree_node_t* src_node, unsigned src_pos) noexcept {
+        auto& src = node_traits::get_value(src_node, src_pos);
+        alloc_traits::construct(*this, std::addressof(node_traits::get_value(dst_node, dst_pos)),
+                                node_traits::get_rref_value(src));
+        alloc_traits::destroy(*this, std::addressof(src));
+    }
+
+    void set_child(btree_node_t* node, unsigned pos, btree_node_t* child) noexcept {
+        node_traits::get_child(node, pos) = child;
+        child->parent = node, child->pos = static_cast<std::uint8_t>(pos);
+    }
+
+    // makes a gap at `pos` position of non-full node
+    void shift_right(btree_node_t* node, unsigned pos) noexcept {
+        for (unsigned i = node->count; i > pos; --i) { relocate(node, i, node, i - 1); }
+        if (!node->leaf) {
+            for (unsigned i = node->count + 1; i > pos + 1; --i) {
+                set_child(node, i, node_traits::get_child(node, i - 1));
+            }
+        }
+    }
+
+    void split_node(btree_node_t* node, unsigned n_left);
+
+    struct track_t {
+        btree_node_t* node;
+        unsigned pos;
+    };
+
+    void merge_children(btree_node_t* parent, unsigned pos, track_t& t) noexcept;
+    void borrow_from_left(btree_node_t* parent, unsigned pos, track_t& t) noexcept;
+    void borrow_from_right(btree_node_t* parent, unsigned pos, track_t& t) noexcept;
+};
+
+// Splits full `node` into two halves: the left one keeps `n_left` values, the next value goes up to the parent.
+// New nodes are allocated before any change, so the tree stays valid on exception
+template<typename NodeTraits, typename Alloc, typename Comp>
+void btree_base<NodeTraits, Alloc, Comp>::split_node(btree_node_t* node, unsigned n_left) {
+    assert(node->count == capacity && n_left < capacity);
+    auto* sibling = new_node(node->leaf);
+    auto* parent = node->parent;
+    if (!parent) {
+        try {
+            parent = new_node(false);
+        } catch (...) {
+            delete_node(sibling);
+            throw;
+        }
+        set_child(parent, 0, node);
+        root_ = parent;
+    }
+
+    // move upper values and children to the sibling
+    const unsigned n_right = capacity - n_left - 1;
+    for (unsigned i = 0; i < n_right; ++i) { relocate(sibling, i, node, n_left + 1 + i); }
+    if (!node->leaf) {
+        for (unsigned i = 0; i <= n_right; ++i) { set_child(sibling, i, node_traits::get_child(node, n_left + 1 + i)); }
+    }
+    sibling->count = static_cast<std::uint8_t>(n_right);
+
+    // move the median value to the parent
+    const unsigned pos = node->pos;
+    shift_right(parent, pos);
+    relocate(parent, pos, node, n_left);
+    set_child(parent, pos + 1, sibling);
+    ++parent->count;
+    node->count = static_cast<std::uint8_t>(n_left);
+
+    if (node == rightmost_) { rightmost_ = sibling; }
+}
+
+template<typename NodeTraits, typename Alloc, typename Comp>
+template<typename... Args>
+auto btree_base<NodeTraits, Alloc, Comp>::insert_at(const_iterator it, Args&&... args) -> iterator {
+    auto* node = it.node();
+    unsigned pos = it.pos();
+    if (!root_) {
+        root_ = leftmost_ = rightmost_ = node = new_node(true);
+        pos = 0;
+    }
+
+    assert(node->leaf);
+    while (node->count == capacity) {
+        // split the topmost full node on the path first, so that its parent has room for the median
+        btree_node_t* child = nullptr;
+        auto* full = node;
+        while (full->parent && full->parent->count == capacity) { child = full, full = full->parent; }
+        if (full == node) {
+            // favor dense nodes for ascending and descending insertion
+            const unsigned n_left = pos == capacity ? capacity - 1 : (pos == 0 ? 0 : capacity / 2);
+            split_node(node, n_left);
+            if (pos > n_left) { node = node_traits::get_child(node->parent, node->pos + 1), pos -= n_left + 1; }
+        } else {
+            if (!child) { child = node; }
+            while (child->parent != full) { child = child->parent; }
+            const unsigned c = child->pos;
+            split_node(full, c == capacity ? capacity - 2 : (c == 0 ? 1 : capacity / 2));
+        }
+    }
+
+    shift_right(node, pos);
+    try {
+        alloc_traits::construct(*this, std::addressof(node_traits::get_value(node, pos)), std::forward<Args>(args)...);
+    } catch (...) {
+        for (unsigned i = pos; i < node->count; ++i) { relocate(node, i, node, i + 1); }
+        throw;
+    }
+    ++node->count, ++size_;
+    return iterator(node, pos);
+}
+
+template<typename NodeTraits, typename Alloc, typename Comp>
+auto btree_base<NodeTraits, Alloc, Comp>::erase_impl(btree_node_t* node, unsigned pos) -> iterator {
+    // the position of the value following the erased one is tracked through rebalancing
+    const bool is_last = node == rightmost_ && pos + 1 == node->count;
+    track_t t{nullptr, 0};
+    btree_node_t* leaf = node;
+    alloc_traits::destroy(*this, std::addressof(node_traits::get_value(node, pos)));
+    if (node->leaf) {
+        if (pos + 1 < node->count) {
+            t = {node, pos};
+        } else if (!is_last) {
+            auto* n = node;
+            while (n->pos == n->parent->count) { n = n->parent; }
+            t = {n->parent, n->pos};
+        }
+        for (unsigned i = pos; i + 1 < node->count; ++i) { relocate(node, i, node, i + 1); }
+    } else {
+        // replace with the previous value, which is always in a leaf
+        leaf = node_traits::right_bound(node_traits::get_child(node, pos));
+        t = {node_traits::left_bound(node_traits::get_child(node, pos + 1)), 0};
+        relocate(node, pos, leaf, leaf->count - 1);
+    }
+    --leaf->count, --size_;
+
+    // restore minimal node occupancy
+    node = leaf;
+    while (node->parent) {
+        if (node->count >= min_count) { break; }
+        auto* parent = node->parent;
+        const unsigned child_pos = node->pos;
+        if (child_pos > 0) {
+            if (node_traits::get_child(parent, child_pos - 1)->count + node->count < capacity) {
+                merge_children(parent, child_pos - 1, t);
+                node = parent;
+                continue;
+            }
+            borrow_from_left(parent, child_pos, t);
+        } else {
+            if (node->count + node_traits::get_child(parent, 1)->count < capacity) {
+                merge_children(parent, 0, t);
+                node = parent;
+                continue;
+            }
+            borrow_from_right(parent, 0, t);
+        }
+        break;
+    }
+
+    if (!root_->count) {
+        auto* old_root = root_;
+        if (root_->leaf) {
+            reset();
+        } else {
+            root_ = node_traits::get_child(root_, 0);
+            root_->parent = nullptr, root_->pos = 0;
+        }
+        delete_node(old_root);
+    }
+
+    return is_last ? end() : iterator(t.node, t.pos);
+}
+
+template<typename NodeTraits, typename Alloc, typename Comp>
+void btree_base<NodeTraits, Alloc, Comp>::merge_children(btree_node_t* parent, unsigned pos, track_t& t) noexcept {
+    auto* left = node_traits::get_child(parent, pos);
+    auto* right = node_traits::get_child(parent, pos + 1);
+    const unsigned n_left = left->count;
+    if (t.node == parent && t.pos == pos) {
+        t = {left, n_left};
+    } else if (t.node == parent && t.pos > pos) {
+        --t.pos;
+    } else if (t.node == right) {
+        t = {left, n_left + 1 + t.pos};
+    }
+
+    relocate(left, n_left, parent, pos);
+    for (unsigned i = 0; i < right->count; ++i) { relocate(left, n_left + 1 + i, right, i); }
+    if (!left->leaf) {
+        for (unsigned i = 0; i <= right->count; ++i) {
+            set_child(left, n_left + 1 + i, node_traits::get_child(right, i));
+        }
+    }
+    left->count = static_cast<std::uint8_t>(n_left + 1 + right->count);
+
+    for (unsigned i = pos; i + 1 < parent->count; ++i) { relocate(parent, i, parent, i + 1); }
+    for (unsigned i = pos + 1; i < parent->count; ++i) { set_child(parent, i, node_traits::get_child(parent, i + 1)); }
+    --parent->count;
+
+    if (right == rightmost_) { rightmost_ = left; }
+    delete_node(right);
+}
+
+template<typename NodeTraits, typename Alloc, typename Comp>
+void btree_base<NodeTraits, Alloc, Comp>::borrow_from_left(btree_node_t* parent, unsigned pos, track_t& t) noexcept {
+    auto* node = node_traits::get_child(parent, pos);
+    auto* left = node_traits::get_child(parent, pos - 1);
+    if (t.node == node) {
+        ++t.pos;
+    } else if (t.node == parent && t.pos == pos - 1) {
+        t = {node, 0};
+    } else if (t.node == left && t.pos == left->count - 1u) {
+        t = {parent, pos - 1};
+    }
+
+    for (unsigned i = node->count; i > 0; --i) { relocate(node, i, node, i - 1); }
+    relocate(node, 0, parent, pos - 1);
+    relocate(parent, pos - 1, left, left->count - 1);
+    if (!node->leaf) {
+        for (unsigned i = node->count + 1; i > 0; --i) { set_child(node, i, node_traits::get_child(node, i - 1)); }
+        set_child(node, 0, node_traits::get_child(left, left->count));
+    }
+    --left->count, ++node->count;
+}
+
+template<typename NodeTraits, typename Alloc, typename Comp>
+void btree_base<NodeTraits, Alloc, Comp>::borrow_from_right(btree_node_t* parent, unsigned pos, track_t& t) noexcept {
+    auto* node = node_traits::get_child(parent, pos);
+    auto* right = node_traits::get_child(parent, pos + 1);
+    const unsigned n = node->count;
+    if (t.node == parent && t.pos == pos) {
+        t = {node, n};
+    } else if (t.node == right) {
+        if (t.pos == 0) {
+            t = {parent, pos};
+        } else {
+            --t.pos;
+        }
+    }
+
+    relocate(node, n, parent, pos);
+    relocate(parent, pos, right, 0);
+    for (unsigned i = 0; i + 1 < right->count; ++i) { relocate(right, i, right, i + 1); }
+    if (!node->leaf) {
+        set_child(node, n + 1, node_traits::get_child(right, 0));
+        for (unsigned i = 0; i < right->count; ++i) { set_child(right, i, node_traits::get_child(right, i + 1)); }
+    }
+    --right->count, ++node->count;
+}
+
+}  // namespace detail
+
+}  // namespace uxs
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "btree_base.h"
+
+namespace uxs {
+
+namespace detail {
+
+//-----------------------------------------------------------------------------
+// B-tree with multiple keys implementation
+
+template<typename NodeTraits, typename Alloc, typename Comp>
+class btree_multi : public btree_base<NodeTraits, Alloc, Comp> {
+ protected:
+    using node_traits = NodeTraits;
+    using super = btree_base<node_traits, Alloc, Comp>;
+    using alloc_type = typename super::alloc_type;
+    using temp_value_t = typename super::temp_value_t;
+
+ public:
+    using allocator_type = typename super::allocator_type;
+    using value_type = typename super::value_type;
+    using key_compare = typename super::key_compare;
+    using iterator = typename super::iterator;
+    using const_iterator = typename super::const_iterator;
+    using node_type = typename super::node_type;
+
+    btree_multi() noexcept(noexcept(super())) : super() {}
+    explicit btree_multi(const allocator_type& alloc) noexcept(noexcept(super(alloc))) : super(alloc) {}
+    explicit btree_multi(const key_compare& comp, const allocator_type& alloc) : super(comp, alloc) {}
+    btree_multi(const btree_multi& other, const allocator_type& alloc) : super(other, alloc) {}
+    btree_multi(btree_multi&& other, const allocator_type& alloc) noexcept(noexcept(super(std::move(other), alloc)))
+        : super(std::move(other), alloc) {}
+
+#if __cplusplus < 201703L
+    ~btree_multi() = default;
+    btree_multi(const btree_multi&) = default;
+    btree_multi& operator=(const btree_multi&) = default;
+    btree_multi(btree_multi&& other) noexcept(noexcept(super(std::move(other)))) : super(std::move(other)) {}
+    btree_multi& operator=(btree_multi&& other) noexcept(std::is_nothrow_move_assignable<super>::value) {
+        super::operator=(std::move(other));
+        return *this;
+    }
+#endif  // __cplusplus < 201703L
+
+    void assign(std::initializer_list<value_type> l) { assign_range(l.begin(), l.end()); }
+    template<typename InputIt, typename = std::enable_if_t<is_input_iterator<InputIt>::value>>
+    void assign(InputIt first, InputIt last) {
+        assign_range(first, last);
+    }
+
+    iterator insert(const value_type& val) { return emplace(val); }
+    iterator insert(value_type&& val) { return emplace(std::move(val)); }
+    template<typename... Args>
+    iterator emplace(Args&&... args) {
+        temp_value_t tmp(this, std::forward<Args>(args)...);
+        return this->insert_at(this->find_insert_pos(tmp.key()), node_traits::get_rref_value(*tmp.get()));
+    }
+
+    iterator insert(const_iterator hint, const value_type& val) { return emplace_hint(hint, val); }
+    iterator insert(const_iterator hint, value_type&& val) { return emplace_hint(hint, std::move(val)); }
+    template<typename... Args>
+    iterator emplace_hint(const_iterator hint, Args&&... args) {
+        temp_value_t tmp(this, std::forward<Args>(args)...);
+        return this->insert_at(this->find_insert_pos(hint, tmp.key()), node_traits::get_rref_value(*tmp.get()));
+    }
+
+    iterator insert(node_type&& nh) {
+        if (nh.empty()) { return this->end(); }
+        auto& val = super::node_value(nh);
+        auto it = this->insert_at(this->find_insert_pos(node_traits::get_key(val)), node_traits::get_rref_value(val));
+        super::node_reset(nh);
+        return it;
+    }
+
+    iterator insert(const_iterator hint, node_type&& nh) {
+        if (nh.empty()) { return this->end(); }
+        auto& val = super::node_value(nh);
+        auto it = this->insert_at(this->find_insert_pos(hint, node_traits::get_key(val)),
+                                  node_traits::get_rref_value(val));
+        super::node_reset(nh);
+        return it;
+    }
+
+    template<typename Val, typename = std::enable_if_t<std::is_constructible<value_type, Val&&>::value>>
+    iterator insert(Val&& val) {
+        return emplace(std::forward<Val>(val));
+    }
+
+    template<typename Val, typename = std::enable_if_t<std::is_constructible<value_type, Val&&>::value>>
+    iterator insert(const_iterator hint, Val&& val) {
+        return emplace_hint(hint, std::forward<Val>(val));
+    }
+
+    void insert(std::initializer_list<value_type> l) { insert_impl(l.begin(), l.end()); }
+
+    template<typename InputIt, typename = std::enable_if_t<is_input_iterator<InputIt>::value>>
+    void insert(InputIt first, InputIt last) {
+        insert_impl(first, last);
+    }
+
+ protected:
+    template<typename InputIt>
+    void assign_range(InputIt first, InputIt last) {
+        assert(super::check_iterator_range(first, last, is_random_access_iterator<InputIt>()));
+        this->tidy();
+        insert_impl(first, last);
+    }
+
+    template<typename Comp2>
+    void merge_impl(btree_base<NodeTraits, Alloc, Comp2>&& other);
+
+    template<typename InputIt>
+    void insert_impl(InputIt first, InputIt last) {
+        assert(super::check_iterator_range(first, last, is_random_access_iterator<InputIt>()));
+        for (; first != last; ++first) { emplace_hint(this->end(), *first); }
+    }
+};
+
+// Values are moved between trees, so allocators need not be equal
+template<typename NodeTraits, typename Alloc, typename Comp>
+template<typename Comp2>
+void btree_multi<NodeTraits, Alloc, Comp>::merge_impl(btree_base<NodeTraits, Alloc, Comp2>&& other) {
+    if (!other.size_ || static_cast<void*>(std::addressof(other)) == static_cast<void*>(this)) { return; }
+    for (auto it = other.begin(); it != other.end();) {
+        auto& val = node_traits::get_value(it.node(), it.pos());
+        this->insert_at(this->find_insert_pos(node_traits::get_key(val)), node_traits::get_rref_value(val));
+        it = other.erase_impl(it.node(), it.pos());
+    }
+}
+
+}  // namespace detail
+
+}  // namespace uxs
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "btree_multi.h"
+#include "tree_front_end.h"
+
+#include <functional>
+
+namespace uxs {
+
+//-----------------------------------------------------------------------------
+// B-tree multimap front-end
+
+template<typename Key, typename Ty, typename Comp, typename Alloc>
+class btree_map;
+
+template<typename Key, typename Ty, typename Comp = std::less<Key>,
+         typename Alloc = std::allocator<std::pair<const Key, Ty>>>
+class btree_multimap
+    : public detail::tree_front_end<btree_multimap<Key, Ty, Comp, Alloc>,
+                                    detail::btree_multi<detail::btree_map_node_traits<Key, Ty>, Alloc, Comp>> {
+ private:
+    using node_traits = detail::btree_map_node_traits<Key, Ty>;
+    using super = detail::tree_front_end<btree_multimap, detail::btree_multi<node_traits, Alloc, Comp>>;
+
+ public:
+    using mapped_type = Ty;
+
+    using super::super;
+    using super::operator=;
+
+    // constructors from initializer list are redeclared to take part in class template argument deduction
+    btree_multimap(std::initializer_list<std::pair<const Key, Ty>> l, const Alloc& alloc) : super(l, alloc) {}
+    btree_multimap(std::initializer_list<std::pair<const Key, Ty>> l, const Comp& comp = Comp(),
+                   const Alloc& alloc = Alloc())
+        : super(l, comp, alloc) {}
+
+    template<typename Comp2>
+    void merge(btree_map<Key, Ty, Comp2, Alloc>& other) {
+        this->merge_impl(std::move(other));
+    }
+    template<typename Comp2>
+    void merge(btree_map<Key, Ty, Comp2, Alloc>&& other) {
+        this->merge_impl(std::move(other));
+    }
+    template<typename Comp2>
+    void merge(btree_multimap<Key, Ty, Comp2, Alloc>& other) {
+        this->merge_impl(std::move(other));
+    }
+    template<typename Comp2>
+    void merge(btree_multimap<Key, Ty, Comp2, Alloc>&& other) {
+        this->merge_impl(std::move(other));
+    }
+};
+
+#if __cplusplus >= 201703L
+template<typename InputIt, typename Comp = std::less<detail::iter_key_t<InputIt>>,
+         typename Alloc = std::allocator<detail::iter_to_alloc_t<InputIt>>,
+         typename = std::enable_if_t<!is_allocator<Comp>::value>, typename = std::enable_if_t<is_allocator<Alloc>::value>>
+btree_multimap(InputIt, InputIt, Comp = Comp(),
+         Alloc = Alloc()) -> btree_multimap<detail::iter_key_t<InputIt>, detail::iter_val_t<InputIt>, Comp, Alloc>;
+template<typename Key, typename Ty, typename Comp = std::less<est::remove_const_t<Key>>,
+         typename Alloc = std::allocator<std::pair<const Key, Ty>>,
+         typename = std::enable_if_t<!is_allocator<Comp>::value>, typename = std::enable_if_t<is_allocator<Alloc>::value>>
+btree_multimap(std::initializer_list<std::pair<Key, Ty>>, Comp = Comp(),
+         Alloc = Alloc()) -> btree_multimap<est::remove_const_t<Key>, Ty, Comp, Alloc>;
+template<typename InputIt, typename Alloc, typename = std::enable_if_t<is_allocator<Alloc>::value>>
+btree_multimap(InputIt, InputIt, Alloc)
+    -> btree_multimap<detail::iter_key_t<InputIt>, detail::iter_val_t<InputIt>,
+                      std::less<detail::iter_key_t<InputIt>>, Alloc>;
+template<typename Key, typename Ty, typename Alloc, typename = std::enable_if_t<is_allocator<Alloc>::value>>
+btree_multimap(std::initializer_list<std::pair<Key, Ty>>,
+         Alloc) -> btree_multimap<est::remove_const_t<Key>, Ty, std::less<est::remove_const_t<Key>>, Alloc>;
+#endif  // __cplusplus >= 201703L
+
+}  // namespace uxs
+
+namespace std {
+template<typename Key, typename Ty, typename Comp, typename Alloc>
+void swap(uxs::btree_multimap<Key, Ty, Comp, Alloc>& m1,
+          uxs::btree_multimap<Key, Ty, Comp, Alloc>& m2) noexcept(noexcept(m1.swap(m2))) {
+    m1.swap(m2);
+}
+}  // namespace std
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "btree_unique.h"
+#include "tree_front_end.h"
+
+#include <functional>
+
+namespace uxs {
+
+//-----------------------------------------------------------------------------
+// B-tree set front-end
+
+template<typename Key, typename Comp, typename Alloc>
+class btree_multiset;
+
+template<typename Key, typename Comp = std::less<Key>, typename Alloc = std::allocator<Key>>
+class btree_set : public detail::tree_front_end<btree_set<Key, Comp, Alloc>,
+                                                detail::btree_unique<detail::btree_set_node_traits<Key>, Alloc, Comp>> {
+ private:
+    using node_traits = detail::btree_set_node_traits<Key>;
+    using super = detail::tree_front_end<btree_set, detail::btree_unique<node_traits, Alloc, Comp>>;
+
+ public:
+    using super::super;
+    using super::operator=;
+
+    // constructors from initializer list are redeclared to take part in class template argument deduction
+    btree_set(std::initializer_list<Key> l, const Alloc& alloc) : super(l, alloc) {}
+    btree_set(std::initializer_list<Key> l, const Comp& comp = Comp(), const Alloc& alloc = Alloc())
+        : super(l, comp, alloc) {}
+
+    template<typename Comp2>
+    void merge(btree_set<Key, Comp2, Alloc>& other) {
+        this->merge_impl(std::move(other));
+    }
+    template<typename Comp2>
+    void merge(btree_set<Key, Comp2, Alloc>&& other) {
+        this->merge_impl(std::move(other));
+    }
+    template<typename Comp2>
+    void merge(btree_multiset<Key, Comp2, Alloc>& other) {
+        this->merge_impl(std::move(other));
+    }
+    template<typename Comp2>
+    void merge(btree_multiset<Key, Comp2, Alloc>&& other) {
+        this->merge_impl(std::move(other));
+    }
+};
+
+#if __cplusplus >= 201703L
+template<typename InputIt, typename Comp = std::less<typename std::iterator_traits<InputIt>::value_type>,
+         typename Alloc = std::allocator<typename std::iterator_traits<InputIt>::value_type>,
+         typename = std::enable_if_t<!is_allocator<Comp>::value>, typename = std::enable_if_t<is_allocator<Alloc>::value>>
+btree_set(InputIt, InputIt, Comp = Comp(),
+    Alloc = Alloc()) -> btree_set<typename std::iterator_traits<InputIt>::value_type, Comp, Alloc>;
+template<typename Key, typename Comp = std::less<Key>, typename Alloc = std::allocator<Key>,
+         typename = std::enable_if_t<!is_allocator<Comp>::value>, typename = std::enable_if_t<is_allocator<Alloc>::value>>
+btree_set(std::initializer_list<Key>, Comp = Comp(), Alloc = Alloc()) -> btree_set<Key, Comp, Alloc>;
+template<typename InputIt, typename Alloc, typename = std::enable_if_t<is_allocator<Alloc>::value>>
+btree_set(InputIt, InputIt, Alloc) -> btree_set<typename std::iterator_traits<InputIt>::value_type,
+                                                std::less<typename std::iterator_traits<InputIt>::value_type>, Alloc>;
+template<typename Key, typename Alloc, typename = std::enable_if_t<is_allocator<Alloc>::value>>
+btree_set(std::initializer_list<Key>, Alloc) -> btree_set<Key, std::less<Key>, Alloc>;
+#endif  // __cplusplus >= 201703L
+
+}  // namespace uxs
+
+namespace std {
+template<typename Key, typename Comp, typename Alloc>
+void swap(uxs::btree_set<Key, Comp, Alloc>& s1,
+          uxs::btree_set<Key, Comp, Alloc>& s2) noexcept(noexcept(s1.swap(s2))) {
+    s1.swap(s2);
+}
+}  // namespace std
@@ -0,0 +1,196 @@
+#pragma once
+
+#include "btree_base.h"
+
+namespace uxs {
+
+namespace detail {
+
+//-----------------------------------------------------------------------------
+// B-tree with unique keys implementation
+
+template<typename NodeTraits, typename Alloc, typename Comp>
+class btree_unique : public btree_base<NodeTraits, Alloc, Comp> {
+ protected:
+    using node_traits = NodeTraits;
+    using super = btree_base<node_traits, Alloc, Comp>;
+    using alloc_type = typename super::alloc_type;
+    using temp_value_t = typename super::temp_value_t;
+
+ public:
+    using allocator_type = typename super::allocator_type;
+    using value_type = typename super::value_type;
+    using key_compare = typename super::key_compare;
+    using iterator = typename super::iterator;
+    using const_iterator = typename super::const_iterator;
+    using node_type = typename super::node_type;
+
+    struct insert_return_type {
+#if __cplusplus < 201703L
+        insert_return_type() = default;
+        ~insert_return_type() = default;
+        insert_return_type(iterator in_position, bool in_inserted, node_type in_node)
+            : position(in_position), inserted(in_inserted), node(std::move(in_node)) {}
+        insert_return_type(const insert_return_type&) = delete;
+        insert_return_type& operator=(const insert_return_type&) = delete;
+        insert_return_type(insert_return_type&& rt)
+            : position(rt.position), inserted(rt.inserted), node(std::move(rt.node)) {}
+        insert_return_type& operator=(insert_return_type&& rt) {
+            position = rt.position, inserted = rt.inserted, node = std::move(rt.node);
+            return *this;
+        }
+#endif  // __cplusplus < 201703L
+        iterator position;
+        bool inserted;
+        node_type node;
+    };
+
+    btree_unique() noexcept(noexcept(super())) : super() {}
+    explicit btree_unique(const allocator_type& alloc) noexcept(noexcept(super(alloc))) : super(alloc) {}
+    explicit btree_unique(const key_compare& comp, const allocator_type& alloc) : super(comp, alloc) {}
+    btree_unique(const btree_unique& other, const allocator_type& alloc) : super(other, alloc) {}
+    btree_unique(btree_unique&& other, const allocator_type& alloc) noexcept(noexcept(super(std::move(other), alloc)))
+        : super(std::move(other), alloc) {}
+
+#if __cplusplus < 201703L
+    ~btree_unique() = default;
+    btree_unique(const btree_unique&) = default;
+    btree_unique& operator=(const btree_unique&) = default;
+    btree_unique(btree_unique&& other) noexcept(noexcept(super(std::move(other)))) : super(std::move(other)) {}
+    btree_unique& operator=(btree_unique&& other) noexcept(std::is_nothrow_move_assignable<super>::value) {
+        super::operator=(std::move(other));
+        return *this;
+    }
+#endif  // __cplusplus < 201703L
+
+    void assign(std::initializer_list<value_type> l) { assign_range(l.begin(), l.end()); }
+    template<typename InputIt, typename = std::enable_if_t<is_input_iterator<InputIt>::value>>
+    void assign(InputIt first, InputIt last) {
+        assign_range(first, last);
+    }
+
+    std::pair<iterator, bool> insert(const value_type& val) { return emplace(val); }
+    std::pair<iterator, bool> insert(value_type&& val) { return emplace(std::move(val)); }
+    template<typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        temp_value_t tmp(this, std::forward<Args>(args)...);
+        auto result = this->find_insert_unique_pos(tmp.key());
+        if (result.second) {
+            return std::make_pair(this->insert_at(result.first, node_traits::get_rref_value(*tmp.get())), true);
+        }
+        return std::make_pair(super::to_iterator(result.first), false);
+    }
+
+    iterator insert(const_iterator hint, const value_type& val) { return emplace_hint(hint, val); }
+    iterator insert(const_iterator hint, value_type&& val) { return emplace_hint(hint, std::move(val)); }
+    template<typename... Args>
+    iterator emplace_hint(const_iterator hint, Args&&... args) {
+        temp_value_t tmp(this, std::forward<Args>(args)...);
+        auto result = this->find_insert_unique_pos(hint, tmp.key());
+        if (result.second) { return this->insert_at(result.first, node_traits::get_rref_value(*tmp.get())); }
+        return super::to_iterator(result.first);
+    }
+
+    insert_return_type insert(node_type&& nh) {
+        if (nh.empty()) { return {this->end(), false, node_type(*this)}; }
+        auto& val = super::node_value(nh);
+        auto result = this->find_insert_unique_pos(node_traits::get_key(val));
+        if (result.second) {
+            auto it = this->insert_at(result.first, node_traits::get_rref_value(val));
+            super::node_reset(nh);
+            return {it, true, node_type(*this)};
+        }
+        return {super::to_iterator(result.first), false, std::move(nh)};
+    }
+
+    iterator insert(const_iterator hint, node_type&& nh) {
+        if (nh.empty()) { return this->end(); }
+        auto& val = super::node_value(nh);
+        auto result = this->find_insert_unique_pos(hint, node_traits::get_key(val));
+        if (result.second) {
+            auto it = this->insert_at(result.first, node_traits::get_rref_value(val));
+            super::node_reset(nh);
+            return it;
+        }
+        return super::to_iterator(result.first);
+    }
+
+    template<typename Val, typename = std::enable_if_t<std::is_constructible<value_type, Val&&>::value>>
+    std::pair<iterator, bool> insert(Val&& val) {
+        return emplace(std::forward<Val>(val));
+    }
+
+    template<typename Val, typename = std::enable_if_t<std::is_constructible<value_type, Val&&>::value>>
+    iterator insert(const_iterator hint, Val&& val) {
+        return emplace_hint(hint, std::forward<Val>(val));
+    }
+
+    void insert(std::initializer_list<value_type> l) { insert_impl(l.begin(), l.end()); }
+
+    template<typename InputIt, typename = std::enable_if_t<is_input_iterator<InputIt>::value>>
+    void insert(InputIt first, InputIt last) {
+        insert_impl(first, last);
+    }
+
+ protected:
+    template<typename InputIt>
+    void assign_range(InputIt first, InputIt last) {
+        assert(super::check_iterator_range(first, last, is_random_access_iterator<InputIt>()));
+        this->tidy();
+        insert_impl(first, last);
+    }
+
+    template<typename Comp2>
+    void merge_impl(btree_base<NodeTraits, Alloc, Comp2>&& other);
+
+    template<typename InputIt>
+    void insert_impl(InputIt first, InputIt last) {
+        assert(super::check_iterator_range(first, last, is_random_access_iterator<InputIt>()));
+        for (; first != last; ++first) { emplace_hint(this->end(), *first); }
+    }
+
+    template<typename Key2, typename... Args>
+    std::pair<iterator, bool> try_emplace_impl(Key2&& key, Args&&... args) {
+        auto result = this->find_insert_unique_pos(key);
+        if (result.second) {
+            return std::make_pair(this->insert_at(result.first, std::piecewise_construct,
+                                                  std::forward_as_tuple(std::forward<Key2>(key)),
+                                                  std::forward_as_tuple(std::forward<Args>(args)...)),
+                                  true);
+        }
+        return std::make_pair(super::to_iterator(result.first), false);
+    }
+
+    template<typename Key2, typename... Args>
+    std::pair<iterator, bool> try_emplace_hint_impl(const_iterator hint, Key2&& key, Args&&... args) {
+        auto result = this->find_insert_unique_pos(hint, key);
+        if (result.second) {
+            return std::make_pair(this->insert_at(result.first, std::piecewise_construct,
+                                                  std::forward_as_tuple(std::forward<Key2>(key)),
+                                                  std::forward_as_tuple(std::forward<Args>(args)...)),
+                                  true);
+        }
+        return std::make_pair(super::to_iterator(result.first), false);
+    }
+};
+
+// Values are moved between trees, so allocators need not be equal
+template<typename NodeTraits, typename Alloc, typename Comp>
+template<typename Comp2>
+void btree_unique<NodeTraits, Alloc, Comp>::merge_impl(btree_base<NodeTraits, Alloc, Comp2>&& other) {
+    if (!other.size_ || static_cast<void*>(std::addressof(other)) == static_cast<void*>(this)) { return; }
+    for (auto it = other.begin(); it != other.end();) {
+        auto& val = node_traits::get_value(it.node(), it.pos());
+        auto result = this->find_insert_unique_pos(node_traits::get_key(val));
+        if (result.second) {
+            this->insert_at(result.first, node_traits::get_rref_value(val));
+            it = other.erase_impl(it.node(), it.pos());
+        } else {
+            ++it;
+        }
+    }
+}
+
+}  // namespace detail
+
+}  // namespace uxs
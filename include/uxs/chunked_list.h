@@ -0,0 +1,997 @@
+#pragma once
+
+#include "dllist.h"
+#include "iterator.h"
+#include "memory.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace uxs {
+
+//-----------------------------------------------------------------------------
+// Chunked list implementation
+
+namespace detail {
+
+// Values of a chunk occupy slots [first, last), so a chunk can grow in both directions without moving values
+struct chunked_list_links_t {
+    chunked_list_links_t* next;
+    chunked_list_links_t* prev;
+    unsigned first;
+    unsigned last;
+#if UXS_ITERATOR_DEBUG_LEVEL != 0
+    chunked_list_links_t* head;
+#endif  // UXS_ITERATOR_DEBUG_LEVEL != 0
+};
+
+template<typename Ty, unsigned N>
+struct chunked_list_node_type : chunked_list_links_t {
+    alignas(Ty) std::uint8_t storage[N * sizeof(Ty)];
+};
+
+template<typename Ty>
+struct chunked_list_node_traits {
+    // Chunk capacity is chosen to keep chunks about 1 KiB, but within 8 to 64 values
+    enum : unsigned {
+        capacity = 1024 / sizeof(Ty) < 8 ? 8 : (1024 / sizeof(Ty) > 64 ? 64 : 1024 / sizeof(Ty)),
+    };
+    using links_t = chunked_list_links_t;
+    using node_t = chunked_list_node_type<Ty, capacity>;
+    static Ty* get_slots(links_t* node) { return reinterpret_cast<Ty*>(static_cast<node_t*>(node)->storage); }
+    static Ty& get_value(links_t* node, unsigned pos) { return get_slots(node)[pos]; }
+#if UXS_ITERATOR_DEBUG_LEVEL != 0
+    static void set_head(links_t* node, links_t* head) { node->head = head; }
+    static void set_head(links_t* first, links_t* last, links_t* head) {
+        for (auto* p = first; p != last; p = p->next) { set_head(p, head); }
+    }
+    static links_t* get_head(links_t* node) { return node->head; }
+#else   // UXS_ITERATOR_DEBUG_LEVEL != 0
+    static void set_head(links_t* node, links_t* head) {}
+    static void set_head(links_t* first, links_t* last, links_t* head) {}
+#endif  // UXS_ITERATOR_DEBUG_LEVEL != 0
+};
+
+//-----------------------------------------------------------------------------
+// Chunked list iterator
+
+template<typename Traits, typename NodeTraits, bool Const>
+class chunked_list_iterator
+    : public container_iterator_facade<Traits, chunked_list_iterator<Traits, NodeTraits, Const>,
+                                       std::bidirectional_iterator_tag, Const> {
+ private:
+    using super = container_iterator_facade<Traits, chunked_list_iterator, std::bidirectional_iterator_tag, Const>;
+    using links_t = chunked_list_links_t;
+
+ public:
+    using reference = typename super::reference;
+
+    template<typename, typename, bool>
+    friend class chunked_list_iterator;
+
+    chunked_list_iterator() noexcept = default;
+    chunked_list_iterator(links_t* node, unsigned pos) noexcept : node_(node), pos_(pos) {}
+
+    // This iterator consists of a pointer and an index,
+    // so explicit copy constructor and operator are not needed
+
+    template<bool Const_ = Const>
+    chunked_list_iterator(const std::enable_if_t<Const_, chunked_list_iterator<Traits, NodeTraits, false>>& it) noexcept
+        : node_(it.node_), pos_(it.pos_) {}
+    template<bool Const_ = Const>
+    chunked_list_iterator& operator=(
+        const std::enable_if_t<Const_, chunked_list_iterator<Traits, NodeTraits, false>>& it) noexcept {
+        node_ = it.node_, pos_ = it.pos_;
+        return *this;
+    }
+
+    void increment() noexcept {
+        uxs_iterator_assert(node_ && node_ != NodeTraits::get_head(node_) && pos_ < node_->last);
+        if (++pos_ == node_->last) { node_ = node_->next, pos_ = node_->first; }
+    }
+
+    void decrement() noexcept {
+        uxs_iterator_assert(node_);
+        if (pos_ == node_->first) {
+            node_ = node_->prev, pos_ = node_->last;
+            uxs_iterator_assert(node_ != NodeTraits::get_head(node_));
+        }
+        --pos_;
+    }
+
+    template<bool Const2>
+    bool is_equal_to(const chunked_list_iterator<Traits, NodeTraits, Const2>& it) const noexcept {
+        uxs_iterator_assert((!node_ && !it.node_) ||
+                            (node_ && it.node_ && NodeTraits::get_head(node_) == NodeTraits::get_head(it.node_)));
+        return node_ == it.node_ && pos_ == it.pos_;
+    }
+
+    reference dereference() const noexcept {
+        uxs_iterator_assert(node_ && node_ != NodeTraits::get_head(node_) && pos_ < node_->last);
+        return NodeTraits::get_value(node_, pos_);
+    }
+
+    links_t* node() const noexcept { return node_; }
+    unsigned pos() const noexcept { return pos_; }
+
+ private:
+    links_t* node_ = nullptr;
+    unsigned pos_ = 0;
+};
+
+}  // namespace detail
+
+// Unrolled linked list: values are stored in linked chunks of several values.
+// Adding and removing values at list ends doesn't invalidate iterators and references to other values.
+// Other insertions and removals can move values inside of the affected chunk and its neighbours,
+// so only iterators to values of these chunks are invalidated
+template<typename Ty, typename Alloc = std::allocator<Ty>>
+class chunked_list : protected std::allocator_traits<Alloc>::template rebind_alloc<  //
+                         typename detail::chunked_list_node_traits<Ty>::node_t> {
+ private:
+    using links_t = detail::chunked_list_links_t;
+    using node_traits = detail::chunked_list_node_traits<Ty>;
+    using alloc_type = typename std::allocator_traits<Alloc>::template rebind_alloc<typename node_traits::node_t>;
+    using alloc_traits = std::allocator_traits<alloc_type>;
+    using value_alloc_type = typename std::allocator_traits<Alloc>::template rebind_alloc<Ty>;
+    using value_alloc_traits = std::allocator_traits<value_alloc_type>;
+    using is_relocatable_by_memcpy = is_trivially_relocatable<Ty>;
+    using is_nothrow_relocatable =
+        std::bool_constant<(is_trivially_relocatable<Ty>::value || std::is_nothrow_move_constructible<Ty>::value)>;
+
+    enum : unsigned { chunk_capacity = node_traits::capacity };
+
+ public:
+    using value_type = Ty;
+    using allocator_type = Alloc;
+    using size_type = typename value_alloc_traits::size_type;
+    using difference_type = typename value_alloc_traits::difference_type;
+    using pointer = typename value_alloc_traits::pointer;
+    using const_pointer = typename value_alloc_traits::const_pointer;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using iterator = detail::chunked_list_iterator<chunked_list, node_traits, false>;
+    using const_iterator = detail::chunked_list_iterator<chunked_list, node_traits, true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    chunked_list() noexcept(std::is_nothrow_default_constructible<alloc_type>::value)
+        : alloc_type(allocator_type()) {
+        init();
+    }
+    explicit chunked_list(const allocator_type& alloc) noexcept : alloc_type(alloc) { init(); }
+    explicit chunked_list(size_type sz, const allocator_type& alloc = allocator_type()) : alloc_type(alloc) {
+        try {
+            init();
+            for (; sz; --sz) { emplace_back(); }
+        } catch (...) {
+            tidy();
+            throw;
+        }
+    }
+
+    chunked_list(size_type sz, const value_type& val, const allocator_type& alloc = allocator_type())
+        : alloc_type(alloc) {
+        try {
+            init();
+            for (; sz; --sz) { emplace_back(val); }
+        } catch (...) {
+            tidy();
+            throw;
+        }
+    }
+
+    chunked_list(std::initializer_list<value_type> l, const allocator_type& alloc = allocator_type())
+        : alloc_type(alloc) {
+        try {
+            init();
+            append_range(l.begin(), l.end());
+        } catch (...) {
+            tidy();
+            throw;
+        }
+    }
+
+    chunked_list& operator=(std::initializer_list<value_type> l) {
+        assign_range(l.begin(), l.end());
+        return *this;
+    }
+
+    template<typename InputIt, typename = std::enable_if_t<is_input_iterator<InputIt>::value>>
+    chunked_list(InputIt first, InputIt last, const allocator_type& alloc = allocator_type()) : alloc_type(alloc) {
+        try {
+            init();
+            append_range(first, last);
+        } catch (...) {
+            tidy();
+            throw;
+        }
+    }
+
+    chunked_list(const chunked_list& other) : alloc_type(alloc_traits::select_on_container_copy_construction(other)) {
+        try {
+            init();
+            append_range(other.begin(), other.end());
+        } catch (...) {
+            tidy();
+            throw;
+        }
+    }
+
+    chunked_list(const chunked_list& other, const allocator_type& alloc) : alloc_type(alloc) {
+        try {
+            init();
+            append_range(other.begin(), other.end());
+        } catch (...) {
+            tidy();
+            throw;
+        }
+    }
+
+    chunked_list& operator=(const chunked_list& other) {
+        if (std::addressof(other) == this) { return *this; }
+        assign_impl(other, std::bool_constant<(!alloc_traits::propagate_on_container_copy_assignment::value ||
+                                               is_alloc_always_equal<alloc_type>::value)>());
+        return *this;
+    }
+
+    chunked_list(chunked_list&& other) noexcept : alloc_type(std::move(other)) {
+        init();
+        steal_data(other);
+    }
+
+    chunked_list(chunked_list&& other, const allocator_type& alloc) noexcept(is_alloc_always_equal<alloc_type>::value)
+        : alloc_type(alloc) {
+        construct_impl(std::move(other), alloc, is_alloc_always_equal<alloc_type>());
+    }
+
+    chunked_list& operator=(chunked_list&& other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value || is_alloc_always_equal<alloc_type>::value) {
+        if (std::addressof(other) == this) { return *this; }
+        assign_impl(std::move(other), std::bool_constant<(alloc_traits::propagate_on_container_move_assignment::value ||
+                                                          is_alloc_always_equal<alloc_type>::value)>());
+        return *this;
+    }
+
+    ~chunked_list() { tidy(); }
+
+    void swap(chunked_list& other) noexcept {
+        if (std::addressof(other) == this) { return; }
+        swap_impl(other, typename alloc_traits::propagate_on_container_swap());
+    }
+
+    allocator_type get_allocator() const noexcept { return allocator_type(*this); }
+
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+    size_type max_size() const noexcept { return alloc_traits::max_size(*this) * chunk_capacity; }
+
+    iterator begin() noexcept { return iterator(head_.next, head_.next->first); }
+    const_iterator begin() const noexcept { return const_iterator(head_.next, head_.next->first); }
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator end() noexcept { return iterator(std::addressof(head_), 0); }
+    const_iterator end() const noexcept { return const_iterator(std::addressof(head_), 0); }
+    const_iterator cend() const noexcept { return end(); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    reference front() {
+        assert(size_);
+        return node_traits::get_value(head_.next, head_.next->first);
+    }
+    const_reference front() const {
+        assert(size_);
+        return node_traits::get_value(head_.next, head_.next->first);
+    }
+
+    reference back() {
+        assert(size_);
+        return node_traits::get_value(head_.prev, head_.prev->last - 1);
+    }
+    const_reference back() const {
+        assert(size_);
+        return node_traits::get_value(head_.prev, head_.prev->last - 1);
+    }
+
+    void assign(size_type sz, const value_type& val) { assign_fill(sz, val); }
+
+    void assign(std::initializer_list<value_type> l) { assign_range(l.begin(), l.end()); }
+
+    template<typename InputIt, typename = std::enable_if_t<is_input_iterator<InputIt>::value>>
+    void assign(InputIt first, InputIt last) {
+        assign_range(first, last);
+    }
+
+    void clear() noexcept { tidy(); }
+
+    void resize(size_type sz) {
+        if (sz < size_) { return truncate(sz); }
+        for (sz -= size_; sz; --sz) { emplace_back(); }
+    }
+
+    void resize(size_type sz, const value_type& val) {
+        if (sz < size_) { return truncate(sz); }
+        for (sz -= size_; sz; --sz) { emplace_back(val); }
+    }
+
+    iterator insert(const_iterator pos, size_type count, const value_type& val) {
+        auto* node = to_ptr(pos);
+        if (!count) { return iterator(node, pos.pos()); }
+        alignas(std::alignment_of<value_type>::value) std::uint8_t buf[sizeof(value_type)];
+        value_type* val_copy = reinterpret_cast<value_type*>(&buf);
+        alloc_traits::construct(*this, val_copy, val);
+        try {
+            auto it = insert_copy(node, pos.pos(), count, const_value(*val_copy));
+            alloc_traits::destroy(*this, val_copy);
+            return it;
+        } catch (...) {
+            alloc_traits::destroy(*this, val_copy);
+            throw;
+        }
+    }
+
+    iterator insert(const_iterator pos, std::initializer_list<value_type> l) {
+        return insert_copy(to_ptr(pos), pos.pos(), l.size(), l.begin());
+    }
+
+    template<typename InputIt, typename = std::enable_if_t<is_input_iterator<InputIt>::value>>
+    iterator insert(const_iterator pos, InputIt first, InputIt last) {
+        return insert_range(pos, first, last, is_forward_iterator<InputIt>());
+    }
+
+    iterator insert(const_iterator pos, const value_type& val) { return emplace(pos, val); }
+    iterator insert(const_iterator pos, value_type&& val) { return emplace(pos, std::move(val)); }
+    template<typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args);
+
+    void push_front(const value_type& val) { emplace_front(val); }
+    void push_front(value_type&& val) { emplace_front(std::move(val)); }
+    template<typename... Args>
+    reference emplace_front(Args&&... args) {
+        auto* node = head_.next;
+        if (node->first == 0) { node = new_chunk(node, chunk_capacity); }
+        construct_in_chunk(node, node->first - 1, std::forward<Args>(args)...);
+        ++size_;
+        return node_traits::get_value(node, --node->first);
+    }
+
+    void pop_front() {
+        assert(size_);
+        auto* node = head_.next;
+        destroy_values(node, node->first, node->first + 1);
+        if (++node->first == node->last) { delete_chunk(node); }
+        --size_;
+    }
+
+    void push_back(const value_type& val) { emplace_back(val); }
+    void push_back(value_type&& val) { emplace_back(std::move(val)); }
+    template<typename... Args>
+    reference emplace_back(Args&&... args) {
+        auto* node = head_.prev;
+        if (node->last == chunk_capacity) { node = new_chunk(std::addressof(head_), 0); }
+        construct_in_chunk(node, node->last, std::forward<Args>(args)...);
+        ++size_;
+        return node_traits::get_value(node, node->last++);
+    }
+
+    void pop_back() {
+        assert(size_);
+        auto* node = head_.prev;
+        destroy_values(node, node->last - 1, node->last);
+        if (node->first == --node->last) { delete_chunk(node); }
+        --size_;
+    }
+
+    iterator erase(const_iterator pos) {
+        auto* node = to_ptr(pos);
+        assert(node != std::addressof(head_));
+        return erase_impl(node, pos.pos(), pos.pos() + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last);
+
+    // Values can be spliced from another list only; the whole list is spliced in O(1)
+    void splice(const_iterator pos, chunked_list& other) { splice_impl(pos, std::move(other)); }
+    void splice(const_iterator pos, chunked_list&& other) { splice_impl(pos, std::move(other)); }
+    void splice(const_iterator pos, chunked_list& other, const_iterator first, const_iterator last) {
+        splice_impl(pos, std::move(other), first, last);
+    }
+    void splice(const_iterator pos, chunked_list&& other, const_iterator first, const_iterator last) {
+        splice_impl(pos, std::move(other), first, last);
+    }
+
+ private:
+    // The head is treated as a full chunk, so new chunks are created before or after it
+    mutable links_t head_;
+    size_type size_ = 0;
+
+    bool is_same_alloc(const alloc_type& alloc) { return static_cast<alloc_type&>(*this) == alloc; }
+
+    static unsigned chunk_size(const links_t* node) { return node->last - node->first; }
+
+    links_t* to_ptr(const_iterator it) const {
+        auto* node = it.node();
+        uxs_iterator_assert(node_traits::get_head(node) == std::addressof(head_));
+        return node;
+    }
+
+    links_t* new_chunk(links_t* pos, unsigned start) {
+        auto* node = static_cast<links_t*>(std::addressof(*alloc_traits::allocate(*this, 1)));
+        node->first = node->last = start;
+        node_traits::set_head(node, std::addressof(head_));
+        dllist_insert_before(pos, node);
+        return node;
+    }
+
+    void delete_chunk(links_t* node) {
+        dllist_remove(node);
+        alloc_traits::deallocate(*this, static_cast<typename node_traits::node_t*>(node), 1);
+    }
+
+    template<typename... Args>
+    void construct_in_chunk(links_t* node, unsigned pos, Args&&... args) {
+        try {
+            alloc_traits::construct(*this, std::addressof(node_traits::get_value(node, pos)),
+                                    std::forward<Args>(args)...);
+        } catch (...) {
+            if (node->first == node->last) { delete_chunk(node); }
+            throw;
+        }
+    }
+
+    template<typename InputIt>
+    void construct_values(links_t* node, unsigned pos, unsigned n, InputIt& src) {
+        Ty* first = std::addressof(node_traits::get_value(node, pos));
+        Ty* p = first;
+        try {
+            for (Ty* last = first + n; p != last; ++p) {
+                alloc_traits::construct(*this, p, *src);
+                ++src;
+            }
+        } catch (...) {
+            for (; first != p; ++first) { alloc_traits::destroy(*this, first); }
+            throw;
+        }
+    }
+
+    void destroy_values(links_t* node, unsigned first, unsigned last) {
+        Ty* slots = node_traits::get_slots(node);
+        for (; first != last; ++first) { alloc_traits::destroy(*this, slots + first); }
+    }
+
+    void init() {
+        dllist_make_cycle(std::addressof(head_));
+        head_.first = 0, head_.last = chunk_capacity;
+        node_traits::set_head(std::addressof(head_), std::addressof(head_));
+    }
+
+    void reset() {
+        dllist_make_cycle(std::addressof(head_));
+        size_ = 0;
+    }
+
+    void tidy() {
+        auto* node = head_.next;
+        reset();
+        while (node != std::addressof(head_)) {
+            auto* next = node->next;
+            destroy_values(node, node->first, node->last);
+            alloc_traits::deallocate(*this, static_cast<typename node_traits::node_t*>(node), 1);
+            node = next;
+        }
+    }
+
+    void truncate(size_type sz) {
+        while (size_ > sz) {
+            auto* node = head_.prev;
+            const unsigned n = static_cast<unsigned>(std::min<size_type>(chunk_size(node), size_ - sz));
+            destroy_values(node, node->last - n, node->last);
+            node->last -= n, size_ -= n;
+            if (node->first == node->last) { delete_chunk(node); }
+        }
+    }
+
+    void steal_data(chunked_list& other) {
+        if (!other.size_) { return; }
+        head_.next = other.head_.next;
+        head_.next->prev = std::addressof(head_);
+        head_.prev = other.head_.prev;
+        head_.prev->next = std::addressof(head_);
+        size_ = other.size_;
+        other.reset();
+        node_traits::set_head(head_.next, std::addressof(head_), std::addressof(head_));
+    }
+
+    void construct_impl(chunked_list&& other, const allocator_type& /*alloc*/, std::true_type) noexcept {
+        init();
+        steal_data(other);
+    }
+
+    void construct_impl(chunked_list&& other, const allocator_type& /*alloc*/, std::false_type) {
+        init();
+        if (is_same_alloc(other)) {
+            steal_data(other);
+        } else {
+            try {
+                append_range(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+            } catch (...) {
+                tidy();
+                throw;
+            }
+        }
+    }
+
+    void assign_impl(const chunked_list& other, std::true_type) { assign_range(other.begin(), other.end()); }
+
+    void assign_impl(const chunked_list& other, std::false_type) {
+        if (is_same_alloc(other)) {
+            assign_range(other.begin(), other.end());
+        } else {
+            tidy();
+            alloc_type::operator=(other);
+            append_range(other.begin(), other.end());
+        }
+    }
+
+    void assign_impl(chunked_list&& other, std::true_type) noexcept {
+        tidy();
+        if (alloc_traits::propagate_on_container_move_assignment::value) { alloc_type::operator=(std::move(other)); }
+        steal_data(other);
+    }
+
+    void assign_impl(chunked_list&& other, std::false_type) {
+        if (is_same_alloc(other)) {
+            tidy();
+            steal_data(other);
+        } else {
+            assign_range(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+        }
+    }
+
+    void swap_impl(chunked_list& other, std::true_type) noexcept {
+        std::swap(static_cast<alloc_type&>(*this), static_cast<alloc_type&>(other));
+        swap_impl(other, std::false_type());
+    }
+
+    void swap_impl(chunked_list& other, std::false_type) noexcept {
+        if (!size_) { return steal_data(other); }
+        if (other.size_) {
+            std::swap(head_.next, other.head_.next);
+            std::swap(head_.prev, other.head_.prev);
+            std::swap(head_.next->prev, other.head_.next->prev);
+            std::swap(head_.prev->next, other.head_.prev->next);
+            std::swap(size_, other.size_);
+            node_traits::set_head(head_.next, std::addressof(head_), std::addressof(head_));
+        } else {
+            dllist_insert_after<links_t>(std::addressof(other.head_), head_.next, head_.prev);
+            other.size_ = size_;
+            reset();
+        }
+        node_traits::set_head(other.head_.next, std::addressof(other.head_), std::addressof(other.head_));
+    }
+
+    template<typename InputIt>
+    void append_range(InputIt first, InputIt last) {
+        for (; first != last; ++first) { emplace_back(*first); }
+    }
+
+    template<typename InputIt>
+    void assign_range(InputIt first, InputIt last) {
+        auto it = begin();
+        for (; it != end() && first != last; ++first, ++it) { *it = *first; }
+        if (it != end()) {
+            erase(it, end());
+        } else {
+            append_range(first, last);
+        }
+    }
+
+    void assign_fill(size_type sz, const value_type& val) {
+        auto it = begin();
+        for (; it != end() && sz; --sz, ++it) { *it = val; }
+        if (it != end()) {
+            erase(it, end());
+        } else {
+            for (; sz; --sz) { emplace_back(val); }
+        }
+    }
+
+    template<typename InputIt>
+    iterator insert_range(const_iterator pos, InputIt first, InputIt last, std::true_type /* forward iterator */) {
+        return insert_copy(to_ptr(pos), pos.pos(), static_cast<size_type>(std::distance(first, last)), first);
+    }
+
+    template<typename InputIt>
+    iterator insert_range(const_iterator pos, InputIt first, InputIt last, std::false_type /* forward iterator */) {
+        chunked_list tmp(get_allocator());
+        tmp.append_range(first, last);
+        if (tmp.empty()) { return iterator(to_ptr(pos), pos.pos()); }
+        iterator it = tmp.begin();
+        splice_impl(pos, std::move(tmp));
+        return it;
+    }
+
+    template<typename InputIt>
+    iterator insert_copy(links_t* node, unsigned pos, size_type count, InputIt src);
+
+    iterator erase_impl(links_t* node, unsigned first, unsigned last);
+
+    void splice_impl(const_iterator pos, chunked_list&& other);
+    void splice_impl(const_iterator pos, chunked_list&& other, const_iterator first, const_iterator last);
+
+    // Moves values to uninitialized slots of another chunk, source values are destroyed
+    void relocate(Ty* dst, Ty* first, Ty* last, std::true_type /* relocate by memcpy */) {
+        std::memcpy(static_cast<void*>(dst), static_cast<const void*>(first), (last - first) * sizeof(Ty));
+    }
+
+    void relocate(Ty* dst, Ty* first, Ty* last, std::false_type /* relocate by memcpy */) {
+        Ty* p = dst;
+        try {
+            for (Ty* src = first; src != last; ++src, ++p) { alloc_traits::construct(*this, p, std::move(*src)); }
+        } catch (...) {
+            for (; dst != p; ++dst) { alloc_traits::destroy(*this, dst); }
+            throw;
+        }
+        for (; first != last; ++first) { alloc_traits::destroy(*this, first); }
+    }
+
+    // Moves values to lower slots, ranges can overlap; used only if relocation doesn't throw
+    void relocate_down(Ty* dst, Ty* first, Ty* last, std::true_type /* relocate by memcpy */) noexcept {
+        std::memmove(static_cast<void*>(dst), static_cast<const void*>(first), (last - first) * sizeof(Ty));
+    }
+
+    void relocate_down(Ty* dst, Ty* first, Ty* last, std::false_type /* relocate by memcpy */) noexcept {
+        for (; first != last; ++first, ++dst) {
+            alloc_traits::construct(*this, dst, std::move(*first));
+            alloc_traits::destroy(*this, first);
+        }
+    }
+
+    // Moves values [pos, last) to a new chunk after the given one, returns the new chunk
+    links_t* split_chunk(links_t* node, unsigned pos) {
+        auto* next = new_chunk(node->next, 0);
+        Ty* slots = node_traits::get_slots(node);
+        try {
+            relocate(node_traits::get_slots(next), slots + pos, slots + node->last, is_relocatable_by_memcpy());
+        } catch (...) {
+            delete_chunk(next);
+            throw;
+        }
+        next->last = node->last - pos;
+        node->last = pos;
+        return next;
+    }
+
+    // Returns the chunk starting with the value at given position
+    links_t* split_before(links_t* node, unsigned pos) { return pos == node->first ? node : split_chunk(node, pos); }
+
+    unsigned insert_value(links_t* node, unsigned pos, Ty& val, std::true_type /* relocate by memcpy */);
+    unsigned insert_value(links_t* node, unsigned pos, Ty& val, std::false_type /* relocate by memcpy */);
+
+    iterator merge_chunks(links_t* node, unsigned pos);
+};
+
+template<typename Ty, typename Alloc>
+template<typename... Args>
+auto chunked_list<Ty, Alloc>::emplace(const_iterator pos, Args&&... args) -> iterator {
+    auto* node = to_ptr(pos);
+    unsigned p = pos.pos();
+    if (p == node->first) {
+        // try to put the value to a free slot at the boundary of chunks
+        if (p != 0) {
+            construct_in_chunk(node, p - 1, std::forward<Args>(args)...);
+            ++size_;
+            return iterator(node, --node->first);
+        }
+        auto* prev = node->prev;
+        if (prev->last != chunk_capacity) {
+            construct_in_chunk(prev, prev->last, std::forward<Args>(args)...);
+            ++size_;
+            return iterator(prev, prev->last++);
+        }
+        // a new chunk is filled downwards if inserting before the chunk, and upwards at the end of list
+        if (node == std::addressof(head_)) {
+            emplace_back(std::forward<Args>(args)...);
+            return iterator(head_.prev, head_.prev->last - 1);
+        }
+        node = new_chunk(node, chunk_capacity);
+        construct_in_chunk(node, chunk_capacity - 1, std::forward<Args>(args)...);
+        ++size_;
+        return iterator(node, --node->first);
+    }
+
+    // arguments can refer to a value of this list, so the new value is constructed before moving values
+    alignas(std::alignment_of<value_type>::value) std::uint8_t buf[sizeof(value_type)];
+    value_type* val = reinterpret_cast<value_type*>(&buf);
+    alloc_traits::construct(*this, val, std::forward<Args>(args)...);
+    try {
+        if (node->first == 0 && node->last == chunk_capacity) {
+            const unsigned mid = chunk_capacity / 2;
+            auto* next = split_chunk(node, mid);
+            if (p > mid) { node = next, p -= mid; }
+        }
+        p = insert_value(node, p, *val, is_relocatable_by_memcpy());
+    } catch (...) {
+        alloc_traits::destroy(*this, val);
+        throw;
+    }
+    if (!is_relocatable_by_memcpy::value) { alloc_traits::destroy(*this, val); }
+    return iterator(node, p);
+}
+
+// The value is moved to a chunk with a free slot by shifting values of the shorter side
+template<typename Ty, typename Alloc>
+unsigned chunked_list<Ty, Alloc>::insert_value(links_t* node, unsigned pos, Ty& val,
+                                               std::true_type /* relocate by memcpy */) {
+    Ty* slots = node_traits::get_slots(node);
+    ++size_;
+    if (node->last != chunk_capacity && (node->first == 0 || node->last - pos <= pos - node->first)) {
+        std::memmove(static_cast<void*>(slots + pos + 1), static_cast<const void*>(slots + pos),
+                     (node->last - pos) * sizeof(Ty));
+        ++node->last;
+        std::memcpy(static_cast<void*>(slots + pos), static_cast<const void*>(std::addressof(val)), sizeof(Ty));
+        return pos;
+    }
+    std::memmove(static_cast<void*>(slots + node->first - 1), static_cast<const void*>(slots + node->first),
+                 (pos - node->first) * sizeof(Ty));
+    --node->first;
+    std::memcpy(static_cast<void*>(slots + pos - 1), static_cast<const void*>(std::addressof(val)), sizeof(Ty));
+    return pos - 1;
+}
+
+template<typename Ty, typename Alloc>
+unsigned chunked_list<Ty, Alloc>::insert_value(links_t* node, unsigned pos, Ty& val,
+                                               std::false_type /* relocate by memcpy */) {
+    Ty* slots = node_traits::get_slots(node);
+    if (node->last != chunk_capacity && (node->first == 0 || node->last - pos <= pos - node->first)) {
+        if (pos == node->last) {
+            alloc_traits::construct(*this, slots + pos, std::move(val));
+            ++node->last, ++size_;
+            return pos;
+        }
+        alloc_traits::construct(*this, slots + node->last, std::move(slots[node->last - 1]));
+        ++node->last, ++size_;
+        std::move_backward(slots + pos, slots + node->last - 2, slots + node->last - 1);
+        slots[pos] = std::move(val);
+        return pos;
+    }
+    if (pos == node->first) {
+        alloc_traits::construct(*this, slots + pos - 1, std::move(val));
+        --node->first, ++size_;
+        return pos - 1;
+    }
+    alloc_traits::construct(*this, slots + node->first - 1, std::move(slots[node->first]));
+    --node->first, ++size_;
+    std::move(slots + node->first + 2, slots + pos, slots + node->first + 1);
+    slots[pos - 1] = std::move(val);
+    return pos - 1;
+}
+
+template<typename Ty, typename Alloc>
+template<typename InputIt>
+auto chunked_list<Ty, Alloc>::insert_copy(links_t* node, unsigned pos, size_type count, InputIt src) -> iterator {
+    if (!count) { return iterator(node, pos); }
+    Ty* slots = node_traits::get_slots(node);
+
+    // if the chunk has enough room at one of its ends, new values are constructed there and rotated into place
+    if (node != std::addressof(head_) && count <= chunk_capacity - node->last) {
+        const unsigned n = static_cast<unsigned>(count), old_last = node->last;
+        construct_values(node, old_last, n, src);
+        node->last += n, size_ += n;
+        std::rotate(slots + pos, slots + old_last, slots + node->last);
+        return iterator(node, pos);
+    }
+    if (node != std::addressof(head_) && count <= node->first) {
+        const unsigned n = static_cast<unsigned>(count), old_first = node->first;
+        construct_values(node, old_first - n, n, src);
+        node->first -= n, size_ += n;
+        std::rotate(slots + node->first, slots + old_first, slots + pos);
+        return iterator(node, pos - n);
+    }
+
+    // otherwise the chunk is split at given position, and new values are appended to its first part
+    // and to new chunks
+    links_t* next = node;
+    if (node != std::addressof(head_) && pos != node->first) {
+        next = split_chunk(node, pos);
+    } else {
+        node = node->prev;
+    }
+    links_t* first_node = nullptr;
+    unsigned first_pos = 0;
+    do {
+        if (node->last == chunk_capacity) { node = new_chunk(next, 0); }
+        const unsigned n = static_cast<unsigned>(std::min<size_type>(count, chunk_capacity - node->last));
+        try {
+            construct_values(node, node->last, n, src);
+        } catch (...) {
+            if (node->first == node->last) { delete_chunk(node); }
+            throw;
+        }
+        if (!first_node) { first_node = node, first_pos = node->last; }
+        node->last += n, size_ += n, count -= n;
+    } while (count);
+    return iterator(first_node, first_pos);
+}
+
+template<typename Ty, typename Alloc>
+auto chunked_list<Ty, Alloc>::erase(const_iterator first, const_iterator last) -> iterator {
+    auto* node = to_ptr(first);
+    auto* last_node = to_ptr(last);
+    unsigned pos = first.pos();
+    // whole chunks and chunk tails are removed without moving values
+    while (node != last_node) {
+        assert(node != std::addressof(head_));
+        auto* next = node->next;
+        destroy_values(node, pos, node->last);
+        size_ -= node->last - pos;
+        node->last = pos;
+        if (node->first == node->last) { delete_chunk(node); }
+        node = next, pos = node->first;
+    }
+    if (pos == last.pos()) { return iterator(node, pos); }
+    return erase_impl(node, pos, last.pos());
+}
+
+// Values of the shorter side are shifted to close the gap
+template<typename Ty, typename Alloc>
+auto chunked_list<Ty, Alloc>::erase_impl(links_t* node, unsigned first, unsigned last) -> iterator {
+    assert(first < last && node->first <= first && last <= node->last);
+    Ty* slots = node_traits::get_slots(node);
+    const unsigned n = last - first;
+    const bool shift_tail = node->last - last <= first - node->first;
+    if (is_relocatable_by_memcpy::value) {
+        destroy_values(node, first, last);
+        if (shift_tail) {
+            std::memmove(static_cast<void*>(slots + first), static_cast<const void*>(slots + last),
+                         (node->last - last) * sizeof(Ty));
+        } else {
+            std::memmove(static_cast<void*>(slots + node->first + n), static_cast<const void*>(slots + node->first),
+                         (first - node->first) * sizeof(Ty));
+        }
+    } else if (shift_tail) {
+        std::move(slots + last, slots + node->last, slots + first);
+        destroy_values(node, node->last - n, node->last);
+    } else {
+        std::move_backward(slots + node->first, slots + first, slots + last);
+        destroy_values(node, node->first, node->first + n);
+    }
+    if (shift_tail) {
+        node->last -= n;
+    } else {
+        node->first += n, first = last;
+    }
+    size_ -= n;
+    if (node->first == node->last) {
+        auto* next = node->next;
+        delete_chunk(node);
+        return iterator(next, next->first);
+    }
+    return merge_chunks(node, first);
+}
+
+// Merges the chunk with a neighbour if they are at most half full together,
+// returns the adjusted iterator to given position
+template<typename Ty, typename Alloc>
+auto chunked_list<Ty, Alloc>::merge_chunks(links_t* node, unsigned pos) -> iterator {
+    links_t* it_node = node;
+    if (pos == node->last) { it_node = node->next, pos = it_node->first; }
+    if (!is_nothrow_relocatable::value) { return iterator(it_node, pos); }
+
+    links_t* next = node;
+    if (node->prev != std::addressof(head_) && chunk_size(node->prev) + chunk_size(node) <= chunk_capacity / 2) {
+        node = node->prev;
+    } else if (node->next == std::addressof(head_) ||
+               chunk_size(node) + chunk_size(node->next) > chunk_capacity / 2) {
+        return iterator(it_node, pos);
+    } else {
+        next = node->next;
+    }
+
+    Ty* slots = node_traits::get_slots(node);
+    const unsigned n = chunk_size(next);
+    if (chunk_capacity - node->last < n) {
+        if (it_node == node) { pos -= node->first; }
+        relocate_down(slots, slots + node->first, slots + node->last, is_relocatable_by_memcpy());
+        node->last -= node->first, node->first = 0;
+    }
+    if (it_node == next) { it_node = node, pos += node->last - next->first; }
+    Ty* next_slots = node_traits::get_slots(next);
+    relocate_down(slots + node->last, next_slots + next->first, next_slots + next->last, is_relocatable_by_memcpy());
+    node->last += n;
+    delete_chunk(next);
+    return iterator(it_node, pos);
+}
+
+template<typename Ty, typename Alloc>
+void chunked_list<Ty, Alloc>::splice_impl(const_iterator pos, chunked_list&& other) {
+    assert(std::addressof(other) != this);
+    if (!other.size_ || std::addressof(other) == this) { return; }
+    if (!is_alloc_always_equal<alloc_type>::value && !is_same_alloc(other)) {
+        throw std::logic_error("allocators incompatible for splice");
+    }
+    auto* next = split_before(to_ptr(pos), pos.pos());
+    node_traits::set_head(other.head_.next, std::addressof(other.head_), std::addressof(head_));
+    dllist_insert_before(next, other.head_.next, other.head_.prev);
+    size_ += other.size_;
+    other.reset();
+}
+
+template<typename Ty, typename Alloc>
+void chunked_list<Ty, Alloc>::splice_impl(const_iterator pos, chunked_list&& other, const_iterator first,
+                                          const_iterator last) {
+    assert(std::addressof(other) != this);
+    auto* first_node = other.to_ptr(first);
+    auto* last_node = other.to_ptr(last);
+    unsigned last_pos = last.pos();
+    if (first_node == last_node && first.pos() == last_pos) { return; }
+    if (!is_alloc_always_equal<alloc_type>::value && !is_same_alloc(other)) {
+        throw std::logic_error("allocators incompatible for splice");
+    }
+    auto* next = split_before(to_ptr(pos), pos.pos());
+    // the range is made of whole chunks
+    auto* p_first = other.split_before(first_node, first.pos());
+    if (last_node == first_node && p_first != first_node) { last_node = p_first, last_pos -= first.pos(); }
+    auto* p_last = other.split_before(last_node, last_pos);
+    size_type count = 0;
+    for (auto* p = p_first; p != p_last; p = p->next) {
+        count += chunk_size(p);
+        node_traits::set_head(p, std::addressof(head_));
+    }
+    auto* pre_last = p_last->prev;
+    dllist_remove(p_first, p_last);
+    dllist_insert_before(next, p_first, pre_last);
+    size_ += count, other.size_ -= count;
+}
+
+#if __cplusplus >= 201703L
+template<typename InputIt, typename Alloc = std::allocator<typename std::iterator_traits<InputIt>::value_type>,
+         typename = std::enable_if_t<is_allocator<Alloc>::value>>
+chunked_list(InputIt, InputIt, Alloc = Alloc())
+    -> chunked_list<typename std::iterator_traits<InputIt>::value_type, Alloc>;
+#endif  // __cplusplus >= 201703L
+
+template<typename Ty, typename Alloc>
+bool operator==(const chunked_list<Ty, Alloc>& lhs, const chunked_list<Ty, Alloc>& rhs) {
+    if (lhs.size() != rhs.size()) { return false; }
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template<typename Ty, typename Alloc>
+bool operator<(const chunked_list<Ty, Alloc>& lhs, const chunked_list<Ty, Alloc>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template<typename Ty, typename Alloc>
+bool operator!=(const chunked_list<Ty, Alloc>& lhs, const chunked_list<Ty, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+template<typename Ty, typename Alloc>
+bool operator<=(const chunked_list<Ty, Alloc>& lhs, const chunked_list<Ty, Alloc>& rhs) {
+    return !(rhs < lhs);
+}
+template<typename Ty, typename Alloc>
+bool operator>(const chunked_list<Ty, Alloc>& lhs, const chunked_list<Ty, Alloc>& rhs) {
+    return rhs < lhs;
+}
+template<typename Ty, typename Alloc>
+bool operator>=(const chunked_list<Ty, Alloc>& lhs, const chunked_list<Ty, Alloc>& rhs) {
+    return !(lhs < rhs);
+}
+
+}  // namespace uxs
+
+namespace std {
+template<typename Ty, typename Alloc>
+void swap(uxs::chunked_list<Ty, Alloc>& l1, uxs::chunked_list<Ty, Alloc>& l2) noexcept(noexcept(l1.swap(l2))) {
+    l1.swap(l2);
+}
+}  // namespace std
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "common.h"
+#include "memory.h"
 
 #include <atomic>
 #include <cassert>
@@ -68,6 +68,9 @@ class cow_ptr {
     friend cow_ptr<Ty_> make_cow(Args&&...);
 };
 
+template<typename Ty>
+struct is_trivially_relocatable<cow_ptr<Ty>> : std::true_type {};
+
 template<typename Ty, typename... Args>
 cow_ptr<Ty> make_cow(Args&&... args) {
     return cow_ptr<Ty>(new typename cow_ptr<Ty>::object_body_t(std::forward<Args>(args)...));
@@ -1352,6 +1352,9 @@ bool operator!=(const basic_value<CharT, Alloc>& lhs, const basic_value<CharT, A
 using value = basic_value<char>;
 
 }  // namespace db
+
+template<typename CharT, typename Alloc>
+struct is_trivially_relocatable<db::basic_value<CharT, Alloc>> : is_trivially_relocatable<Alloc> {};
 }  // namespace uxs
 
 namespace std {
@@ -1075,9 +1075,9 @@ inline char* vformat_to(char* p, std::string_view fmt, format_args args) {
 
 template<typename OutputIt, typename = std::enable_if_t<is_output_iterator<OutputIt, const char&>::value>>
 OutputIt vformat_to(OutputIt out, std::string_view fmt, format_args args) {
-    inline_dynbuffer buf;
+    basic_iterator_membuffer<char, OutputIt> buf(std::move(out));
     basic_vformat(buf, fmt, args);
-    return std::copy_n(buf.data(), buf.size(), std::move(out));
+    return buf.flush();
 }
 
 inline wchar_t* vformat_to(wchar_t* p, std::wstring_view fmt, wformat_args args) {
@@ -1087,9 +1087,9 @@ inline wchar_t* vformat_to(wchar_t* p, std::wstring_view fmt, wformat_args args)
 
 template<typename OutputIt, typename = std::enable_if_t<is_output_iterator<OutputIt, const wchar_t&>::value>>
 OutputIt vformat_to(OutputIt out, std::wstring_view fmt, wformat_args args) {
-    inline_wdynbuffer buf;
+    basic_iterator_membuffer<wchar_t, OutputIt> buf(std::move(out));
     basic_vformat(buf, fmt, args);
-    return std::copy_n(buf.data(), buf.size(), std::move(out));
+    return buf.flush();
 }
 
 inline char* vformat_to(char* p, const std::locale& loc, std::string_view fmt, format_args args) {
@@ -1099,9 +1099,9 @@ inline char* vformat_to(char* p, const std::locale& loc, std::string_view fmt, f
 
 template<typename OutputIt, typename = std::enable_if_t<is_output_iterator<OutputIt, const char&>::value>>
 OutputIt vformat_to(OutputIt out, const std::locale& loc, std::string_view fmt, format_args args) {
-    inline_dynbuffer buf;
+    basic_iterator_membuffer<char, OutputIt> buf(std::move(out));
     basic_vformat(buf, loc, fmt, args);
-    return std::copy_n(buf.data(), buf.size(), std::move(out));
+    return buf.flush();
 }
 
 inline wchar_t* vformat_to(wchar_t* p, const std::locale& loc, std::wstring_view fmt, wformat_args args) {
@@ -1111,9 +1111,9 @@ inline wchar_t* vformat_to(wchar_t* p, const std::locale& loc, std::wstring_view
 
 template<typename OutputIt, typename = std::enable_if_t<is_output_iterator<OutputIt, const wchar_t&>::value>>
 OutputIt vformat_to(OutputIt out, const std::locale& loc, std::wstring_view fmt, wformat_args args) {
-    inline_wdynbuffer buf;
+    basic_iterator_membuffer<wchar_t, OutputIt> buf(std::move(out));
     basic_vformat(buf, loc, fmt, args);
-    return std::copy_n(buf.data(), buf.size(), std::move(out));
+    return buf.flush();
 }
 
 // ---- format_to
@@ -1160,9 +1160,9 @@ inline format_to_n_result<char*> vformat_to_n(char* p, std::size_t n, std::strin
 
 template<typename OutputIt, typename = std::enable_if_t<is_output_iterator<OutputIt, const char&>::value>>
 format_to_n_result<OutputIt> vformat_to_n(OutputIt out, std::size_t n, std::string_view fmt, format_args args) {
-    inline_dynbuffer buf;
+    basic_iterator_membuffer<char, OutputIt> buf(std::move(out), n);
     basic_vformat(buf, fmt, args);
-    return {std::copy_n(buf.data(), std::min(buf.size(), n), std::move(out)), buf.size()};
+    return {buf.flush(), buf.size()};
 }
 
 inline format_to_n_result<wchar_t*> vformat_to_n(wchar_t* p, std::size_t n, std::wstring_view fmt, wformat_args args) {
@@ -1172,9 +1172,9 @@ inline format_to_n_result<wchar_t*> vformat_to_n(wchar_t* p, std::size_t n, std:
 
 template<typename OutputIt, typename = std::enable_if_t<is_output_iterator<OutputIt, const wchar_t&>::value>>
 format_to_n_result<OutputIt> vformat_to_n(OutputIt out, std::size_t n, std::wstring_view fmt, wformat_args args) {
-    inline_wdynbuffer buf;
+    basic_iterator_membuffer<wchar_t, OutputIt> buf(std::move(out), n);
     basic_vformat(buf, fmt, args);
-    return {std::copy_n(buf.data(), std::min(buf.size(), n), std::move(out)), buf.size()};
+    return {buf.flush(), buf.size()};
 }
 
 inline format_to_n_result<char*> vformat_to_n(char* p, std::size_t n, const std::locale& loc, std::string_view fmt,
@@ -1186,9 +1186,9 @@ inline format_to_n_result<char*> vformat_to_n(char* p, std::size_t n, const std:
 template<typename OutputIt, typename = std::enable_if_t<is_output_iterator<OutputIt, const char&>::value>>
 format_to_n_result<OutputIt> vformat_to_n(OutputIt out, std::size_t n, const std::locale& loc, std::string_view fmt,
                                           format_args args) {
-    inline_dynbuffer buf;
+    basic_iterator_membuffer<char, OutputIt> buf(std::move(out), n);
     basic_vformat(buf, loc, fmt, args);
-    return {std::copy_n(buf.data(), std::min(buf.size(), n), std::move(out)), buf.size()};
+    return {buf.flush(), buf.size()};
 }
 
 inline format_to_n_result<wchar_t*> vformat_to_n(wchar_t* p, std::size_t n, const std::locale& loc,
@@ -1200,9 +1200,9 @@ inline format_to_n_result<wchar_t*> vformat_to_n(wchar_t* p, std::size_t n, cons
 template<typename OutputIt, typename = std::enable_if_t<is_output_iterator<OutputIt, const wchar_t&>::value>>
 format_to_n_result<OutputIt> vformat_to_n(OutputIt out, std::size_t n, const std::locale& loc, std::wstring_view fmt,
                                           wformat_args args) {
-    inline_wdynbuffer buf;
+    basic_iterator_membuffer<wchar_t, OutputIt> buf(std::move(out), n);
     basic_vformat(buf, loc, fmt, args);
-    return {std::copy_n(buf.data(), std::min(buf.size(), n), std::move(out)), buf.size()};
+    return {buf.flush(), buf.size()};
 }
 
 // ---- format_to_n
@@ -1233,6 +1233,50 @@ format_to_n_result<OutputIt> format_to_n(OutputIt out, std::size_t n, const std:
     return vformat_to_n(std::move(out), n, loc, fmt.get(), make_wformat_args(args...));
 }
 
+// ---- vformatted_size
+
+inline std::size_t vformatted_size(std::string_view fmt, format_args args) {
+    membuffer_size_counter buf;
+    return basic_vformat(buf, fmt, args).size();
+}
+
+inline std::size_t vformatted_size(std::wstring_view fmt, wformat_args args) {
+    wmembuffer_size_counter buf;
+    return basic_vformat(buf, fmt, args).size();
+}
+
+inline std::size_t vformatted_size(const std::locale& loc, std::string_view fmt, format_args args) {
+    membuffer_size_counter buf;
+    return basic_vformat(buf, loc, fmt, args).size();
+}
+
+inline std::size_t vformatted_size(const std::locale& loc, std::wstring_view fmt, wformat_args args) {
+    wmembuffer_size_counter buf;
+    return basic_vformat(buf, loc, fmt, args).size();
+}
+
+// ---- formatted_size
+
+template<typename... Args>
+std::size_t formatted_size(format_string<Args...> fmt, const Args&... args) {
+    return vformatted_size(fmt.get(), make_format_args(args...));
+}
+
+template<typename... Args>
+std::size_t formatted_size(wformat_string<Args...> fmt, const Args&... args) {
+    return vformatted_size(fmt.get(), make_wformat_args(args...));
+}
+
+template<typename... Args>
+std::size_t formatted_size(const std::locale& loc, format_string<Args...> fmt, const Args&... args) {
+    return vformatted_size(loc, fmt.get(), make_format_args(args...));
+}
+
+template<typename... Args>
+std::size_t formatted_size(const std::locale& loc, wformat_string<Args...> fmt, const Args&... args) {
+    return vformatted_size(loc, fmt.get(), make_wformat_args(args...));
+}
+
 // ---- vprint
 
 inline iobuf& vprint(iobuf& out, std::string_view fmt, format_args args) {
@@ -1323,4 +1367,103 @@ iobuf& println(const std::locale& loc, format_string<Args...> fmt, const Args&..
     return vprint(stdbuf::out, loc, fmt.get(), make_format_args(args...)).endl();
 }
 
+// ---- vprint_atomic
+
+namespace detail {
+template<typename CharT>
+UXS_EXPORT void vprint_atomic(basic_iobuf<CharT>& out, locale_ref loc, std::basic_string_view<CharT> fmt,
+                              basic_format_args<basic_format_context<CharT>> args, bool endl);
+}
+
+// The text is formatted into a thread-local buffer first and then written to `out` at once under a lock,
+// so the texts written by concurrent `*_atomic` calls never interleave. `println_atomic` also flushes `out`
+// under the same lock. The buffer must not be accessed concurrently by other means
+inline iobuf& vprint_atomic(iobuf& out, std::string_view fmt, format_args args) {
+    detail::vprint_atomic(out, locale_ref{}, fmt, args, false);
+    return out;
+}
+
+inline wiobuf& vprint_atomic(wiobuf& out, std::wstring_view fmt, wformat_args args) {
+    detail::vprint_atomic(out, locale_ref{}, fmt, args, false);
+    return out;
+}
+
+inline iobuf& vprint_atomic(iobuf& out, const std::locale& loc, std::string_view fmt, format_args args) {
+    detail::vprint_atomic(out, locale_ref{loc}, fmt, args, false);
+    return out;
+}
+
+inline wiobuf& vprint_atomic(wiobuf& out, const std::locale& loc, std::wstring_view fmt, wformat_args args) {
+    detail::vprint_atomic(out, locale_ref{loc}, fmt, args, false);
+    return out;
+}
+
+// ---- print_atomic
+
+template<typename... Args>
+iobuf& print_atomic(iobuf& out, format_string<Args...> fmt, const Args&... args) {
+    return vprint_atomic(out, fmt.get(), make_format_args(args...));
+}
+
+template<typename... Args>
+wiobuf& print_atomic(wiobuf& out, wformat_string<Args...> fmt, const Args&... args) {
+    return vprint_atomic(out, fmt.get(), make_wformat_args(args...));
+}
+
+template<typename... Args>
+iobuf& print_atomic(format_string<Args...> fmt, const Args&... args) {
+    return vprint_atomic(stdbuf::out, fmt.get(), make_format_args(args...));
+}
+
+template<typename... Args>
+iobuf& print_atomic(iobuf& out, const std::locale& loc, format_string<Args...> fmt, const Args&... args) {
+    return vprint_atomic(out, loc, fmt.get(), make_format_args(args...));
+}
+
+template<typename... Args>
+wiobuf& print_atomic(wiobuf& out, const std::locale& loc, wformat_string<Args...> fmt, const Args&... args) {
+    return vprint_atomic(out, loc, fmt.get(), make_wformat_args(args...));
+}
+
+template<typename... Args>
+iobuf& print_atomic(const std::locale& loc, format_string<Args...> fmt, const Args&... args) {
+    return vprint_atomic(stdbuf::out, loc, fmt.get(), make_format_args(args...));
+}
+
+// ---- println_atomic
+
+template<typename... Args>
+iobuf& println_atomic(iobuf& out, format_string<Args...> fmt, const Args&... args) {
+    detail::vprint_atomic<char>(out, locale_ref{}, fmt.get(), make_format_args(args...), true);
+    return out;
+}
+
+template<typename... Args>
+wiobuf& println_atomic(wiobuf& out, wformat_string<Args...> fmt, const Args&... args) {
+    detail::vprint_atomic<wchar_t>(out, locale_ref{}, fmt.get(), make_wformat_args(args...), true);
+    return out;
+}
+
+template<typename... Args>
+iobuf& println_atomic(format_string<Args...> fmt, const Args&... args) {
+    return println_atomic(stdbuf::out, fmt, args...);
+}
+
+template<typename... Args>
+iobuf& println_atomic(iobuf& out, const std::locale& loc, format_string<Args...> fmt, const Args&... args) {
+    detail::vprint_atomic<char>(out, locale_ref{loc}, fmt.get(), make_format_args(args...), true);
+    return out;
+}
+
+template<typename... Args>
+wiobuf& println_atomic(wiobuf& out, const std::locale& loc, wformat_string<Args...> fmt, const Args&... args) {
+    detail::vprint_atomic<wchar_t>(out, locale_ref{loc}, fmt.get(), make_wformat_args(args...), true);
+    return out;
+}
+
+template<typename... Args>
+iobuf& println_atomic(const std::locale& loc, format_string<Args...> fmt, const Args&... args) {
+    return println_atomic(stdbuf::out, loc, fmt, args...);
+}
+
 }  // namespace uxs
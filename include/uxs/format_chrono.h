@@ -264,9 +264,20 @@ class formatbuf : public StreamBuf {
     }
 };
 
+inline bool is_locale_classic(locale_ref loc, fmt_opts opts) {
+    return !(opts.flags & fmt_flags::localize) || *loc == std::locale::classic();
+}
+
+template<typename FmtCtx>
+void format_chrono_classic(FmtCtx& ctx, const std::tm& tm, char spec);
+
 template<typename FmtCtx>
 void format_chrono_locale(FmtCtx& ctx, const std::tm& tm, char spec, char modifier, fmt_opts opts) {
     using char_type = typename FmtCtx::char_type;
+    // `std::tm` carries no time zone, so time zone specifiers are left to `std::time_put`
+    if (is_locale_classic(ctx.locale(), opts) && spec != 'z' && spec != 'Z') {
+        return format_chrono_classic(ctx, tm, spec);
+    }
     formatbuf<FmtCtx, std::basic_streambuf<char_type>> format_buf(ctx);
     std::basic_ostream<char_type> os(&format_buf);
     auto loc = !!(opts.flags & fmt_flags::localize) ? *ctx.locale() : std::locale::classic();
@@ -281,10 +292,6 @@ void format_chrono_locale(FmtCtx& ctx, const std::tm& tm, const chrono_specs& sp
     format_chrono_locale(ctx, tm, specs.spec_char, specs.modifier, specs.opts);
 }
 
-inline bool is_locale_classic(locale_ref loc, fmt_opts opts) {
-    return !(opts.flags & fmt_flags::localize) || *loc == std::locale::classic();
-}
-
 template<typename FmtCtx>
 void format_append_2digs(FmtCtx& ctx, int v) {
     assert(v >= 0 && v < 100);
@@ -690,6 +697,143 @@ void format_chrono_yyyy_mm_dd_hh_mm_ss(FmtCtx& ctx, std::chrono::sys_time<Durati
     format_chrono_hh_mm_ss(ctx, std::chrono::hh_mm_ss{t - days}, opts);
 }
 
+// --- time zone ---
+
+// `%Ez` and `%Oz` insert a colon between hours and minutes
+template<typename FmtCtx>
+void format_chrono_utc_offset(FmtCtx& ctx, std::chrono::seconds offset, const chrono_specs& specs) {
+    const std::chrono::hh_mm_ss hms{offset};
+    ctx.out() += hms.is_negative() ? '-' : '+';
+    format_append_2digs(ctx, static_cast<int>(hms.hours().count() % 100));
+    if (specs.modifier) { ctx.out() += ':'; }
+    format_append_2digs(ctx, static_cast<int>(hms.minutes().count()));
+}
+
+// --- C locale ---
+
+inline int iso_8601_week_days(int yday, int wday) {
+    // the number of days from the first day of the first ISO week of this year to the given year day
+    return yday - (yday - wday + 382) % 7 + 3;
+}
+
+template<typename FmtCtx>
+void format_chrono_iso_8601_week(FmtCtx& ctx, const std::tm& tm, char spec) {
+    int year = tm.tm_year + 1900;
+    int days = iso_8601_week_days(tm.tm_yday, tm.tm_wday);
+    if (days < 0) {
+        --year;
+        days = iso_8601_week_days(tm.tm_yday + (std::chrono::year{year}.is_leap() ? 366 : 365), tm.tm_wday);
+    } else {
+        const int next_year_days = iso_8601_week_days(
+            tm.tm_yday - (std::chrono::year{year}.is_leap() ? 366 : 365), tm.tm_wday);
+        if (next_year_days >= 0) { ++year, days = next_year_days; }
+    }
+    switch (spec) {
+        case 'g': return format_chrono_year_yy(ctx, std::chrono::year{year});
+        case 'G': return format_chrono_year_yyyy(ctx, std::chrono::year{year});
+        default: return format_append_2digs(ctx, days / 7 + 1);
+    }
+}
+
+// Formats `std::tm` the same way as `std::time_put` does for classic locale, but without any streams
+template<typename FmtCtx>
+void format_chrono_classic(FmtCtx& ctx, const std::tm& tm, char spec) {
+    using char_type = typename FmtCtx::char_type;
+    const std::chrono::year y{tm.tm_year + 1900};
+    const auto hours = std::chrono::hours{tm.tm_hour};
+    switch (spec) {
+        // --- year ---
+        case 'C': return format_chrono_century(ctx, y);
+        case 'y': return format_chrono_year_yy(ctx, y);
+        case 'Y': return format_chrono_year_yyyy(ctx, y);
+        // --- month ---
+        case 'b':
+        case 'h': return format_chrono_month_brief(ctx, std::chrono::month(tm.tm_mon + 1));
+        case 'B': return format_chrono_month_full(ctx, std::chrono::month(tm.tm_mon + 1));
+        case 'm': return format_append_2digs(ctx, tm.tm_mon + 1);
+        // --- day ---
+        case 'd': return format_chrono_day_dd(ctx, std::chrono::day(tm.tm_mday));
+        case 'e': return format_chrono_day_dd_space(ctx, std::chrono::day(tm.tm_mday));
+        // --- day of the week ---
+        case 'a': return format_chrono_weekday_brief(ctx, std::chrono::weekday(tm.tm_wday));
+        case 'A': return format_chrono_weekday_full(ctx, std::chrono::weekday(tm.tm_wday));
+        case 'u': {
+            ctx.out() += static_cast<char_type>('0' + (tm.tm_wday ? tm.tm_wday : 7));
+        } break;
+        case 'w': {
+            ctx.out() += static_cast<char_type>('0' + tm.tm_wday);
+        } break;
+        // -- ISO 8601 week-based year
+        case 'g':
+        case 'G':
+        case 'V': return format_chrono_iso_8601_week(ctx, tm, spec);
+        // --- day/week of the year ---
+        case 'j': {
+            ctx.out() += static_cast<char_type>('0' + (tm.tm_yday + 1) / 100);
+            format_append_2digs(ctx, (tm.tm_yday + 1) % 100);
+        } break;
+        case 'U': return format_append_2digs(ctx, (tm.tm_yday + 7 - tm.tm_wday) / 7);
+        case 'W': return format_append_2digs(ctx, (tm.tm_yday + 7 - (tm.tm_wday + 6) % 7) / 7);
+        // --- date ---
+        case 'D':
+        case 'x': {
+            format_append_2digs(ctx, tm.tm_mon + 1);
+            ctx.out() += '/';
+            format_append_2digs(ctx, tm.tm_mday);
+            ctx.out() += '/';
+            format_chrono_year_yy(ctx, y);
+        } break;
+        case 'F': {
+            format_chrono_year_yyyy(ctx, y);
+            ctx.out() += '-';
+            format_append_2digs(ctx, tm.tm_mon + 1);
+            ctx.out() += '-';
+            format_append_2digs(ctx, tm.tm_mday);
+        } break;
+        // --- time of day ---
+        case 'H': return format_append_2digs(ctx, tm.tm_hour);
+        case 'I': return format_chrono_hours_12(ctx, hours);
+        case 'M': return format_append_2digs(ctx, tm.tm_min);
+        case 'S': return format_append_2digs(ctx, tm.tm_sec);
+        case 'p': return format_chrono_am_pm(ctx, hours);
+        case 'R': {
+            format_append_2digs(ctx, tm.tm_hour);
+            ctx.out() += ':';
+            format_append_2digs(ctx, tm.tm_min);
+        } break;
+        case 'T':
+        case 'X': {
+            format_append_2digs(ctx, tm.tm_hour);
+            ctx.out() += ':';
+            format_append_2digs(ctx, tm.tm_min);
+            ctx.out() += ':';
+            format_append_2digs(ctx, tm.tm_sec);
+        } break;
+        case 'r': {
+            format_chrono_hours_12(ctx, hours);
+            ctx.out() += ':';
+            format_append_2digs(ctx, tm.tm_min);
+            ctx.out() += ':';
+            format_append_2digs(ctx, tm.tm_sec);
+            ctx.out() += ' ';
+            format_chrono_am_pm(ctx, hours);
+        } break;
+        // --- miscellaneous ---
+        case 'c': {
+            format_chrono_weekday_brief(ctx, std::chrono::weekday(tm.tm_wday));
+            ctx.out() += ' ';
+            format_chrono_month_brief(ctx, std::chrono::month(tm.tm_mon + 1));
+            ctx.out() += ' ';
+            format_chrono_day_dd_space(ctx, std::chrono::day(tm.tm_mday));
+            ctx.out() += ' ';
+            format_chrono_classic(ctx, tm, 'T');
+            ctx.out() += ' ';
+            format_chrono_year_yyyy(ctx, y);
+        } break;
+        default: throw format_error("failed to format time");
+    }
+}
+
 // --------------------------
 
 template<typename Ty, typename = void>
@@ -751,6 +895,76 @@ UXS_FMT_IMPLEMENT_CHRONO_DURATION_SUFFIX(std::ratio<3600>, 'h')
 UXS_FMT_IMPLEMENT_CHRONO_DURATION_SUFFIX(std::ratio<86400>, 'd')
 #undef UXS_FMT_IMPLEMENT_CHRONO_DURATION_SUFFIX
 
+template<typename Ty, typename = void>
+struct is_second_cacheable_time_point : std::false_type {};
+
+template<typename Clock, typename Duration>
+struct is_second_cacheable_time_point<
+    std::chrono::time_point<Clock, Duration>,
+    std::enable_if_t<(std::is_same<Clock, std::chrono::system_clock>::value ||
+                      std::is_same<Clock, std::chrono::local_t>::value) &&
+                     !std::chrono::treat_as_floating_point<typename Duration::rep>::value>> : std::true_type {};
+
+// Per-thread cache of the last formatted time point: time points within the same second differ only in sub-second
+// digits, so the rest of formatted string is reused
+template<typename TimePoint, typename CharT>
+class chrono_second_cache {
+ public:
+    using hh_mm_ss_type = decltype(std::chrono::hh_mm_ss{
+        std::declval<TimePoint>() - std::chrono::floor<std::chrono::days>(std::declval<TimePoint>())});
+    enum : unsigned { subsec_width = hh_mm_ss_type::fractional_width, max_subsec_count = 4 };
+
+    static chrono_second_cache& get() {
+        static thread_local chrono_second_cache cache;
+        return cache;
+    }
+
+    static std::chrono::seconds::rep get_seconds(const TimePoint& t) {
+        return std::chrono::floor<std::chrono::seconds>(t).time_since_epoch().count();
+    }
+
+    const inline_basic_dynbuffer<CharT>& text() const { return text_; }
+    inline_basic_dynbuffer<CharT>& text() { return text_; }
+
+    bool find(const TimePoint& t, std::string_view fmt) {
+        if (!valid_ || seconds_ != get_seconds(t) || fmt.size() != fmt_.size() ||
+            !std::equal(fmt.begin(), fmt.end(), fmt_.data())) {
+            return false;
+        }
+        if (subsec_count_ == 0) { return true; }
+        const std::uint64_t subsecs = static_cast<std::uint64_t>(
+            hh_mm_ss_type{t - std::chrono::floor<std::chrono::days>(t)}.subseconds().count());
+        for (unsigned n = 0; n < subsec_count_; ++n) {
+            CharT* p = text_.data() + subsec_pos_[n] + subsec_width;
+            std::uint64_t v = subsecs;
+            for (unsigned i = 0; i < subsec_width; ++i, v /= 10) { *--p = static_cast<CharT>('0' + v % 10); }
+        }
+        return true;
+    }
+
+    void reset(const TimePoint& t, std::string_view fmt) {
+        valid_ = false, seconds_ = get_seconds(t), subsec_count_ = 0;
+        fmt_.clear(), text_.clear();
+        fmt_.append(fmt.begin(), fmt.end());
+    }
+
+    void field_written(bool ends_with_seconds) {
+        if (!ends_with_seconds || subsec_width == 0) { return; }
+        if (subsec_count_ < max_subsec_count) { subsec_pos_[subsec_count_] = text_.size() - subsec_width; }
+        ++subsec_count_;
+    }
+
+    void commit() { valid_ = subsec_count_ <= max_subsec_count; }
+
+ private:
+    bool valid_ = false;
+    std::chrono::seconds::rep seconds_ = 0;
+    unsigned subsec_count_ = 0;
+    std::size_t subsec_pos_[max_subsec_count]{};
+    inline_basic_dynbuffer<char> fmt_;
+    inline_basic_dynbuffer<CharT> text_;
+};
+
 template<typename DeriverFormatterTy, typename Ty, typename CharT>
 struct chrono_formatter {
  private:
@@ -761,7 +975,30 @@ struct chrono_formatter {
 
     template<typename FmtCtx>
     void format_impl(FmtCtx& ctx, const Ty& val, chrono_specs& specs) const {
-        if (fmt_.empty()) { return DeriverFormatterTy::template default_value_writer<FmtCtx>(ctx, val, specs.opts); }
+        if constexpr (is_second_cacheable_time_point<Ty>::value) {
+            if (!(specs.opts.flags & fmt_flags::localize)) {
+                auto& cache = chrono_second_cache<Ty, CharT>::get();
+                if (!cache.find(val, fmt_)) {
+                    cache.reset(val, fmt_);
+                    basic_format_context<CharT> cache_ctx{cache.text(), ctx};
+                    format_impl(cache_ctx, val, specs, [&cache](bool ends_with_seconds) {
+                        cache.field_written(ends_with_seconds);
+                    });
+                    cache.commit();
+                }
+                ctx.out().append(cache.text().data(), cache.text().size());
+                return;
+            }
+        }
+        format_impl(ctx, val, specs, [](bool) {});
+    }
+
+    template<typename FmtCtx, typename FieldWrittenFn>
+    void format_impl(FmtCtx& ctx, const Ty& val, chrono_specs& specs, const FieldWrittenFn& field_written) const {
+        if (fmt_.empty()) {
+            DeriverFormatterTy::template default_value_writer<FmtCtx>(ctx, val, specs.opts);
+            return field_written(true);
+        }
         auto it0 = fmt_.begin();
         auto it = it0;
         while (true) {
@@ -778,6 +1015,8 @@ struct chrono_formatter {
                     default: {
                         specs.spec_char = *(it - 1);
                         DeriverFormatterTy::template value_writer<FmtCtx>(ctx, val, specs);
+                        field_written(!specs.modifier && (specs.spec == chrono_specifier::seconds ||
+                                                          specs.spec == chrono_specifier::hours_minutes_seconds));
                     } break;
                 }
             }
@@ -1100,7 +1339,7 @@ struct formatter<std::chrono::sys_time<Duration>, CharT>
     template<typename FmtCtx>
     static void value_writer(FmtCtx& ctx, value_type t, const detail::chrono_specs& specs) {
         if (specs.spec == detail::chrono_specifier::time_zone) {
-            ctx.out() += string_literal<typename FmtCtx::char_type, '+', '0', '0', '0', '0'>{}();
+            detail::format_chrono_utc_offset(ctx, std::chrono::seconds{0}, specs);
         } else if (specs.spec == detail::chrono_specifier::time_zone_abbreviation) {
             ctx.out() += string_literal<typename FmtCtx::char_type, 'U', 'T', 'C'>{}();
         } else {
@@ -1153,10 +1392,7 @@ struct formatter<detail::local_time_format_t<Duration>, CharT>
     template<typename FmtCtx>
     static void value_writer(FmtCtx& ctx, value_type t, const detail::chrono_specs& specs) {
         if (specs.spec == detail::chrono_specifier::time_zone) {
-            std::chrono::hh_mm_ss offset{t.offset};
-            ctx.out() += offset.is_negative() ? '-' : '+';
-            detail::format_append_2digs(ctx, static_cast<int>(offset.hours().count() % 100));
-            detail::format_append_2digs(ctx, static_cast<int>(offset.minutes().count()));
+            detail::format_chrono_utc_offset(ctx, t.offset, specs);
         } else if (specs.spec == detail::chrono_specifier::time_zone_abbreviation) {
             ctx.out() += t.abbrev;
         } else {
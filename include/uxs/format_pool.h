@@ -0,0 +1,33 @@
+#pragma once
+
+#include "format_base.h"
+#include "pool_allocator.h"
+
+namespace uxs {
+
+// Formats pool statistics as a single line; no format specifiers are accepted
+template<>
+struct formatter<pool_stats_t, char> {
+    template<typename ParseCtx>
+    UXS_CONSTEXPR typename ParseCtx::iterator parse(ParseCtx& ctx) {
+        auto it = ctx.begin();
+        if (it == ctx.end() || *it != ':') { return it; }
+        if (++it != ctx.end() && *it != '}') { ParseCtx::syntax_error(); }
+        return it;
+    }
+
+    template<typename FmtCtx>
+    void format(FmtCtx& ctx, const pool_stats_t& val) const {
+        const std::size_t capacity = val.partition_count * val.node_count_per_partition;
+        basic_format(ctx.out(), "size {} align {}: {} partitions x {} nodes, {} live ({:.1f}% full), {} free",
+                     val.node_size, val.node_alignment, val.partition_count, val.node_count_per_partition,
+                     val.live_count, capacity ? 100. * val.live_count / capacity : 0., val.free_count);
+#if defined(UXS_USE_POOL_STATS)
+        basic_format(ctx.out(), "; {} allocs, {} frees, {} peak live, {} partitions allocated, {} released",
+                     val.alloc_count, val.dealloc_count, val.peak_live_count, val.partition_alloc_count,
+                     val.partition_dealloc_count);
+#endif  // defined(UXS_USE_POOL_STATS)
+    }
+};
+
+}  // namespace uxs
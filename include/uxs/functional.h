@@ -127,6 +127,10 @@ template<typename Ty = void>
 struct greater_equal {
     bool operator()(const Ty& lhs, const Ty& rhs) const { return !(lhs < rhs); }
 };
+template<typename Ty = void>
+struct plus {
+    Ty operator()(const Ty& lhs, const Ty& rhs) const { return lhs + rhs; }
+};
 template<>
 struct equal_to<void> {
     using is_transparent = int;
@@ -175,6 +179,14 @@ struct greater_equal<void> {
         return !(lhs < rhs);
     }
 };
+template<>
+struct plus<void> {
+    using is_transparent = int;
+    template<typename Ty1, typename Ty2>
+    auto operator()(Ty1&& lhs, Ty2&& rhs) const -> decltype(std::forward<Ty1>(lhs) + std::forward<Ty2>(rhs)) {
+        return std::forward<Ty1>(lhs) + std::forward<Ty2>(rhs);
+    }
+};
 #else   // __cplusplus < 201402L
 template<typename Ty = void>
 using equal_to = std::equal_to<Ty>;
@@ -188,6 +200,8 @@ template<typename Ty = void>
 using less_equal = std::less_equal<Ty>;
 template<typename Ty = void>
 using greater_equal = std::greater_equal<Ty>;
+template<typename Ty = void>
+using plus = std::plus<Ty>;
 #endif  // __cplusplus < 201402L
 
 template<typename Val, typename Func, typename Eq>
@@ -69,6 +69,11 @@ class guid {
     }
     static guid from_per_byte_wstring(std::wstring_view s) noexcept { return from_per_byte_basic_string(s); }
 
+    // Conversion to and from canonical 36-character form `xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx`;
+    // `from_canonical_chars` returns `false` and leaves `id` untouched if the string is ill-formed
+    UXS_EXPORT void to_canonical_chars(char* p, bool upper = false) const noexcept;
+    UXS_EXPORT static bool from_canonical_chars(const char* p, guid& id) noexcept;
+
     UXS_EXPORT static guid generate();
 
  private:
@@ -108,6 +113,7 @@ struct from_string_impl<guid, CharT> {
     const CharT* operator()(const CharT* first, const CharT* last, guid& val) const noexcept {
         const std::size_t len = 38;
         if (static_cast<std::size_t>(last - first) < len) { return 0; }
+        if (parse_canonical(first + 1, val)) { return first + len; }
         const auto* p = first;
         val.data32(0) = from_hex(p + 1, 8);
         val.data16(2) = from_hex(p + 10, 4);
@@ -118,6 +124,13 @@ struct from_string_impl<guid, CharT> {
         for (unsigned i = 10; i < 16; ++i, p += 2) { val.data8(i) = from_hex(p, 2); }
         return first + len;
     }
+
+ private:
+    static bool parse_canonical(const char* p, guid& val) noexcept { return guid::from_canonical_chars(p, val); }
+    template<typename CharU>
+    static bool parse_canonical(const CharU* /*p*/, guid& /*val*/) noexcept {
+        return false;
+    }
 };
 
 template<typename CharT>
@@ -128,17 +141,25 @@ struct to_string_impl<guid, CharT> {
         const bool upper = !!(fmt.flags & fmt_flags::uppercase);
         std::array<typename StrTy::value_type, len> buf;
         auto* p = buf.data();
-        p[0] = '{', p[9] = '-', p[14] = '-', p[19] = '-', p[24] = '-', p[37] = '}';
-        to_hex(val.data32(0), p + 1, 8, upper);
-        to_hex(val.data16(2), p + 10, 4, upper);
-        to_hex(val.data16(3), p + 15, 4, upper);
-        to_hex(val.data8(8), p + 20, 2, upper);
-        to_hex(val.data8(9), p + 22, 2, upper);
-        p += 25;
-        for (unsigned i = 10; i < 16; ++i, p += 2) { to_hex(val.data8(i), p, 2, upper); }
+        p[0] = '{', p[37] = '}';
+        print_canonical(p + 1, val, upper);
         const auto fn = [&buf](StrTy& s) { s.append(buf.data(), buf.size()); };
         fmt.width > len ? append_adjusted(s, fn, len, fmt) : fn(s);
     }
+
+ private:
+    static void print_canonical(char* p, const guid& val, bool upper) noexcept { val.to_canonical_chars(p, upper); }
+    template<typename CharU>
+    static void print_canonical(CharU* p, const guid& val, bool upper) noexcept {
+        p[8] = '-', p[13] = '-', p[18] = '-', p[23] = '-';
+        to_hex(val.data32(0), p, 8, upper);
+        to_hex(val.data16(2), p + 9, 4, upper);
+        to_hex(val.data16(3), p + 14, 4, upper);
+        to_hex(val.data8(8), p + 19, 2, upper);
+        to_hex(val.data8(9), p + 21, 2, upper);
+        p += 24;
+        for (unsigned i = 10; i < 16; ++i, p += 2) { to_hex(val.data8(i), p, 2, upper); }
+    }
 };
 
 template<typename CharT>
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "utility.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace uxs {
+
+enum class huge_page_flags : std::uint8_t {
+    none = 0,
+    transparent = 1,     // advise the system to back memory with transparent huge pages
+    explicit_pages = 2,  // use reserved huge pages, normal pages are used if there are no reserved pages
+    numa_local = 4,      // prefer the NUMA node of the calling thread
+    def = transparent,
+};
+UXS_IMPLEMENT_BITWISE_OPS_FOR_ENUM(huge_page_flags);
+
+enum : std::size_t { huge_page_size = 0x200000 };
+
+// Allocates memory aligned by `huge_page_size`, the size is rounded up to `huge_page_size`;
+// throws `std::bad_alloc` on failure
+UXS_EXPORT void* alloc_huge_pages(std::size_t sz, huge_page_flags flags);
+UXS_EXPORT void free_huge_pages(void* p, std::size_t sz) noexcept;
+
+// Page blocks for large growing buffers, sizes are rounded up to `huge_page_size`; `realloc_pages` keeps
+// the contents, and on Linux pages are remapped with `mremap` without copying;
+// allocation functions throw `std::bad_alloc` on failure
+UXS_EXPORT void* alloc_pages(std::size_t sz);
+UXS_EXPORT void* realloc_pages(void* p, std::size_t old_sz, std::size_t new_sz);
+UXS_EXPORT void free_pages(void* p, std::size_t sz) noexcept;
+
+// Partition source for pool allocator: blocks of at least a half of `huge_page_size` are allocated
+// from huge pages, smaller blocks are allocated with `std::allocator`. Pool partition size should be
+// `huge_page_size` or its multiple:
+//     uxs::pool_allocator<T, uxs::huge_page_allocator<T>> al(uxs::huge_page_size);
+template<typename Ty>
+class huge_page_allocator {
+ public:
+    using value_type = Ty;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::true_type;
+
+    huge_page_allocator() noexcept = default;
+    explicit huge_page_allocator(huge_page_flags flags) noexcept : flags_(flags) {}
+
+    template<typename Ty2>
+    huge_page_allocator(const huge_page_allocator<Ty2>& other) noexcept : flags_(other.flags()) {}
+
+    huge_page_flags flags() const noexcept { return flags_; }
+
+    Ty* allocate(std::size_t sz) {
+        if (sz < min_block_size / sizeof(Ty)) { return std::allocator<Ty>().allocate(sz); }
+        return static_cast<Ty*>(alloc_huge_pages(sz * sizeof(Ty), flags_));
+    }
+
+    void deallocate(Ty* p, std::size_t sz) noexcept {
+        if (sz < min_block_size / sizeof(Ty)) { return std::allocator<Ty>().deallocate(p, sz); }
+        free_huge_pages(p, sz * sizeof(Ty));
+    }
+
+ private:
+    enum : std::size_t { min_block_size = huge_page_size / 2 };
+    huge_page_flags flags_ = huge_page_flags::def;
+};
+
+// Memory is freed the same way regardless of flags
+template<typename TyL, typename TyR>
+bool operator==(const huge_page_allocator<TyL>& /*lhs*/, const huge_page_allocator<TyR>& /*rhs*/) noexcept {
+    return true;
+}
+template<typename TyL, typename TyR>
+bool operator!=(const huge_page_allocator<TyL>& lhs, const huge_page_allocator<TyR>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+}  // namespace uxs
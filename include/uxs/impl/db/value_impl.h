@@ -62,28 +62,17 @@ UXS_EXPORT bool operator==(const basic_value<CharT, Alloc>& lhs, const basic_val
 
 namespace detail {
 
-template<typename Alloc, typename Ty,
-         typename = std::enable_if_t<
-             std::is_trivially_move_constructible<Ty>::value ||
-             std::is_same<typename std::allocator_traits<Alloc>::template rebind_alloc<Ty>, std::allocator<Ty>>::value>>
-static void move_values(const Ty* first, const Ty* last, Ty* dest) {
+template<typename Ty>
+static void relocate_values(Ty* first, Ty* last, Ty* dest, std::true_type /* trivially relocatable */) {
     std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), (last - first) * sizeof(Ty));
 }
 
-template<typename Alloc, typename Ty, typename... Dummy>
-static void move_values(const Ty* first, const Ty* last, Ty* dest, Dummy&&...) {
-    for (; first != last; ++first, ++dest) { new (dest) Ty(std::move(*first)); }
-}
-
-template<typename Alloc, typename Ty,
-         typename = std::enable_if_t<
-             std::is_trivially_destructible<Ty>::value ||
-             std::is_same<typename std::allocator_traits<Alloc>::template rebind_alloc<Ty>, std::allocator<Ty>>::value>>
-static void destruct_moved_values(Ty* first, Ty* last) {}
-
-template<typename Alloc, typename Ty, typename... Dummy>
-static void destruct_moved_values(Ty* first, Ty* last, Dummy&&...) {
-    for (; first != last; ++first) { first->~Ty(); };
+template<typename Ty>
+static void relocate_values(Ty* first, Ty* last, Ty* dest, std::false_type /* trivially relocatable */) {
+    for (; first != last; ++first, ++dest) {
+        new (dest) Ty(std::move(*first));
+        first->~Ty();
+    }
 }
 
 template<typename Ty, typename Alloc>
@@ -104,9 +93,8 @@ template<typename Ty, typename Alloc>
         delta_sz = std::max(extra, (max_sz - arr->size) >> 1);
     }
     flexarray_t* new_arr = alloc(arr_al, std::max<std::size_t>(arr->size + delta_sz, start_capacity));
-    detail::move_values<alloc_type>(&(*arr)[0], &(*arr)[arr->size], &(*new_arr)[0]);
+    detail::relocate_values(&(*arr)[0], &(*arr)[arr->size], &(*new_arr)[0], is_trivially_relocatable<Ty>());
     new_arr->size = arr->size;
-    detail::destruct_moved_values<alloc_type>(&(*arr)[0], &(*arr)[arr->size]);
     dealloc(arr_al, arr);
     return new_arr;
 }
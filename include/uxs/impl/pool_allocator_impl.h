@@ -34,6 +34,10 @@ template<typename Alloc>
     new (desc) alloc_type(std::move(al));
     dllist_make_cycle(&desc->free);
     dllist_make_cycle(&desc->partitions);
+    desc->empty_partition_count = 0;
+#if defined(UXS_USE_POOL_STATS)
+    desc->counters = pool_counters_t{};
+#endif  // defined(UXS_USE_POOL_STATS)
     return desc;
 }
 
@@ -45,8 +49,49 @@ template<typename Alloc>
     desc->size_and_alignment = 0;
     desc->ref_count = 1;
     desc->partition_size = partition_size;
+    desc->trim_threshold = 0;
     return desc;
 }
 
+template<typename Alloc>
+void pool<Alloc>::trim() {
+    auto* desc = desc_->root_pool;
+    do {
+        if (desc->empty_partition_count) {
+            dllist_node_t* part_hdr = desc->partitions.next;
+            while (part_hdr != &desc->partitions) {
+                dllist_node_t* next_part = part_hdr->next;
+                auto* hdr = static_cast<pool_part_hdr_t*>(part_hdr);
+                if (hdr->use_count == 0) { desc->deallocate_partition(desc, hdr); }
+                part_hdr = next_part;
+            }
+            desc->empty_partition_count = 0;
+        }
+        desc = desc->next_pool;
+    } while (desc != desc_->root_pool);
+}
+
+template<typename Alloc>
+std::vector<pool_stats_t> pool<Alloc>::stats() const {
+    std::vector<pool_stats_t> result;
+    auto* desc = desc_->root_pool;
+    do {
+        if (desc->size_and_alignment) {
+            pool_stats_t stats{};
+            desc->collect_stats(desc, stats);
+#if defined(UXS_USE_POOL_STATS)
+            stats.alloc_count = desc->counters.alloc_count;
+            stats.dealloc_count = desc->counters.dealloc_count;
+            stats.partition_alloc_count = desc->counters.partition_alloc_count;
+            stats.partition_dealloc_count = desc->counters.partition_dealloc_count;
+            stats.peak_live_count = desc->counters.peak_live_count;
+#endif  // defined(UXS_USE_POOL_STATS)
+            result.push_back(stats);
+        }
+        desc = desc->next_pool;
+    } while (desc != desc_->root_pool);
+    return result;
+}
+
 }  // namespace detail
 }  // namespace uxs
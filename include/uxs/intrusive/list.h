@@ -61,14 +61,11 @@ struct list_hook_getter<opt_member_hook<ParentTy, HookTy, HookMember>> {
 
 namespace detail {
 
-template<typename Ty, typename HookTraits>
-struct list_node_traits {
-    using iterator_node_t = list_links_t;
+// Operations on owning pointers, which are common for all intrusive containers
+template<typename HookTraits>
+struct hook_pointer_ops {
     using hook_t = typename HookTraits::hook_t;
     using owning_pointer_t = typename HookTraits::owning_pointer_t;
-    static list_links_t* get_next(list_links_t* node) { return node->next; }
-    static list_links_t* get_prev(list_links_t* node) { return node->prev; }
-    static Ty& get_value(list_links_t* node) { return HookTraits{}.get_value(static_cast<hook_t*>(node)); }
 
     static auto release_pointer(hook_t* h) -> decltype(HookTraits{}.release_pointer(h)) {
         return HookTraits{}.release_pointer(h);
@@ -93,6 +90,18 @@ struct list_node_traits {
 
     using has_reset_pointer = std::is_same<decltype(reset_pointer(nullptr, std::declval<owning_pointer_t>())), int>;
     using has_dispose = std::is_same<decltype(dispose(std::declval<owning_pointer_t>())), int>;
+};
+
+template<typename Ty, typename HookTraits>
+struct list_node_traits : hook_pointer_ops<HookTraits> {
+    using iterator_node_t = list_links_t;
+    using hook_t = typename HookTraits::hook_t;
+    using owning_pointer_t = typename HookTraits::owning_pointer_t;
+    using hook_pointer_ops<HookTraits>::reset_pointer;
+    using hook_pointer_ops<HookTraits>::dispose;
+    static list_links_t* get_next(list_links_t* node) { return node->next; }
+    static list_links_t* get_prev(list_links_t* node) { return node->prev; }
+    static Ty& get_value(list_links_t* node) { return HookTraits{}.get_value(static_cast<hook_t*>(node)); }
 
     template<typename Traits = list_node_traits,
              typename = std::enable_if_t<Traits::has_reset_pointer::value || Traits::has_dispose::value>>
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "rbtree.h"
+
+namespace uxs {
+namespace intrusive {
+
+template<typename Ty, typename Comp = std::less<Ty>, typename HookTraits = list_hook_traits<Ty, rbtree_links_t>,
+         typename HookGetter = void>
+class multiset : public detail::rbtree_base<Ty, Comp, HookTraits, HookGetter> {
+ private:
+    using super = detail::rbtree_base<Ty, Comp, HookTraits, HookGetter>;
+    using node_traits = typename super::node_traits;
+
+ public:
+    using key_compare = typename super::key_compare;
+    using iterator = typename super::iterator;
+    using const_iterator = typename super::const_iterator;
+    using owning_pointer_t = typename super::owning_pointer_t;
+
+    multiset() noexcept(std::is_nothrow_default_constructible<Comp>::value) : super() {}
+    explicit multiset(const key_compare& comp) : super(comp) {}
+
+    iterator insert(owning_pointer_t obj) {
+        auto result = rbtree_find_insert_pos<node_traits>(&this->head_, *obj, this->comp_);
+        return this->insert_at(std::move(obj), result.first, result.second);
+    }
+
+    iterator insert(const_iterator hint, owning_pointer_t obj) {
+        auto result = rbtree_find_insert_pos<node_traits>(&this->head_, this->to_node(hint), *obj, this->comp_);
+        return this->insert_at(std::move(obj), result.first, result.second);
+    }
+};
+
+}  // namespace intrusive
+}  // namespace uxs
@@ -0,0 +1,307 @@
+#pragma once
+
+#include "list.h"
+
+#include "uxs/rbtree.h"
+
+namespace uxs {
+namespace intrusive {
+
+struct rbtree_links_t : rbtree_node_t {
+#if UXS_ITERATOR_DEBUG_LEVEL != 0
+    rbtree_node_t* head;
+#endif  // UXS_ITERATOR_DEBUG_LEVEL != 0
+};
+
+namespace detail {
+
+template<typename Ty, typename HookTraits>
+struct rbtree_node_traits : hook_pointer_ops<HookTraits> {
+    using iterator_node_t = rbtree_node_t;
+    using hook_t = typename HookTraits::hook_t;
+    using owning_pointer_t = typename HookTraits::owning_pointer_t;
+    using hook_pointer_ops<HookTraits>::reset_pointer;
+    using hook_pointer_ops<HookTraits>::dispose;
+    static rbtree_node_t* get_next(rbtree_node_t* node) { return rbtree_next(node); }
+    static rbtree_node_t* get_prev(rbtree_node_t* node) { return rbtree_prev(node); }
+    static Ty& get_value(rbtree_node_t* node) { return HookTraits{}.get_value(static_cast<hook_t*>(node)); }
+    static const Ty& get_key(const Ty& v) { return v; }
+
+    template<typename Traits = rbtree_node_traits,
+             typename = std::enable_if_t<Traits::has_reset_pointer::value || Traits::has_dispose::value>>
+    static void dispose_all(rbtree_node_t* head) {
+        if (!rbtree_is_empty(head)) { dispose_recursive(head->left); }
+    }
+    static void dispose_recursive(rbtree_node_t* item) {
+        if (item->left) { dispose_recursive(item->left); }
+        if (item->right) { dispose_recursive(item->right); }
+        set_head(item, nullptr);
+        auto p = HookTraits{}.release_pointer(static_cast<hook_t*>(item));
+        reset_pointer(static_cast<hook_t*>(item), nullptr);
+        dispose(std::move(p));
+    }
+    template<typename... Dummy>
+    static void dispose_all(rbtree_node_t* head, Dummy&&...) {
+#if UXS_ITERATOR_DEBUG_LEVEL != 0
+        if (rbtree_is_empty(head)) { return; }
+        for (auto* item = head->parent; item != head; item = rbtree_next(item)) { set_head(item, nullptr); }
+#endif  // UXS_ITERATOR_DEBUG_LEVEL != 0
+    }
+
+#if UXS_ITERATOR_DEBUG_LEVEL != 0
+    static void set_head(rbtree_node_t* node, rbtree_node_t* head) { static_cast<rbtree_links_t*>(node)->head = head; }
+    static rbtree_node_t* get_head(rbtree_node_t* node) { return static_cast<rbtree_links_t*>(node)->head; }
+    static rbtree_node_t* get_front(rbtree_node_t* head) { return head->parent; }
+#else   // UXS_ITERATOR_DEBUG_LEVEL != 0
+    static void set_head(rbtree_node_t* node, rbtree_node_t* head) {}
+#endif  // UXS_ITERATOR_DEBUG_LEVEL != 0
+};
+
+//-----------------------------------------------------------------------------
+// Intrusive red-black tree: objects are linked by hooks they contain, no memory is allocated
+
+template<typename Ty, typename Comp, typename HookTraits, typename HookGetter>
+class rbtree_base {
+ protected:
+    using hook_t = typename HookTraits::hook_t;
+    using node_traits = rbtree_node_traits<Ty, HookTraits>;
+
+ public:
+    using value_type = Ty;
+    using key_type = std::remove_cv_t<Ty>;
+    using key_compare = Comp;
+    using value_compare = Comp;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+    using iterator = list_iterator<rbtree_base, node_traits, false>;
+    using const_iterator = list_iterator<rbtree_base, node_traits, true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using owning_pointer_t = typename HookTraits::owning_pointer_t;
+    using parent_object_t = std::remove_reference_t<decltype(*std::declval<owning_pointer_t>())>;
+
+    rbtree_base() noexcept(std::is_nothrow_default_constructible<Comp>::value) : comp_() { init_head(); }
+    explicit rbtree_base(const Comp& comp) : comp_(comp) { init_head(); }
+    ~rbtree_base() { node_traits::dispose_all(&head_); }
+
+    rbtree_base(const rbtree_base&) = delete;
+    rbtree_base& operator=(const rbtree_base&) = delete;
+
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+
+    key_compare key_comp() const { return comp_; }
+    value_compare value_comp() const { return comp_; }
+
+    iterator begin() noexcept { return iterator(head_.parent); }
+    const_iterator begin() const noexcept { return const_iterator(head_.parent); }
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator end() noexcept { return iterator(std::addressof(head_)); }
+    const_iterator end() const noexcept { return const_iterator(std::addressof(head_)); }
+    const_iterator cend() const noexcept { return end(); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    reference front() {
+        assert(size_);
+        return node_traits::get_value(head_.parent);
+    }
+    const_reference front() const {
+        assert(size_);
+        return node_traits::get_value(head_.parent);
+    }
+
+    reference back() {
+        assert(size_);
+        return node_traits::get_value(head_.right);
+    }
+    const_reference back() const {
+        assert(size_);
+        return node_traits::get_value(head_.right);
+    }
+
+    void clear() noexcept {
+        node_traits::dispose_all(&head_);
+        size_ = 0;
+        init_head();
+    }
+
+    iterator find(const key_type& key) { return iterator(find_impl(key)); }
+    const_iterator find(const key_type& key) const { return const_iterator(find_impl(key)); }
+
+    template<typename Key, typename Comp_ = key_compare>
+    est::type_identity_t<iterator, typename Comp_::is_transparent> find(const Key& key) {
+        return iterator(find_impl(key));
+    }
+
+    template<typename Key, typename Comp_ = key_compare>
+    est::type_identity_t<const_iterator, typename Comp_::is_transparent> find(const Key& key) const {
+        return const_iterator(find_impl(key));
+    }
+
+    iterator lower_bound(const key_type& key) { return iterator(rbtree_lower_bound<node_traits>(&head_, key, comp_)); }
+    const_iterator lower_bound(const key_type& key) const {
+        return const_iterator(rbtree_lower_bound<node_traits>(&head_, key, comp_));
+    }
+
+    template<typename Key, typename Comp_ = key_compare>
+    est::type_identity_t<iterator, typename Comp_::is_transparent> lower_bound(const Key& key) {
+        return iterator(rbtree_lower_bound<node_traits>(&head_, key, comp_));
+    }
+
+    template<typename Key, typename Comp_ = key_compare>
+    est::type_identity_t<const_iterator, typename Comp_::is_transparent> lower_bound(const Key& key) const {
+        return const_iterator(rbtree_lower_bound<node_traits>(&head_, key, comp_));
+    }
+
+    iterator upper_bound(const key_type& key) { return iterator(rbtree_upper_bound<node_traits>(&head_, key, comp_)); }
+    const_iterator upper_bound(const key_type& key) const {
+        return const_iterator(rbtree_upper_bound<node_traits>(&head_, key, comp_));
+    }
+
+    template<typename Key, typename Comp_ = key_compare>
+    est::type_identity_t<iterator, typename Comp_::is_transparent> upper_bound(const Key& key) {
+        return iterator(rbtree_upper_bound<node_traits>(&head_, key, comp_));
+    }
+
+    template<typename Key, typename Comp_ = key_compare>
+    est::type_identity_t<const_iterator, typename Comp_::is_transparent> upper_bound(const Key& key) const {
+        return const_iterator(rbtree_upper_bound<node_traits>(&head_, key, comp_));
+    }
+
+    std::pair<iterator, iterator> equal_range(const key_type& key) {
+        auto range = rbtree_equal_range<node_traits>(&head_, key, comp_);
+        return std::make_pair(iterator(range.first), iterator(range.second));
+    }
+    std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+        auto range = rbtree_equal_range<node_traits>(&head_, key, comp_);
+        return std::make_pair(const_iterator(range.first), const_iterator(range.second));
+    }
+
+    template<typename Key, typename Comp_ = key_compare>
+    est::type_identity_t<std::pair<iterator, iterator>, typename Comp_::is_transparent> equal_range(const Key& key) {
+        auto range = rbtree_equal_range<node_traits>(&head_, key, comp_);
+        return std::make_pair(iterator(range.first), iterator(range.second));
+    }
+
+    template<typename Key, typename Comp_ = key_compare>
+    est::type_identity_t<std::pair<const_iterator, const_iterator>, typename Comp_::is_transparent> equal_range(
+        const Key& key) const {
+        auto range = rbtree_equal_range<node_traits>(&head_, key, comp_);
+        return std::make_pair(const_iterator(range.first), const_iterator(range.second));
+    }
+
+    size_type count(const key_type& key) const { return count_impl(key); }
+
+    template<typename Key, typename Comp_ = key_compare>
+    est::type_identity_t<size_type, typename Comp_::is_transparent> count(const Key& key) const {
+        return count_impl(key);
+    }
+
+    bool contains(const key_type& key) const { return find_impl(key) != &head_; }
+
+    template<typename Key, typename Comp_ = key_compare>
+    est::type_identity_t<bool, typename Comp_::is_transparent> contains(const Key& key) const {
+        return find_impl(key) != &head_;
+    }
+
+    std::pair<owning_pointer_t, iterator> extract(const_iterator pos) {
+        auto* item = pos.node();
+        assert(item != &head_);
+        uxs_iterator_assert(node_traits::get_head(item) == &head_);
+        --size_;
+        auto* next = rbtree_remove(&head_, item);
+        node_traits::set_head(item, nullptr);
+        auto obj = node_traits::release_pointer(static_cast<hook_t*>(item));
+        node_traits::reset_pointer(static_cast<hook_t*>(item), nullptr);
+        return std::make_pair(std::move(obj), iterator(next));
+    }
+
+    iterator erase(const_iterator pos) {
+        auto result = extract(pos);
+        node_traits::dispose(std::move(result.first));
+        return result.second;
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        while (first != last) { first = erase(first); }
+        return iterator(last.node());
+    }
+
+    size_type erase(const key_type& key) { return erase_impl(key); }
+
+    template<typename Key, typename Comp_ = key_compare>
+    est::type_identity_t<size_type, typename Comp_::is_transparent> erase(const Key& key) { return erase_impl(key); }
+
+    static const_iterator to_iterator(const parent_object_t* obj) noexcept {
+        return const_iterator(get_hook(const_cast<parent_object_t*>(obj)));
+    }
+    static iterator to_iterator(parent_object_t* obj) noexcept { return iterator(get_hook(obj)); }
+
+ protected:
+    Comp comp_;
+    std::size_t size_ = 0;
+    mutable rbtree_links_t head_;
+
+    void init_head() noexcept {
+        rbtree_init_head(&head_);
+        node_traits::set_head(&head_, &head_);
+    }
+
+    template<typename Key>
+    rbtree_node_t* find_impl(const Key& key) const {
+        auto* node = rbtree_lower_bound<node_traits>(&head_, key, comp_);
+        return node != &head_ && !comp_(key, node_traits::get_value(node)) ? node : &head_;
+    }
+
+    template<typename Key>
+    size_type count_impl(const Key& key) const {
+        auto range = rbtree_equal_range<node_traits>(&head_, key, comp_);
+        size_type count = 0;
+        for (auto* node = range.first; node != range.second; node = rbtree_next(node)) { ++count; }
+        return count;
+    }
+
+    template<typename Key>
+    size_type erase_impl(const Key& key) {
+        auto range = rbtree_equal_range<node_traits>(&head_, key, comp_);
+        size_type count = 0;
+        for (auto* node = range.first; node != range.second; ++count) { node = erase(const_iterator(node)).node(); }
+        return count;
+    }
+
+    iterator insert_at(owning_pointer_t obj, rbtree_node_t* pos, int dir) {
+        auto* item = get_hook(std::addressof(*obj));
+        node_traits::reset_pointer(item, std::move(obj));
+        node_traits::set_head(item, &head_);
+        ++size_;
+        rbtree_insert(&head_, item, pos, dir);
+        return iterator(item);
+    }
+
+    rbtree_node_t* to_node(const_iterator it) const {
+        uxs_iterator_assert(node_traits::get_head(it.node()) == &head_);
+        return it.node();
+    }
+
+    template<typename ParentTy, typename HookGetter_ = HookGetter>
+    static auto get_hook(ParentTy* obj) -> decltype(HookGetter_{}.get_hook(obj)) { return HookGetter{}.get_hook(obj); }
+    template<typename ParentTy, typename... Dummy>
+    static hook_t* get_hook(ParentTy* obj, Dummy&&...) { return obj; }
+};
+
+}  // namespace detail
+
+}  // namespace intrusive
+}  // namespace uxs
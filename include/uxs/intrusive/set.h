@@ -0,0 +1,46 @@
+#pragma once
+
+#include "rbtree.h"
+
+namespace uxs {
+namespace intrusive {
+
+template<typename Ty, typename Comp = std::less<Ty>, typename HookTraits = list_hook_traits<Ty, rbtree_links_t>,
+         typename HookGetter = void>
+class set : public detail::rbtree_base<Ty, Comp, HookTraits, HookGetter> {
+ private:
+    using super = detail::rbtree_base<Ty, Comp, HookTraits, HookGetter>;
+    using node_traits = typename super::node_traits;
+
+ public:
+    using key_compare = typename super::key_compare;
+    using iterator = typename super::iterator;
+    using const_iterator = typename super::const_iterator;
+    using owning_pointer_t = typename super::owning_pointer_t;
+
+    set() noexcept(std::is_nothrow_default_constructible<Comp>::value) : super() {}
+    explicit set(const key_compare& comp) : super(comp) {}
+
+    // Returns the iterator to the inserted object or to already linked equivalent one. In the latter case
+    // the passed object is not linked, and its owning pointer is given back as the second member,
+    // otherwise the second member is empty
+    std::pair<iterator, owning_pointer_t> insert(owning_pointer_t obj) {
+        auto result = rbtree_find_insert_unique_pos<node_traits>(&this->head_, *obj, this->comp_);
+        if (result.second) {
+            return std::make_pair(this->insert_at(std::move(obj), result.first, result.second), owning_pointer_t{});
+        }
+        return std::make_pair(iterator(result.first), std::move(obj));
+    }
+
+    std::pair<iterator, owning_pointer_t> insert(const_iterator hint, owning_pointer_t obj) {
+        auto result = rbtree_find_insert_unique_pos<node_traits>(&this->head_, this->to_node(hint), *obj,
+                                                                 this->comp_);
+        if (result.second) {
+            return std::make_pair(this->insert_at(std::move(obj), result.first, result.second), owning_pointer_t{});
+        }
+        return std::make_pair(iterator(result.first), std::move(obj));
+    }
+};
+
+}  // namespace intrusive
+}  // namespace uxs
@@ -1,8 +1,8 @@
 #pragma once
 
 #include "rbtree_unique.h"
+#include "tree_front_end.h"
 
-#include <algorithm>
 #include <functional>
 
 namespace uxs {
@@ -15,186 +15,20 @@ class multimap;
 
 template<typename Key, typename Ty, typename Comp = std::less<Key>,
          typename Alloc = std::allocator<std::pair<const Key, Ty>>>
-class map : public detail::rbtree_unique<detail::map_node_traits<Key, Ty>, Alloc, Comp> {
+class map : public detail::map_front_end<map<Key, Ty, Comp, Alloc>,
+                                         detail::rbtree_unique<detail::map_node_traits<Key, Ty>, Alloc, Comp>> {
  private:
     using node_traits = detail::map_node_traits<Key, Ty>;
-    using super = detail::rbtree_unique<node_traits, Alloc, Comp>;
-    using alloc_traits = typename super::alloc_traits;
-    using alloc_type = typename super::alloc_type;
+    using super = detail::map_front_end<map, detail::rbtree_unique<node_traits, Alloc, Comp>>;
 
  public:
-    using allocator_type = typename super::allocator_type;
-    using key_type = typename super::key_type;
-    using mapped_type = typename node_traits::mapped_type;
-    using value_type = typename super::value_type;
-    using key_compare = typename super::key_compare;
-    using value_compare = typename super::value_compare_func;
-    using iterator = typename super::iterator;
-    using const_iterator = typename super::const_iterator;
+    using super::super;
+    using super::operator=;
 
-    map() noexcept(noexcept(super())) : super() {}
-    explicit map(const allocator_type& alloc) noexcept(noexcept(super(alloc))) : super(alloc) {}
-    explicit map(const key_compare& comp, const allocator_type& alloc = allocator_type()) : super(comp, alloc) {}
-
-#if __cplusplus < 201703L
-    ~map() = default;
-    map(const map&) = default;
-    map& operator=(const map&) = default;
-    map(map&& other) noexcept(noexcept(super(std::move(other)))) : super(std::move(other)) {}
-    map& operator=(map&& other) noexcept(std::is_nothrow_move_assignable<super>::value) {
-        super::operator=(std::move(other));
-        return *this;
-    }
-#endif  // __cplusplus < 201703L
-
-    map(std::initializer_list<value_type> l, const allocator_type& alloc) : super(alloc) {
-        try {
-            this->insert_impl(l.begin(), l.end());
-        } catch (...) {
-            this->tidy();
-            throw;
-        }
-    }
-
-    map(std::initializer_list<value_type> l, const key_compare& comp = key_compare(),
-        const allocator_type& alloc = allocator_type())
-        : super(comp, alloc) {
-        try {
-            this->insert_impl(l.begin(), l.end());
-        } catch (...) {
-            this->tidy();
-            throw;
-        }
-    }
-
-    map& operator=(std::initializer_list<value_type> l) {
-        this->assign_range(l.begin(), l.end());
-        return *this;
-    }
-
-    template<typename InputIt, typename = std::enable_if_t<is_input_iterator<InputIt>::value>>
-    map(InputIt first, InputIt last, const allocator_type& alloc) : super(alloc) {
-        try {
-            this->insert_impl(first, last);
-        } catch (...) {
-            this->tidy();
-            throw;
-        }
-    }
-
-    template<typename InputIt, typename = std::enable_if_t<is_input_iterator<InputIt>::value>>
-    map(InputIt first, InputIt last, const key_compare& comp = key_compare(),
-        const allocator_type& alloc = allocator_type())
-        : super(comp, alloc) {
-        try {
-            this->insert_impl(first, last);
-        } catch (...) {
-            this->tidy();
-            throw;
-        }
-    }
-
-    map(const map& other, const allocator_type& alloc) : super(other, alloc) {}
-    map(map&& other, const allocator_type& alloc) noexcept(noexcept(super(std::move(other), alloc)))
-        : super(std::move(other), alloc) {}
-
-    void swap(map& other) noexcept(std::is_nothrow_swappable<key_compare>::value) {
-        if (std::addressof(other) == this) { return; }
-        this->swap_impl(other, typename alloc_traits::propagate_on_container_swap());
-    }
-
-    value_compare value_comp() const { return value_compare(this->get_compare()); }
-
-    const mapped_type& at(const key_type& key) const {
-        auto it = this->find(key);
-        if (it != this->end()) { return it->second; }
-        throw std::out_of_range("invalid map key");
-    }
-
-    mapped_type& at(const key_type& key) {
-        auto it = this->find(key);
-        if (it != this->end()) { return it->second; }
-        throw std::out_of_range("invalid map key");
-    }
-
-    mapped_type& operator[](const key_type& key) { return this->try_emplace_impl(key).first->second; }
-    mapped_type& operator[](key_type&& key) { return this->try_emplace_impl(std::move(key)).first->second; }
-
-    template<typename... Args>
-    std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
-        return this->try_emplace_impl(key, std::forward<Args>(args)...);
-    }
-
-    template<typename... Args>
-    std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
-        return this->try_emplace_impl(std::move(key), std::forward<Args>(args)...);
-    }
-
-    template<typename Key2, typename Comp_ = key_compare, typename... Args>
-    est::type_identity_t<std::pair<iterator, bool>, typename Comp_::is_transparent> try_emplace(Key2&& key,
-                                                                                                Args&&... args) {
-        return this->try_emplace_impl(std::forward<Key2>(key), std::forward<Args>(args)...);
-    }
-
-    template<typename... Args>
-    iterator try_emplace(const_iterator hint, const key_type& key, Args&&... args) {
-        return this->try_emplace_hint_impl(hint, key, std::forward<Args>(args)...).first;
-    }
-
-    template<typename... Args>
-    iterator try_emplace(const_iterator hint, key_type&& key, Args&&... args) {
-        return this->try_emplace_hint_impl(hint, std::move(key), std::forward<Args>(args)...).first;
-    }
-
-    template<typename Key2, typename Comp_ = key_compare, typename... Args>
-    est::type_identity_t<iterator, typename Comp_::is_transparent> try_emplace_hint(const_iterator hint, Key2&& key,
-                                                                                    Args&&... args) {
-        return this->try_emplace_hint_impl(hint, std::forward<Key2>(key), std::forward<Args>(args)...).first;
-    }
-
-    template<typename Ty2>
-    std::pair<iterator, bool> insert_or_assign(const key_type& key, Ty2&& obj) {
-        auto result = this->try_emplace_impl(key, std::forward<Ty2>(obj));
-        if (!result.second) { result.first->second = std::forward<Ty2>(obj); }
-        return result;
-    }
-
-    template<typename Ty2>
-    std::pair<iterator, bool> insert_or_assign(key_type&& key, Ty2&& obj) {
-        auto result = this->try_emplace_impl(std::move(key), std::forward<Ty2>(obj));
-        if (!result.second) { result.first->second = std::forward<Ty2>(obj); }
-        return result;
-    }
-
-    template<typename Key2, typename Ty2, typename Comp_ = key_compare>
-    est::type_identity_t<std::pair<iterator, bool>, typename Comp_::is_transparent> insert_or_assign(Key2&& key,
-                                                                                                     Ty2&& obj) {
-        auto result = this->try_emplace_impl(std::forward<Key2>(key), std::forward<Ty2>(obj));
-        if (!result.second) { result.first->second = std::forward<Ty2>(obj); }
-        return result;
-    }
-
-    template<typename Ty2>
-    iterator insert_or_assign(const_iterator hint, const key_type& key, Ty2&& obj) {
-        auto result = this->try_emplace_hint_impl(hint, key, std::forward<Ty2>(obj));
-        if (!result.second) { result.first->second = std::forward<Ty2>(obj); }
-        return result.first;
-    }
-
-    template<typename Ty2>
-    iterator insert_or_assign(const_iterator hint, key_type&& key, Ty2&& obj) {
-        auto result = this->try_emplace_hint_impl(hint, std::move(key), std::forward<Ty2>(obj));
-        if (!result.second) { result.first->second = std::forward<Ty2>(obj); }
-        return result.first;
-    }
-
-    template<typename Key2, typename Ty2, typename Comp_ = key_compare>
-    est::type_identity_t<iterator, typename Comp_::is_transparent> insert_or_assign(const_iterator hint, Key2&& key,
-                                                                                    Ty2&& obj) {
-        auto result = this->try_emplace_hint_impl(hint, std::forward<Key2>(key), std::forward<Ty2>(obj));
-        if (!result.second) { result.first->second = std::forward<Ty2>(obj); }
-        return result.first;
-    }
+    // constructors from initializer list are redeclared to take part in class template argument deduction
+    map(std::initializer_list<std::pair<const Key, Ty>> l, const Alloc& alloc) : super(l, alloc) {}
+    map(std::initializer_list<std::pair<const Key, Ty>> l, const Comp& comp = Comp(), const Alloc& alloc = Alloc())
+        : super(l, comp, alloc) {}
 
     template<typename Comp2>
     void merge(map<Key, Ty, Comp2, Alloc>& other) {
@@ -233,34 +67,6 @@ map(std::initializer_list<std::pair<Key, Ty>>,
     Alloc) -> map<est::remove_const_t<Key>, Ty, std::less<est::remove_const_t<Key>>, Alloc>;
 #endif  // __cplusplus >= 201703L
 
-template<typename Key, typename Ty, typename Comp, typename Alloc>
-bool operator==(const map<Key, Ty, Comp, Alloc>& lhs, const map<Key, Ty, Comp, Alloc>& rhs) {
-    if (lhs.size() != rhs.size()) { return false; }
-    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
-}
-
-template<typename Key, typename Ty, typename Comp, typename Alloc>
-bool operator<(const map<Key, Ty, Comp, Alloc>& lhs, const map<Key, Ty, Comp, Alloc>& rhs) {
-    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
-}
-
-template<typename Key, typename Ty, typename Comp, typename Alloc>
-bool operator!=(const map<Key, Ty, Comp, Alloc>& lhs, const map<Key, Ty, Comp, Alloc>& rhs) {
-    return !(lhs == rhs);
-}
-template<typename Key, typename Ty, typename Comp, typename Alloc>
-bool operator<=(const map<Key, Ty, Comp, Alloc>& lhs, const map<Key, Ty, Comp, Alloc>& rhs) {
-    return !(rhs < lhs);
-}
-template<typename Key, typename Ty, typename Comp, typename Alloc>
-bool operator>(const map<Key, Ty, Comp, Alloc>& lhs, const map<Key, Ty, Comp, Alloc>& rhs) {
-    return rhs < lhs;
-}
-template<typename Key, typename Ty, typename Comp, typename Alloc>
-bool operator>=(const map<Key, Ty, Comp, Alloc>& lhs, const map<Key, Ty, Comp, Alloc>& rhs) {
-    return !(lhs < rhs);
-}
-
 }  // namespace uxs
 
 namespace std {
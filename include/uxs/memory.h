@@ -3,6 +3,7 @@
 #include "utility.h"
 
 #include <memory>
+#include <string>
 
 namespace uxs {
 
@@ -21,6 +22,20 @@ struct is_allocator<Alloc, std::void_t<typename Alloc::value_type, decltype(std:
     : std::true_type {};
 #endif  // __cplusplus < 201703L
 
+// An object of trivially relocatable type can be moved to another location with `memcpy`, and the old copy is
+// then just forgotten, without calling move constructor and destructor; specialize for user types if so
+template<typename Ty>
+struct is_trivially_relocatable : std::is_trivially_copyable<Ty> {};
+template<typename Ty, typename Deleter>
+struct is_trivially_relocatable<std::unique_ptr<Ty, Deleter>> : is_trivially_relocatable<Deleter> {};
+template<typename Ty>
+struct is_trivially_relocatable<std::shared_ptr<Ty>> : std::true_type {};
+#if defined(_LIBCPP_VERSION)
+// Note: libstdc++ string points into itself if it is short
+template<typename CharT, typename Traits, typename Alloc>
+struct is_trivially_relocatable<std::basic_string<CharT, Traits, Alloc>> : is_trivially_relocatable<Alloc> {};
+#endif  // defined(_LIBCPP_VERSION)
+
 template<typename ToTy, typename FromTy>
 std::unique_ptr<ToTy> static_pointer_cast(std::unique_ptr<FromTy> p) {
     return std::unique_ptr<ToTy>(static_cast<ToTy*>(p.release()));
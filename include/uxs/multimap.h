@@ -1,8 +1,8 @@
 #pragma once
 
 #include "rbtree_multi.h"
+#include "tree_front_end.h"
 
-#include <algorithm>
 #include <functional>
 
 namespace uxs {
@@ -15,94 +15,22 @@ class map;
 
 template<typename Key, typename Ty, typename Comp = std::less<Key>,
          typename Alloc = std::allocator<std::pair<const Key, Ty>>>
-class multimap : public detail::rbtree_multi<detail::map_node_traits<Key, Ty>, Alloc, Comp> {
+class multimap : public detail::tree_front_end<multimap<Key, Ty, Comp, Alloc>,
+                                               detail::rbtree_multi<detail::map_node_traits<Key, Ty>, Alloc, Comp>> {
  private:
     using node_traits = detail::map_node_traits<Key, Ty>;
-    using super = detail::rbtree_multi<node_traits, Alloc, Comp>;
-    using alloc_traits = typename super::alloc_traits;
-    using alloc_type = typename super::alloc_type;
+    using super = detail::tree_front_end<multimap, detail::rbtree_multi<node_traits, Alloc, Comp>>;
 
  public:
-    using allocator_type = typename super::allocator_type;
-    using mapped_type = typename node_traits::mapped_type;
-    using value_type = typename super::value_type;
-    using key_compare = typename super::key_compare;
-    using value_compare = typename super::value_compare_func;
-    using iterator = typename super::iterator;
-    using const_iterator = typename super::const_iterator;
+    using mapped_type = Ty;
 
-    multimap() noexcept(noexcept(super())) : super() {}
-    explicit multimap(const allocator_type& alloc) noexcept(noexcept(super(alloc))) : super(alloc) {}
-    explicit multimap(const key_compare& comp, const allocator_type& alloc = allocator_type()) : super(comp, alloc) {}
+    using super::super;
+    using super::operator=;
 
-#if __cplusplus < 201703L
-    ~multimap() = default;
-    multimap(const multimap&) = default;
-    multimap& operator=(const multimap&) = default;
-    multimap(multimap&& other) noexcept(noexcept(super(std::move(other)))) : super(std::move(other)) {}
-    multimap& operator=(multimap&& other) noexcept(std::is_nothrow_move_assignable<super>::value) {
-        super::operator=(std::move(other));
-        return *this;
-    }
-#endif  // __cplusplus < 201703L
-
-    multimap(std::initializer_list<value_type> l, const allocator_type& alloc) : super(alloc) {
-        try {
-            this->insert_impl(l.begin(), l.end());
-        } catch (...) {
-            this->tidy();
-            throw;
-        }
-    }
-
-    multimap(std::initializer_list<value_type> l, const key_compare& comp = key_compare(),
-             const allocator_type& alloc = allocator_type())
-        : super(comp, alloc) {
-        try {
-            this->insert_impl(l.begin(), l.end());
-        } catch (...) {
-            this->tidy();
-            throw;
-        }
-    }
-
-    multimap& operator=(std::initializer_list<value_type> l) {
-        this->assign_range(l.begin(), l.end());
-        return *this;
-    }
-
-    template<typename InputIt, typename = std::enable_if_t<is_input_iterator<InputIt>::value>>
-    multimap(InputIt first, InputIt last, const allocator_type& alloc) : super(alloc) {
-        try {
-            this->insert_impl(first, last);
-        } catch (...) {
-            this->tidy();
-            throw;
-        }
-    }
-
-    template<typename InputIt, typename = std::enable_if_t<is_input_iterator<InputIt>::value>>
-    multimap(InputIt first, InputIt last, const key_compare& comp = key_compare(),
-             const allocator_type& alloc = allocator_type())
-        : super(comp, alloc) {
-        try {
-            this->insert_impl(first, last);
-        } catch (...) {
-            this->tidy();
-            throw;
-        }
-    }
-
-    multimap(const multimap& other, const allocator_type& alloc) : super(other, alloc) {}
-    multimap(multimap&& other, const allocator_type& alloc) noexcept(noexcept(super(std::move(other), alloc)))
-        : super(std::move(other), alloc) {}
-
-    void swap(multimap& other) noexcept(std::is_nothrow_swappable<key_compare>::value) {
-        if (std::addressof(other) == this) { return; }
-        this->swap_impl(other, typename alloc_traits::propagate_on_container_swap());
-    }
-
-    value_compare value_comp() const { return value_compare(this->get_compare()); }
+    // constructors from initializer list are redeclared to take part in class template argument deduction
+    multimap(std::initializer_list<std::pair<const Key, Ty>> l, const Alloc& alloc) : super(l, alloc) {}
+    multimap(std::initializer_list<std::pair<const Key, Ty>> l, const Comp& comp = Comp(), const Alloc& alloc = Alloc())
+        : super(l, comp, alloc) {}
 
     template<typename Comp2>
     void merge(map<Key, Ty, Comp2, Alloc>& other) {
@@ -141,34 +69,6 @@ multimap(std::initializer_list<std::pair<Key, Ty>>,
          Alloc) -> multimap<est::remove_const_t<Key>, Ty, std::less<est::remove_const_t<Key>>, Alloc>;
 #endif  // __cplusplus >= 201703L
 
-template<typename Key, typename Ty, typename Comp, typename Alloc>
-bool operator==(const multimap<Key, Ty, Comp, Alloc>& lhs, const multimap<Key, Ty, Comp, Alloc>& rhs) {
-    if (lhs.size() != rhs.size()) { return false; }
-    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
-}
-
-template<typename Key, typename Ty, typename Comp, typename Alloc>
-bool operator<(const multimap<Key, Ty, Comp, Alloc>& lhs, const multimap<Key, Ty, Comp, Alloc>& rhs) {
-    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
-}
-
-template<typename Key, typename Ty, typename Comp, typename Alloc>
-bool operator!=(const multimap<Key, Ty, Comp, Alloc>& lhs, const multimap<Key, Ty, Comp, Alloc>& rhs) {
-    return !(lhs == rhs);
-}
-template<typename Key, typename Ty, typename Comp, typename Alloc>
-bool operator<=(const multimap<Key, Ty, Comp, Alloc>& lhs, const multimap<Key, Ty, Comp, Alloc>& rhs) {
-    return !(rhs < lhs);
-}
-template<typename Key, typename Ty, typename Comp, typename Alloc>
-bool operator>(const multimap<Key, Ty, Comp, Alloc>& lhs, const multimap<Key, Ty, Comp, Alloc>& rhs) {
-    return rhs < lhs;
-}
-template<typename Key, typename Ty, typename Comp, typename Alloc>
-bool operator>=(const multimap<Key, Ty, Comp, Alloc>& lhs, const multimap<Key, Ty, Comp, Alloc>& rhs) {
-    return !(lhs < rhs);
-}
-
 }  // namespace uxs
 
 namespace std {
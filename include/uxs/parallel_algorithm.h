@@ -0,0 +1,249 @@
+#pragma once
+
+#include "algorithm.h"
+#include "iterator.h"
+#include "thread_pool.h"
+
+#include <functional>
+#include <vector>
+
+namespace uxs {
+
+// Parallel algorithms for random access ranges; they run on `thread_pool::instance()`. The range is split
+// into chunks of `grain` elements, and if `grain` is zero it is chosen so that each thread gets several chunks.
+// Functions, predicates and comparators are called concurrently from different threads.
+// Ranges of `zip_iterator`s are supported: elements referenced by proxy tuples are swapped by values
+
+namespace detail {
+inline std::size_t get_parallel_grain(std::size_t count, std::size_t grain) {
+    if (grain) { return grain; }
+    const std::size_t chunk_count = 4 * static_cast<std::size_t>(thread_pool::instance().concurrency());
+    return std::max<std::size_t>((count + chunk_count - 1) / chunk_count, 1);
+}
+
+template<typename Iter>
+Iter advance_by_index(Iter it, std::size_t i) {
+    return it + static_cast<typename std::iterator_traits<Iter>::difference_type>(i);
+}
+
+template<typename Iter>
+std::enable_if_t<std::is_reference<typename std::iterator_traits<Iter>::reference>::value> swap_values(Iter a,
+                                                                                                        Iter b) {
+    std::iter_swap(a, b);
+}
+template<typename Iter>
+std::enable_if_t<!std::is_reference<typename std::iterator_traits<Iter>::reference>::value> swap_values(Iter a,
+                                                                                                         Iter b) {
+    typename std::iterator_traits<Iter>::value_type tmp(std::move(*a));
+    *a = std::move(*b);
+    *b = std::move(tmp);
+}
+
+template<typename Iter, typename Pred>
+Iter partition_values(Iter first, Iter last, Pred pred) {
+    while (true) {
+        while (first != last && pred(*first)) { ++first; }
+        do {
+            if (first == last) { return first; }
+        } while (!pred(*--last));
+        swap_values(first++, last);
+    }
+}
+
+template<typename SrcIter, typename DstIter, typename Comp>
+void parallel_merge_pass(SrcIter src, DstIter dst, std::size_t count, std::size_t width, Comp comp) {
+    // each merge is split into parts by the elements of the first run, so the parts are merged independently;
+    // split positions are found before merging, because merged elements are moved out
+    const std::size_t pair_count = (count + 2 * width - 1) / (2 * width);
+    const std::size_t part_count = std::max<std::size_t>(
+        4 * static_cast<std::size_t>(thread_pool::instance().concurrency()) / pair_count, 1);
+    std::vector<std::size_t> splits(pair_count * part_count);
+    auto a_split = [count, width, part_count](std::size_t task) {
+        const std::size_t lo = (task / part_count) * 2 * width, mid = std::min(lo + width, count);
+        return lo + (mid - lo) * (task % part_count) / part_count;
+    };
+    thread_pool::instance().for_each_range(splits.size(), 1, [&](std::size_t task, std::size_t task_end) {
+        for (; task != task_end; ++task) {
+            const std::size_t lo = (task / part_count) * 2 * width;
+            const auto b_first = advance_by_index(src, std::min(lo + width, count));
+            const auto b_last = advance_by_index(src, std::min(lo + 2 * width, count));
+            splits[task] = task % part_count == 0 ?
+                               0 :
+                               static_cast<std::size_t>(
+                                   std::lower_bound(b_first, b_last, *advance_by_index(src, a_split(task)), comp) -
+                                   b_first);
+        }
+    });
+    thread_pool::instance().for_each_range(splits.size(), 1, [&](std::size_t task, std::size_t task_end) {
+        for (; task != task_end; ++task) {
+            const std::size_t lo = (task / part_count) * 2 * width;
+            const std::size_t mid = std::min(lo + width, count), hi = std::min(lo + 2 * width, count);
+            const std::size_t a_first = a_split(task), b_first = mid + splits[task];
+            std::size_t a_last = mid, b_last = hi;
+            if (task % part_count != part_count - 1) { a_last = a_split(task + 1), b_last = mid + splits[task + 1]; }
+            std::merge(std::make_move_iterator(advance_by_index(src, a_first)),
+                       std::make_move_iterator(advance_by_index(src, a_last)),
+                       std::make_move_iterator(advance_by_index(src, b_first)),
+                       std::make_move_iterator(advance_by_index(src, b_last)),
+                       advance_by_index(dst, a_first + b_first - mid), comp);
+        }
+    });
+}
+
+template<typename Iter, typename Comp>
+void parallel_sort_impl(Iter first, std::size_t count, Comp comp, std::size_t grain, std::true_type) {
+    using value_type = typename std::iterator_traits<Iter>::value_type;
+    const std::size_t block_count = (count + grain - 1) / grain;
+    thread_pool::instance().for_each_range(block_count, 1, [&](std::size_t block, std::size_t block_end) {
+        for (; block != block_end; ++block) {
+            std::sort(advance_by_index(first, block * grain),
+                      advance_by_index(first, std::min((block + 1) * grain, count)), comp);
+        }
+    });
+    if (block_count == 1) { return; }
+    // sorted runs are merged pairwise, alternating between the range and the buffer
+    std::vector<value_type> buf(std::make_move_iterator(first),
+                                std::make_move_iterator(advance_by_index(first, count)));
+    bool in_buf = true;
+    for (std::size_t width = grain; width < count; width *= 2, in_buf = !in_buf) {
+        if (in_buf) {
+            parallel_merge_pass(buf.begin(), first, count, width, comp);
+        } else {
+            parallel_merge_pass(first, buf.begin(), count, width, comp);
+        }
+    }
+    if (!in_buf) { return; }
+    thread_pool::instance().for_each_range(count, get_parallel_grain(count, 0), [&](std::size_t i, std::size_t i_end) {
+        std::move(buf.begin() + i, buf.begin() + i_end, advance_by_index(first, i));
+    });
+}
+
+template<typename Iter, typename Comp>
+void parallel_sort_impl(Iter first, std::size_t count, Comp comp, std::size_t grain, std::false_type) {
+    // elements referenced by proxies are sorted as values and moved back
+    using value_type = typename std::iterator_traits<Iter>::value_type;
+    std::vector<value_type> values(first, advance_by_index(first, count));
+    parallel_sort_impl(values.begin(), count, comp, grain, std::true_type{});
+    thread_pool::instance().for_each_range(count, get_parallel_grain(count, 0), [&](std::size_t i, std::size_t i_end) {
+        std::move(values.begin() + i, values.begin() + i_end, advance_by_index(first, i));
+    });
+}
+}  // namespace detail
+
+template<typename Range, typename Func>
+void parallel_for_each(Range&& r, Func func, std::size_t grain = 0) {
+    auto first = std::begin(r);
+    static_assert(is_random_access_iterator<decltype(first)>::value, "random access range is required");
+    const std::size_t count = static_cast<std::size_t>(std::end(r) - first);
+    thread_pool::instance().for_each_range(count, detail::get_parallel_grain(count, grain),
+                                           [first, &func](std::size_t i, std::size_t i_end) {
+                                               auto it = detail::advance_by_index(first, i);
+                                               for (; i != i_end; ++i, ++it) { func(*it); }
+                                           });
+}
+
+template<typename Range, typename OutputIt, typename TransfFunc>
+OutputIt parallel_transform(const Range& r, OutputIt out, TransfFunc func, std::size_t grain = 0) {
+    auto first = std::begin(r);
+    static_assert(is_random_access_iterator<decltype(first)>::value, "random access range is required");
+    static_assert(is_random_access_iterator<OutputIt>::value, "random access output iterator is required");
+    const std::size_t count = static_cast<std::size_t>(std::end(r) - first);
+    thread_pool::instance().for_each_range(count, detail::get_parallel_grain(count, grain),
+                                           [first, out, &func](std::size_t i, std::size_t i_end) {
+                                               auto it = detail::advance_by_index(first, i);
+                                               auto it_out = detail::advance_by_index(out, i);
+                                               for (; i != i_end; ++i, ++it, ++it_out) { *it_out = func(*it); }
+                                           });
+    return detail::advance_by_index(out, count);
+}
+
+// Chunks are reduced independently and then partial results are combined in order,
+// so the operation must be associative, but it can be not commutative
+template<typename Range, typename Ty, typename BinaryOp = plus<>>
+Ty parallel_reduce(const Range& r, Ty init, BinaryOp op = BinaryOp{}, std::size_t grain = 0) {
+    auto first = std::begin(r);
+    static_assert(is_random_access_iterator<decltype(first)>::value, "random access range is required");
+    const std::size_t count = static_cast<std::size_t>(std::end(r) - first);
+    grain = detail::get_parallel_grain(count, grain);
+    const std::size_t block_count = (count + grain - 1) / grain;
+    std::vector<Ty> partial;
+    partial.reserve(block_count);
+    for (std::size_t block = 0; block < block_count; ++block) {
+        partial.emplace_back(*detail::advance_by_index(first, block * grain));
+    }
+    thread_pool::instance().for_each_range(block_count, 1, [&](std::size_t block, std::size_t block_end) {
+        for (; block != block_end; ++block) {
+            auto it = detail::advance_by_index(first, block * grain + 1);
+            auto it_end = detail::advance_by_index(first, std::min((block + 1) * grain, count));
+            for (; it != it_end; ++it) { partial[block] = op(std::move(partial[block]), *it); }
+        }
+    });
+    for (auto& v : partial) { init = op(std::move(init), std::move(v)); }
+    return init;
+}
+
+// Chunks are sorted and then merged pairwise; an additional buffer for all elements is used
+template<typename Range, typename Comp = less<>>
+void parallel_sort(Range&& r, Comp comp = Comp{}, std::size_t grain = 0) {
+    auto first = std::begin(r);
+    using iterator = decltype(first);
+    static_assert(is_random_access_iterator<iterator>::value, "random access range is required");
+    const std::size_t count = static_cast<std::size_t>(std::end(r) - first);
+    if (count < 2) { return; }
+    detail::parallel_sort_impl(first, count, comp, detail::get_parallel_grain(count, grain),
+                               std::is_reference<typename std::iterator_traits<iterator>::reference>{});
+}
+
+// Chunks are partitioned, and then misplaced elements of the chunks are swapped; the order of elements
+// is not preserved. Returns the iterator to the first element of the second group
+template<typename Range, typename Pred>
+auto parallel_partition(Range&& r, Pred pred, std::size_t grain = 0) -> decltype(std::begin(r)) {
+    auto first = std::begin(r);
+    static_assert(is_random_access_iterator<decltype(first)>::value, "random access range is required");
+    const std::size_t count = static_cast<std::size_t>(std::end(r) - first);
+    grain = detail::get_parallel_grain(count, grain);
+    const std::size_t block_count = (count + grain - 1) / grain;
+    std::vector<std::size_t> true_counts(block_count);
+    thread_pool::instance().for_each_range(block_count, 1, [&](std::size_t block, std::size_t block_end) {
+        for (; block != block_end; ++block) {
+            const auto block_first = detail::advance_by_index(first, block * grain);
+            const auto block_last = detail::advance_by_index(first, std::min((block + 1) * grain, count));
+            true_counts[block] = static_cast<std::size_t>(detail::partition_values(block_first, block_last, pred) -
+                                                          block_first);
+        }
+    });
+    std::size_t total_true_count = 0;
+    for (const std::size_t n : true_counts) { total_true_count += n; }
+    // collect misplaced false elements before the partition point and true elements after it
+    std::vector<std::pair<std::size_t, std::size_t>> false_ranges, true_ranges;
+    std::vector<std::size_t> false_offsets{0}, true_offsets{0};
+    for (std::size_t block = 0; block < block_count; ++block) {
+        const std::size_t lo = block * grain, mid = lo + true_counts[block], hi = std::min(lo + grain, count);
+        if (mid < total_true_count && mid != hi) {
+            false_ranges.emplace_back(mid, std::min(hi, total_true_count));
+            false_offsets.push_back(false_offsets.back() + false_ranges.back().second - mid);
+        }
+        if (mid > total_true_count && lo != mid) {
+            true_ranges.emplace_back(std::max(lo, total_true_count), mid);
+            true_offsets.push_back(true_offsets.back() + mid - true_ranges.back().first);
+        }
+    }
+    const std::size_t misplaced_count = false_offsets.back();
+    thread_pool::instance().for_each_range(
+        misplaced_count, detail::get_parallel_grain(misplaced_count, 0), [&](std::size_t k, std::size_t k_end) {
+            std::size_t i = static_cast<std::size_t>(
+                std::upper_bound(false_offsets.begin(), false_offsets.end(), k) - false_offsets.begin() - 1);
+            std::size_t j = static_cast<std::size_t>(
+                std::upper_bound(true_offsets.begin(), true_offsets.end(), k) - true_offsets.begin() - 1);
+            std::size_t pos_f = false_ranges[i].first + k - false_offsets[i];
+            std::size_t pos_t = true_ranges[j].first + k - true_offsets[j];
+            for (; k != k_end; ++k) {
+                if (pos_f == false_ranges[i].second) { pos_f = false_ranges[++i].first; }
+                if (pos_t == true_ranges[j].second) { pos_t = true_ranges[++j].first; }
+                detail::swap_values(detail::advance_by_index(first, pos_f++), detail::advance_by_index(first, pos_t++));
+            }
+        });
+    return detail::advance_by_index(first, total_true_count);
+}
+
+}  // namespace uxs
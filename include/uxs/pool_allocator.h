@@ -5,9 +5,26 @@
 
 #include <cassert>
 #include <memory>
+#include <vector>
 
 namespace uxs {
 
+// Snapshot of pool nodes of the same size and alignment
+struct pool_stats_t {
+    std::uint32_t node_size;
+    std::uint32_t node_alignment;
+    std::uint32_t node_count_per_partition;
+    std::size_t partition_count;
+    std::size_t free_count;  // length of the free list
+    std::size_t live_count;  // allocated nodes
+    // counters are collected only if `UXS_USE_POOL_STATS` is defined
+    std::size_t alloc_count;
+    std::size_t dealloc_count;
+    std::size_t partition_alloc_count;
+    std::size_t partition_dealloc_count;
+    std::size_t peak_live_count;
+};
+
 namespace detail {
 template<typename Pool, std::uint16_t Size, std::uint16_t Alignment>
 struct pool_specializer;
@@ -16,6 +33,17 @@ struct pool_part_hdr_t : dllist_node_t {
     std::uint32_t use_count;
 };
 
+#if defined(UXS_USE_POOL_STATS)
+struct pool_counters_t {
+    std::size_t alloc_count;
+    std::size_t dealloc_count;
+    std::size_t partition_alloc_count;
+    std::size_t partition_dealloc_count;
+    std::size_t live_count;
+    std::size_t peak_live_count;
+};
+#endif  // defined(UXS_USE_POOL_STATS)
+
 template<typename Alloc>
 class pool {
  public:
@@ -36,10 +64,16 @@ class pool {
         std::uint32_t ref_count;
         std::uint32_t node_count_per_partition;
         std::uint32_t partition_size;
+        std::uint32_t empty_partition_count;
+        std::uint32_t trim_threshold;
+#if defined(UXS_USE_POOL_STATS)
+        pool_counters_t counters;
+#endif  // defined(UXS_USE_POOL_STATS)
 
         void (*tidy_pool)(pool_desc_t*);
         void* (*allocate_new)(pool_desc_t*);
         void (*deallocate_partition)(pool_desc_t*, pool_part_hdr_t*);
+        void (*collect_stats)(const pool_desc_t*, pool_stats_t&);
     };
 
     pool() : desc_(allocate_dummy_pool(alloc_type(), def_partition_size)) {}
@@ -76,22 +110,46 @@ class pool {
     static void* allocate(pool_desc_t* desc) {
         dllist_node_t* node = desc->free.next;
         if (node != &desc->free) {
-            inc_use_count(node);
+            if (inc_use_count(node) == 1) { --desc->empty_partition_count; }
             dllist_remove(node);
+            count_alloc(desc);
             return node;
         }
-        return desc->allocate_new(desc);
+        void* new_node = desc->allocate_new(desc);
+        count_alloc(desc);
+        return new_node;
     }
 
     static void deallocate(pool_desc_t* desc, void* node) {
+        count_dealloc(desc);
+        const std::size_t use_count = dec_use_count(node);
+        // nodes of sparse partitions are reused last, so such partitions have a chance to become empty
+        if (2 * use_count >= desc->node_count_per_partition) {
+            dllist_insert_after(&desc->free, static_cast<dllist_node_t*>(node));
+            return;
+        }
         dllist_insert_before(&desc->free, static_cast<dllist_node_t*>(node));
-        if (dec_use_count(node) == 0) { desc->deallocate_partition(desc, header(node)); }
+        if (use_count != 0) { return; }
+        if (desc->empty_partition_count < desc->root_pool->trim_threshold) {
+            ++desc->empty_partition_count;  // keep the partition until `trim()`
+        } else {
+            desc->deallocate_partition(desc, header(node));
+        }
     }
 
+    // Empty partitions are returned to the upstream allocator immediately, unless the threshold is set:
+    // then up to `count` empty partitions are kept for each node size until `trim()` is called
+    void set_trim_threshold(std::uint32_t count) { desc_->root_pool->trim_threshold = count; }
+    UXS_EXPORT void trim();
+
     pool_desc_t* desc() { return desc_; }
     void swap(pool& other) noexcept { std::swap(desc_, other.desc_); }
     bool is_equal_to(const pool& other) const { return desc_->root_pool == other.desc_->root_pool; }
 
+    // Collects statistics for all node sizes served by this pool; the pool isn't modified,
+    // but free lists and partition lists are traversed, so the call isn't cheap
+    UXS_EXPORT std::vector<pool_stats_t> stats() const;
+
     void reset(pool_desc_t* desc) {
         if (desc) { ++desc->root_pool->ref_count; }
         if (desc_ && !--desc_->root_pool->ref_count) { tidy(desc_); }
@@ -110,9 +168,26 @@ class pool {
 
     static void set_header(void* node, pool_part_hdr_t* hdr) { *(static_cast<pool_part_hdr_t**>(node) - 1) = hdr; }
 
-    static void inc_use_count(void* node) { ++header(node)->use_count; }
+    static std::size_t inc_use_count(void* node) { return ++header(node)->use_count; }
     static std::size_t dec_use_count(void* node) { return --header(node)->use_count; }
 
+#if defined(UXS_USE_POOL_STATS)
+    static void count_alloc(pool_desc_t* desc) {
+        if (++desc->counters.live_count > desc->counters.peak_live_count) {
+            desc->counters.peak_live_count = desc->counters.live_count;
+        }
+        ++desc->counters.alloc_count;
+    }
+    static void count_dealloc(pool_desc_t* desc) { --desc->counters.live_count, ++desc->counters.dealloc_count; }
+    static void count_partition_alloc(pool_desc_t* desc) { ++desc->counters.partition_alloc_count; }
+    static void count_partition_dealloc(pool_desc_t* desc) { ++desc->counters.partition_dealloc_count; }
+#else   // defined(UXS_USE_POOL_STATS)
+    static void count_alloc(pool_desc_t* desc) {}
+    static void count_dealloc(pool_desc_t* desc) {}
+    static void count_partition_alloc(pool_desc_t* desc) {}
+    static void count_partition_dealloc(pool_desc_t* desc) {}
+#endif  // defined(UXS_USE_POOL_STATS)
+
     UXS_EXPORT static void tidy(pool_desc_t* desc);
     UXS_EXPORT static pool_desc_t* find_pool(pool_desc_t* desc, std::uint32_t size_and_alignment);
     UXS_EXPORT static pool_desc_t* allocate_new_pool(alloc_type al);
@@ -138,6 +213,7 @@ struct pool_specializer {
     static void* allocate_new(pool_desc_t* desc);
     static void* allocate_new_partition(pool_desc_t* desc);
     static void deallocate_partition(pool_desc_t* desc, pool_part_hdr_t* part_hdr);
+    static void collect_stats(const pool_desc_t* desc, pool_stats_t& stats);
 
     static pool_desc_t* global_pool_desc() {
         static pool_desc_t* desc = nullptr;
@@ -169,6 +245,7 @@ template<typename Pool, std::uint16_t Size, std::uint16_t Alignment>
     desc->tidy_pool = tidy_pool;
     desc->allocate_new = allocate_new_partition;
     desc->deallocate_partition = deallocate_partition;
+    desc->collect_stats = collect_stats;
     return desc;
 }
 
@@ -198,6 +275,7 @@ template<typename Pool, std::uint16_t Size, std::uint16_t Alignment>
 template<typename Pool, std::uint16_t Size, std::uint16_t Alignment>
 /*static*/ void* pool_specializer<Pool, Size, Alignment>::allocate_new_partition(pool_desc_t* desc) {
     record_t* part = alloc_type(*desc).allocate(desc->node_count_per_partition);
+    Pool::count_partition_alloc(desc);
     void* node = part + desc->node_count_per_partition - 1;
     pool_part_hdr_t* hdr = reinterpret_cast<pool_part_hdr_t*>(part);
     hdr->use_count = desc->node_count_per_partition - 1;
@@ -221,6 +299,25 @@ template<typename Pool, std::uint16_t Size, std::uint16_t Alignment>
         desc->allocate_new = allocate_new_partition;
     }
     alloc_type(*desc).deallocate(part, desc->node_count_per_partition);
+    Pool::count_partition_dealloc(desc);
+}
+
+template<typename Pool, std::uint16_t Size, std::uint16_t Alignment>
+/*static*/ void pool_specializer<Pool, Size, Alignment>::collect_stats(const pool_desc_t* desc, pool_stats_t& stats) {
+    stats.node_size = Size;
+    stats.node_alignment = Alignment;
+    stats.node_count_per_partition = desc->node_count_per_partition - 1;
+    stats.partition_count = 0, stats.live_count = 0, stats.free_count = 0;
+    for (const dllist_node_t* p = desc->partitions.next; p != &desc->partitions; p = p->next) {
+        ++stats.partition_count;
+        stats.live_count += static_cast<const pool_part_hdr_t*>(p)->use_count;
+    }
+    for (const dllist_node_t* p = desc->free.next; p != &desc->free; p = p->next) { ++stats.free_count; }
+    // not yet used nodes of the newest partition are counted in its `use_count`
+    if (desc->allocate_new == allocate_new) {
+        stats.live_count -= static_cast<const record_t*>(desc->new_node) -
+                            reinterpret_cast<const record_t*>(Pool::header(desc->new_node));
+    }
 }
 
 }  // namespace detail
@@ -275,6 +372,10 @@ class pool_allocator {
         return pool_.is_equal_to(other.pool_);
     }
 
+    std::vector<pool_stats_t> stats() const { return pool_.stats(); }
+    void set_trim_threshold(std::uint32_t count) { pool_.set_trim_threshold(count); }
+    void trim() { pool_.trim(); }
+
  private:
     template<typename, typename>
     friend class pool_allocator;
@@ -328,6 +429,10 @@ class global_pool_allocator {
             base_allocator().deallocate(p, sz);
         }
     }
+
+    static std::vector<pool_stats_t> stats() { return detail::g_global_pool.stats(); }
+    static void set_trim_threshold(std::uint32_t count) { detail::g_global_pool.set_trim_threshold(count); }
+    static void trim() { detail::g_global_pool.trim(); }
 };
 
 template<typename TyL, typename TyR>
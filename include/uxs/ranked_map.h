@@ -0,0 +1,81 @@
+#pragma once
+
+#include "rbtree_ranked.h"
+#include "tree_front_end.h"
+
+#include <functional>
+
+namespace uxs {
+
+//-----------------------------------------------------------------------------
+// Ranked map front-end
+
+template<typename Key, typename Ty, typename Comp, typename Alloc>
+class ranked_multimap;
+
+template<typename Key, typename Ty, typename Comp = std::less<Key>,
+         typename Alloc = std::allocator<std::pair<const Key, Ty>>>
+class ranked_map
+    : public detail::map_front_end<ranked_map<Key, Ty, Comp, Alloc>,
+                                   detail::rbtree_ranked_unique<detail::ranked_map_node_traits<Key, Ty>, Alloc, Comp>> {
+ private:
+    using node_traits = detail::ranked_map_node_traits<Key, Ty>;
+    using super = detail::map_front_end<ranked_map, detail::rbtree_ranked_unique<node_traits, Alloc, Comp>>;
+
+ public:
+    using super::super;
+    using super::operator=;
+
+    // constructors from initializer list are redeclared to take part in class template argument deduction
+    ranked_map(std::initializer_list<std::pair<const Key, Ty>> l, const Alloc& alloc) : super(l, alloc) {}
+    ranked_map(std::initializer_list<std::pair<const Key, Ty>> l, const Comp& comp = Comp(),
+               const Alloc& alloc = Alloc())
+        : super(l, comp, alloc) {}
+
+    template<typename Comp2>
+    void merge(ranked_map<Key, Ty, Comp2, Alloc>& other) {
+        this->merge_impl(std::move(other));
+    }
+    template<typename Comp2>
+    void merge(ranked_map<Key, Ty, Comp2, Alloc>&& other) {
+        this->merge_impl(std::move(other));
+    }
+    template<typename Comp2>
+    void merge(ranked_multimap<Key, Ty, Comp2, Alloc>& other) {
+        this->merge_impl(std::move(other));
+    }
+    template<typename Comp2>
+    void merge(ranked_multimap<Key, Ty, Comp2, Alloc>&& other) {
+        this->merge_impl(std::move(other));
+    }
+};
+
+#if __cplusplus >= 201703L
+template<typename InputIt, typename Comp = std::less<detail::iter_key_t<InputIt>>,
+         typename Alloc = std::allocator<detail::iter_to_alloc_t<InputIt>>,
+         typename = std::enable_if_t<!is_allocator<Comp>::value>, typename = std::enable_if_t<is_allocator<Alloc>::value>>
+ranked_map(InputIt, InputIt, Comp = Comp(),
+    Alloc = Alloc()) -> ranked_map<detail::iter_key_t<InputIt>, detail::iter_val_t<InputIt>, Comp, Alloc>;
+template<typename Key, typename Ty, typename Comp = std::less<est::remove_const_t<Key>>,
+         typename Alloc = std::allocator<std::pair<const Key, Ty>>,
+         typename = std::enable_if_t<!is_allocator<Comp>::value>, typename = std::enable_if_t<is_allocator<Alloc>::value>>
+ranked_map(std::initializer_list<std::pair<Key, Ty>>, Comp = Comp(),
+    Alloc = Alloc()) -> ranked_map<est::remove_const_t<Key>, Ty, Comp, Alloc>;
+template<typename InputIt, typename Alloc, typename = std::enable_if_t<is_allocator<Alloc>::value>>
+ranked_map(InputIt, InputIt, Alloc)
+    -> ranked_map<detail::iter_key_t<InputIt>, detail::iter_val_t<InputIt>, std::less<detail::iter_key_t<InputIt>>,
+                  Alloc>;
+template<typename Key, typename Ty, typename Alloc, typename = std::enable_if_t<is_allocator<Alloc>::value>>
+ranked_map(std::initializer_list<std::pair<Key, Ty>>,
+    Alloc) -> ranked_map<est::remove_const_t<Key>, Ty, std::less<est::remove_const_t<Key>>, Alloc>;
+#endif  // __cplusplus >= 201703L
+
+}  // namespace uxs
+
+namespace std {
+template<typename Key, typename Ty, typename Comp, typename Alloc>
+void swap(uxs::ranked_map<Key, Ty, Comp, Alloc>& m1,
+          uxs::ranked_map<Key, Ty, Comp, Alloc>& m2) noexcept(noexcept(m1.swap(m2))) {
+    m1.swap(m2);
+}
+}  // namespace std
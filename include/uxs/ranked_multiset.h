@@ -0,0 +1,76 @@
+#pragma once
+
+#include "rbtree_ranked.h"
+#include "tree_front_end.h"
+
+#include <functional>
+
+namespace uxs {
+
+//-----------------------------------------------------------------------------
+// Ranked multiset front-end
+
+template<typename Key, typename Comp, typename Alloc>
+class ranked_set;
+
+template<typename Key, typename Comp = std::less<Key>, typename Alloc = std::allocator<Key>>
+class ranked_multiset
+    : public detail::tree_front_end<ranked_multiset<Key, Comp, Alloc>,
+                                    detail::rbtree_ranked_multi<detail::ranked_set_node_traits<Key>, Alloc, Comp>> {
+ private:
+    using node_traits = detail::ranked_set_node_traits<Key>;
+    using super = detail::tree_front_end<ranked_multiset, detail::rbtree_ranked_multi<node_traits, Alloc, Comp>>;
+
+ public:
+    using super::super;
+    using super::operator=;
+
+    // constructors from initializer list are redeclared to take part in class template argument deduction
+    ranked_multiset(std::initializer_list<Key> l, const Alloc& alloc) : super(l, alloc) {}
+    ranked_multiset(std::initializer_list<Key> l, const Comp& comp = Comp(), const Alloc& alloc = Alloc())
+        : super(l, comp, alloc) {}
+
+    template<typename Comp2>
+    void merge(ranked_set<Key, Comp2, Alloc>& other) {
+        this->merge_impl(std::move(other));
+    }
+    template<typename Comp2>
+    void merge(ranked_set<Key, Comp2, Alloc>&& other) {
+        this->merge_impl(std::move(other));
+    }
+    template<typename Comp2>
+    void merge(ranked_multiset<Key, Comp2, Alloc>& other) {
+        this->merge_impl(std::move(other));
+    }
+    template<typename Comp2>
+    void merge(ranked_multiset<Key, Comp2, Alloc>&& other) {
+        this->merge_impl(std::move(other));
+    }
+};
+
+#if __cplusplus >= 201703L
+template<typename InputIt, typename Comp = std::less<typename std::iterator_traits<InputIt>::value_type>,
+         typename Alloc = std::allocator<typename std::iterator_traits<InputIt>::value_type>,
+         typename = std::enable_if_t<!is_allocator<Comp>::value>, typename = std::enable_if_t<is_allocator<Alloc>::value>>
+ranked_multiset(InputIt, InputIt, Comp = Comp(),
+         Alloc = Alloc()) -> ranked_multiset<typename std::iterator_traits<InputIt>::value_type, Comp, Alloc>;
+template<typename Key, typename Comp = std::less<Key>, typename Alloc = std::allocator<Key>,
+         typename = std::enable_if_t<!is_allocator<Comp>::value>, typename = std::enable_if_t<is_allocator<Alloc>::value>>
+ranked_multiset(std::initializer_list<Key>, Comp = Comp(), Alloc = Alloc()) -> ranked_multiset<Key, Comp, Alloc>;
+template<typename InputIt, typename Alloc, typename = std::enable_if_t<is_allocator<Alloc>::value>>
+ranked_multiset(InputIt, InputIt, Alloc)
+    -> ranked_multiset<typename std::iterator_traits<InputIt>::value_type,
+                       std::less<typename std::iterator_traits<InputIt>::value_type>, Alloc>;
+template<typename Key, typename Alloc, typename = std::enable_if_t<is_allocator<Alloc>::value>>
+ranked_multiset(std::initializer_list<Key>, Alloc) -> ranked_multiset<Key, std::less<Key>, Alloc>;
+#endif  // __cplusplus >= 201703L
+
+}  // namespace uxs
+
+namespace std {
+template<typename Key, typename Comp, typename Alloc>
+void swap(uxs::ranked_multiset<Key, Comp, Alloc>& s1,
+          uxs::ranked_multiset<Key, Comp, Alloc>& s2) noexcept(noexcept(s1.swap(s2))) {
+    s1.swap(s2);
+}
+}  // namespace std
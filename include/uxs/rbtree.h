@@ -13,6 +13,11 @@ struct rbtree_node_t {
     enum class color_t : char { black = 0, red = 1 } color;
 };
 
+// Node of order-statistic tree: all nodes of such tree, except the head, keep the size of their subtrees
+struct rbtree_ranked_node_t : rbtree_node_t {
+    std::size_t size;
+};
+
 inline bool rbtree_is_empty(const rbtree_node_t* head) noexcept { return head->left == nullptr; }
 
 inline void rbtree_init_head(rbtree_node_t* head) noexcept {
@@ -31,6 +36,10 @@ inline rbtree_node_t* rbtree_left_bound(rbtree_node_t* node) noexcept {
     return node;
 }
 
+inline std::size_t rbtree_subtree_size(const rbtree_node_t* node) noexcept {
+    return node ? static_cast<const rbtree_ranked_node_t*>(node)->size : 0;
+}
+
 UXS_EXPORT UXS_NOALIAS rbtree_node_t* rbtree_next(rbtree_node_t* node) noexcept;
 UXS_EXPORT UXS_NOALIAS rbtree_node_t* rbtree_prev(rbtree_node_t* node) noexcept;
 
@@ -202,4 +211,10 @@ std::pair<rbtree_node_t*, rbtree_node_t*> rbtree_equal_range(rbtree_node_t* head
 UXS_EXPORT void rbtree_insert(rbtree_node_t* head, rbtree_node_t* node, rbtree_node_t* pos, int dir) noexcept;
 UXS_EXPORT rbtree_node_t* rbtree_remove(rbtree_node_t* head, rbtree_node_t* pos) noexcept;
 
+// Order-statistic tree versions: `rbtree_subtree_size` is maintained for all nodes
+UXS_EXPORT void rbtree_ranked_insert(rbtree_node_t* head, rbtree_node_t* node, rbtree_node_t* pos, int dir) noexcept;
+UXS_EXPORT rbtree_node_t* rbtree_ranked_remove(rbtree_node_t* head, rbtree_node_t* pos) noexcept;
+UXS_EXPORT UXS_NOALIAS rbtree_node_t* rbtree_ranked_nth(rbtree_node_t* head, std::size_t n) noexcept;
+UXS_EXPORT UXS_NOALIAS std::size_t rbtree_ranked_index(const rbtree_node_t* head, const rbtree_node_t* node) noexcept;
+
 }  // namespace uxs
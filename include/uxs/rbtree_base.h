@@ -17,18 +17,25 @@ struct rbtree_links_t : rbtree_node_t {
 #endif  // UXS_ITERATOR_DEBUG_LEVEL != 0
 };
 
-template<typename Key>
-struct set_node_type : rbtree_links_t {
+template<typename Key, typename Links = rbtree_links_t>
+struct set_node_type : Links {
     Key value;
 };
 
-template<typename Key, typename Ty>
-struct map_node_type : rbtree_links_t {
+template<typename Key, typename Ty, typename Links = rbtree_links_t>
+struct map_node_type : Links {
     std::pair<const Key, Ty> value;
 };
 
 struct rbtree_node_traits {
+    using links_t = rbtree_links_t;
     using iterator_node_t = rbtree_node_t;
+    static void insert(rbtree_node_t* head, rbtree_node_t* node, rbtree_node_t* pos, int dir) {
+        rbtree_insert(head, node, pos, dir);
+    }
+    static rbtree_node_t* remove(rbtree_node_t* head, rbtree_node_t* pos) { return rbtree_remove(head, pos); }
+    static void copy_links(rbtree_node_t* node, const rbtree_node_t* src_node) { node->color = src_node->color; }
+    static void set_subtree_size(rbtree_node_t* node, std::size_t size) {}
     static rbtree_node_t* get_next(rbtree_node_t* node) { return rbtree_next(node); }
     static rbtree_node_t* get_prev(rbtree_node_t* node) { return rbtree_prev(node); }
 #if UXS_ITERATOR_DEBUG_LEVEL != 0
@@ -44,23 +51,23 @@ struct rbtree_node_traits {
 #endif  // UXS_ITERATOR_DEBUG_LEVEL != 0
 };
 
-template<typename Key>
-struct set_node_traits : rbtree_node_traits {
+template<typename Key, typename LinksTraits = rbtree_node_traits>
+struct set_node_traits : LinksTraits {
     using key_type = Key;
     using value_type = Key;
-    using node_t = set_node_type<Key>;
+    using node_t = set_node_type<Key, typename LinksTraits::links_t>;
     static const key_type& get_key(const value_type& v) { return v; }
     static key_type& get_value(rbtree_node_t* node) { return static_cast<node_t*>(node)->value; }
     static key_type& get_lref_value(rbtree_node_t* node) { return get_value(node); }
     static key_type&& get_rref_value(rbtree_node_t* node) { return std::move(get_value(node)); }
 };
 
-template<typename Key, typename Ty>
-struct map_node_traits : rbtree_node_traits {
+template<typename Key, typename Ty, typename LinksTraits = rbtree_node_traits>
+struct map_node_traits : LinksTraits {
     using key_type = Key;
     using mapped_type = Ty;
     using value_type = std::pair<const Key, Ty>;
-    using node_t = map_node_type<Key, Ty>;
+    using node_t = map_node_type<Key, Ty, typename LinksTraits::links_t>;
     static const key_type& get_key(const value_type& v) { return v.first; }
     static value_type& get_value(rbtree_node_t* node) { return static_cast<node_t*>(node)->value; }
     static std::pair<Key&, Ty&> get_lref_value(rbtree_node_t* node) {
@@ -384,7 +391,7 @@ class rbtree_base : protected rbtree_compare<NodeTraits, Alloc, Comp> {
     iterator erase(const_iterator pos) {
         auto* p = to_ptr(pos);
         assert(p != std::addressof(head_));
-        auto* next = rbtree_remove(std::addressof(head_), p);
+        auto* next = node_traits::remove(std::addressof(head_), p);
         delete_node(p);
         --size_;
         return iterator(next);
@@ -420,7 +427,7 @@ class rbtree_base : protected rbtree_compare<NodeTraits, Alloc, Comp> {
     node_type extract(const_iterator pos) {
         auto* p = to_ptr(pos);
         assert(p != std::addressof(head_));
-        rbtree_remove(std::addressof(head_), p);
+        node_traits::remove(std::addressof(head_), p);
         node_traits::set_head(p, nullptr);
         --size_;
         return node_type(*this, p);
@@ -487,7 +494,7 @@ class rbtree_base : protected rbtree_compare<NodeTraits, Alloc, Comp> {
     }
 
  private:
-    mutable rbtree_links_t head_;
+    mutable typename node_traits::links_t head_;
     size_type size_ = 0;
 
     template<typename, typename>
@@ -689,10 +696,113 @@ class rbtree_base : protected rbtree_compare<NodeTraits, Alloc, Comp> {
         }
     }
 
+    // Sorted chain: nodes joined in order through `right` pointers
+    struct sorted_chain_t {
+        rbtree_node_t* first = nullptr;
+        rbtree_node_t* last = nullptr;
+        size_type count = 0;
+        void push_back(rbtree_node_t* node) {
+            if (last) {
+                last->right = node;
+            } else {
+                first = node;
+            }
+            last = node, ++count;
+        }
+        // no more nodes can be appended after splicing
+        void splice(rbtree_node_t* node, size_type n) {
+            if (!n) { return; }
+            if (last) {
+                last->right = node;
+            } else {
+                first = node;
+            }
+            last = nullptr, count += n;
+        }
+    };
+
+    bool node_less(rbtree_node_t* lhs, rbtree_node_t* rhs) const {
+        return this->get_compare()(node_traits::get_key(node_traits::get_value(lhs)),
+                                   node_traits::get_key(node_traits::get_value(rhs)));
+    }
+
+    // Linear merge is preferred if the other tree isn't much smaller than this: n + m < m * log2(n)
+    bool prefer_linear_merge(size_type other_size) const {
+        size_type log_n = 1;
+        for (size_type n = size_; n > 1; n >>= 1) { ++log_n; }
+        return other_size >= size_ / log_n;
+    }
+
+    rbtree_node_t* detach_chain() noexcept {
+        auto* first = head_.parent;
+        // `rbtree_next` reads `right` pointer of the current node only, so already visited nodes can be relinked
+        for (auto* node = first; node != std::addressof(head_);) {
+            auto* next = rbtree_next(node);
+            node->right = next;
+            node = next;
+        }
+        reset();
+        return first;
+    }
+
+    void delete_chain(rbtree_node_t* node, size_type n) {
+        for (; n; --n) {
+            auto* next = node->right;
+            delete_node(node);
+            node = next;
+        }
+    }
+
+    // Links a sorted chain into an empty tree in linear time
+    void link_chain(const sorted_chain_t& chain) noexcept {
+        auto* node = chain.first;
+        build_tree(
+            [&node]() {
+                auto* next = node;
+                node = node->right;
+                return next;
+            },
+            chain.count);
+    }
+
+    // Builds perfectly balanced tree of nodes obtained in order from the source: all levels are full except the last
+    // one, and only nodes of the incomplete last level are red. The tree must be empty
+    template<typename NodeSource>
+    void build_tree(NodeSource&& source, size_type n) {
+        if (!n) { return; }
+        unsigned red_depth = 0;
+        for (size_type k = n + 1; k > 1; k >>= 1) { ++red_depth; }
+        head_.left = build_subtree(source, n, 0, red_depth);
+        head_.left->parent = std::addressof(head_);
+        head_.parent = rbtree_left_bound(head_.left);
+        head_.right = rbtree_right_bound(head_.left);
+        size_ = n;
+    }
+
+    template<typename NodeSource>
+    rbtree_node_t* build_subtree(NodeSource& source, size_type n, unsigned depth, unsigned red_depth);
+
+    // Builds the tree directly if the range is sorted, otherwise returns `false`. The tree must be empty
+    template<typename InputIt>
+    bool try_build_sorted(InputIt first, InputIt last, bool unique) {
+        return try_build_sorted(first, last, unique,
+                                std::bool_constant<(is_forward_iterator<InputIt>::value &&
+                                                    std::is_same<typename std::iterator_traits<InputIt>::value_type,
+                                                                 value_type>::value)>());
+    }
+
+    template<typename InputIt>
+    bool try_build_sorted(InputIt /*first*/, InputIt /*last*/, bool /*unique*/, std::false_type) {
+        return false;
+    }
+
+    template<typename FwdIt>
+    bool try_build_sorted(FwdIt first, FwdIt last, bool unique, std::true_type);
+
     void erase_impl(rbtree_node_t* first, rbtree_node_t* last) {
         do {
             assert(first != std::addressof(head_));
-            auto* next = rbtree_remove(std::addressof(head_), first);
+            auto* next = node_traits::remove(std::addressof(head_), first);
             delete_node(first);
             --size_, first = next;
         } while (first != last);
@@ -708,7 +818,7 @@ template<typename NodeTraits, typename Alloc, typename Comp>
 template<typename CopyFunc>
 void rbtree_base<NodeTraits, Alloc, Comp>::copy_node(rbtree_node_t* node, rbtree_node_t* src_node, CopyFunc fn) {
     node->left = node->right = nullptr;
-    node->color = src_node->color;
+    node_traits::copy_links(node, src_node);
     if (src_node->left) {
         node->left = new_node(fn(src_node->left));
         node->left->parent = node;
@@ -726,7 +836,7 @@ template<typename CopyFunc>
 void rbtree_base<NodeTraits, Alloc, Comp>::copy_node_reuse(rbtree_node_t* node, rbtree_node_t* src_node, CopyFunc fn,
                                                            reuse_cache_t& cache) {
     node->left = node->right = nullptr;
-    node->color = src_node->color;
+    node_traits::copy_links(node, src_node);
     if (src_node->left) {
         if (cache) {
             node_traits::get_lref_value(*cache) = fn(src_node->left);
@@ -753,6 +863,57 @@ void rbtree_base<NodeTraits, Alloc, Comp>::copy_node_reuse(rbtree_node_t* node,
     }
 }
 
+template<typename NodeTraits, typename Alloc, typename Comp>
+template<typename NodeSource>
+rbtree_node_t* rbtree_base<NodeTraits, Alloc, Comp>::build_subtree(NodeSource& source, size_type n, unsigned depth,
+                                                                   unsigned red_depth) {
+    const size_type n_left = (n - 1) / 2;
+    rbtree_node_t* left = n_left ? build_subtree(source, n_left, depth + 1, red_depth) : nullptr;
+    rbtree_node_t* node = nullptr;
+    try {
+        node = source();
+    } catch (...) {
+        if (left) { delete_recursive(left); }
+        throw;
+    }
+    node->left = left, node->right = nullptr;
+    if (left) { left->parent = node; }
+    if (n - n_left > 1) {
+        try {
+            node->right = build_subtree(source, n - n_left - 1, depth + 1, red_depth);
+        } catch (...) {
+            delete_recursive(node);
+            throw;
+        }
+        node->right->parent = node;
+    }
+    node->color = depth == red_depth ? rbtree_node_t::color_t::red : rbtree_node_t::color_t::black;
+    node_traits::set_subtree_size(node, n);
+    node_traits::set_head(node, std::addressof(head_));
+    return node;
+}
+
+template<typename NodeTraits, typename Alloc, typename Comp>
+template<typename FwdIt>
+bool rbtree_base<NodeTraits, Alloc, Comp>::try_build_sorted(FwdIt first, FwdIt last, bool unique, std::true_type) {
+    assert(!size_);
+    if (first == last) { return true; }
+    size_type n = 1;
+    for (FwdIt prev = first, it = std::next(first); it != last; prev = it++, ++n) {
+        const auto& key = node_traits::get_key(*it);
+        const auto& prev_key = node_traits::get_key(*prev);
+        if (unique ? !this->get_compare()(prev_key, key) : this->get_compare()(key, prev_key)) { return false; }
+    }
+    build_tree(
+        [this, &first]() {
+            auto* node = new_node(*first);
+            ++first;
+            return node;
+        },
+        n);
+    return true;
+}
+
 #if __cplusplus >= 201703L
 template<typename InputIt>
 using iter_key_t = est::remove_const_t<typename std::iterator_traits<InputIt>::value_type::first_type>;
@@ -58,7 +58,7 @@ class rbtree_multi : public rbtree_base<NodeTraits, Alloc, Comp> {
         try {
             auto result = rbtree_find_insert_pos<node_traits>(
                 std::addressof(this->head_), node_traits::get_key(node_traits::get_value(node)), this->get_compare());
-            rbtree_insert(std::addressof(this->head_), node, result.first, result.second);
+            node_traits::insert(std::addressof(this->head_), node, result.first, result.second);
             ++this->size_;
             return iterator(node);
         } catch (...) {
@@ -76,7 +76,7 @@ class rbtree_multi : public rbtree_base<NodeTraits, Alloc, Comp> {
             auto result = rbtree_find_insert_pos<node_traits>(std::addressof(this->head_), this->to_ptr(hint),
                                                               node_traits::get_key(node_traits::get_value(node)),
                                                               this->get_compare());
-            rbtree_insert(std::addressof(this->head_), node, result.first, result.second);
+            node_traits::insert(std::addressof(this->head_), node, result.first, result.second);
             ++this->size_;
             return iterator(node);
         } catch (...) {
@@ -94,7 +94,7 @@ class rbtree_multi : public rbtree_base<NodeTraits, Alloc, Comp> {
         auto result = rbtree_find_insert_pos<node_traits>(
             std::addressof(this->head_), node_traits::get_key(node_traits::get_value(node)), this->get_compare());
         node_traits::set_head(node, std::addressof(this->head_));
-        rbtree_insert(std::addressof(this->head_), node, result.first, result.second);
+        node_traits::insert(std::addressof(this->head_), node, result.first, result.second);
         ++this->size_;
         nh.node_ = nullptr;
         return iterator(node);
@@ -110,7 +110,7 @@ class rbtree_multi : public rbtree_base<NodeTraits, Alloc, Comp> {
                                                           node_traits::get_key(node_traits::get_value(node)),
                                                           this->get_compare());
         node_traits::set_head(node, std::addressof(this->head_));
-        rbtree_insert(std::addressof(this->head_), node, result.first, result.second);
+        node_traits::insert(std::addressof(this->head_), node, result.first, result.second);
         ++this->size_;
         nh.node_ = nullptr;
         return iterator(node);
@@ -141,6 +141,7 @@ class rbtree_multi : public rbtree_base<NodeTraits, Alloc, Comp> {
     template<typename InputIt>
     void insert_impl(InputIt first, InputIt last) {
         assert(super::check_iterator_range(first, last, is_random_access_iterator<InputIt>()));
+        if (!this->size_ && this->try_build_sorted(first, last, false)) { return; }
         for (; first != last; ++first) { emplace_hint(this->end(), *first); }
     }
 };
@@ -157,7 +158,7 @@ void rbtree_multi<node_traits, Alloc, Comp>::assign_range(InputIt first, InputIt
             auto result = rbtree_find_insert_pos<node_traits>(std::addressof(this->head_), std::addressof(this->head_),
                                                               node_traits::get_key(node_traits::get_value(*cache)),
                                                               this->get_compare());
-            rbtree_insert(std::addressof(this->head_), cache.advance(), result.first, result.second);
+            node_traits::insert(std::addressof(this->head_), cache.advance(), result.first, result.second);
             ++this->size_;
         }
     }
@@ -175,9 +176,9 @@ void rbtree_multi<node_traits, Alloc, Comp>::merge_impl(rbtree_base<node_traits,
     do {
         auto result = rbtree_find_insert_pos<node_traits>(
             std::addressof(this->head_), node_traits::get_key(node_traits::get_value(node)), this->get_compare());
-        auto* next = rbtree_remove(std::addressof(other.head_), node);
+        auto* next = node_traits::remove(std::addressof(other.head_), node);
         node_traits::set_head(node, std::addressof(this->head_));
-        rbtree_insert(std::addressof(this->head_), node, result.first, result.second);
+        node_traits::insert(std::addressof(this->head_), node, result.first, result.second);
         ++this->size_, --other.size_;
         node = next;
     } while (node != std::addressof(other.head_));
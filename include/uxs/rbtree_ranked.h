@@ -0,0 +1,100 @@
+#pragma once
+
+#include "rbtree_multi.h"
+#include "rbtree_unique.h"
+
+namespace uxs {
+
+namespace detail {
+
+//-----------------------------------------------------------------------------
+// Order-statistic red-black tree implementation
+
+struct rbtree_ranked_links_t : rbtree_ranked_node_t {
+#if UXS_ITERATOR_DEBUG_LEVEL != 0
+    rbtree_node_t* head;
+#endif  // UXS_ITERATOR_DEBUG_LEVEL != 0
+};
+
+struct rbtree_ranked_node_traits {
+    using links_t = rbtree_ranked_links_t;
+    using iterator_node_t = rbtree_node_t;
+    static void insert(rbtree_node_t* head, rbtree_node_t* node, rbtree_node_t* pos, int dir) {
+        rbtree_ranked_insert(head, node, pos, dir);
+    }
+    static rbtree_node_t* remove(rbtree_node_t* head, rbtree_node_t* pos) { return rbtree_ranked_remove(head, pos); }
+    static void copy_links(rbtree_node_t* node, const rbtree_node_t* src_node) {
+        node->color = src_node->color;
+        static_cast<rbtree_ranked_node_t*>(node)->size = static_cast<const rbtree_ranked_node_t*>(src_node)->size;
+    }
+    static void set_subtree_size(rbtree_node_t* node, std::size_t size) {
+        static_cast<rbtree_ranked_node_t*>(node)->size = size;
+    }
+    static rbtree_node_t* get_next(rbtree_node_t* node) { return rbtree_next(node); }
+    static rbtree_node_t* get_prev(rbtree_node_t* node) { return rbtree_prev(node); }
+#if UXS_ITERATOR_DEBUG_LEVEL != 0
+    static void set_head(rbtree_node_t* node, rbtree_node_t* head) { static_cast<links_t*>(node)->head = head; }
+    static void set_head(rbtree_node_t* first, rbtree_node_t* last, rbtree_node_t* head) {
+        for (auto* p = first; p != last; p = get_next(p)) { set_head(p, head); }
+    }
+    static rbtree_node_t* get_head(rbtree_node_t* node) { return static_cast<links_t*>(node)->head; }
+    static rbtree_node_t* get_front(rbtree_node_t* head) { return head->parent; }
+#else   // UXS_ITERATOR_DEBUG_LEVEL != 0
+    static void set_head(rbtree_node_t* node, rbtree_node_t* head) {}
+    static void set_head(rbtree_node_t* first, rbtree_node_t* last, rbtree_node_t* head) {}
+#endif  // UXS_ITERATOR_DEBUG_LEVEL != 0
+};
+
+template<typename Key>
+using ranked_set_node_traits = set_node_traits<Key, rbtree_ranked_node_traits>;
+
+template<typename Key, typename Ty>
+using ranked_map_node_traits = map_node_traits<Key, Ty, rbtree_ranked_node_traits>;
+
+// Adds rank/select operations to a tree with `rbtree_ranked_node_traits`
+template<typename Super>
+class rbtree_ranked : public Super {
+ public:
+    using key_type = typename Super::key_type;
+    using key_compare = typename Super::key_compare;
+    using size_type = typename Super::size_type;
+    using difference_type = typename Super::difference_type;
+    using iterator = typename Super::iterator;
+    using const_iterator = typename Super::const_iterator;
+
+    using Super::Super;
+
+    // - nth: returns `end()` if `n >= size()`
+
+    iterator nth(size_type n) { return iterator(rbtree_ranked_nth(this->end().node(), n)); }
+    const_iterator nth(size_type n) const { return const_iterator(rbtree_ranked_nth(this->end().node(), n)); }
+
+    // - index_of: returns `size()` for `end()`
+
+    size_type index_of(const_iterator it) const { return rbtree_ranked_index(this->end().node(), it.node()); }
+
+    // - rank: the number of elements less than the key
+
+    size_type rank(const key_type& key) const { return index_of(this->lower_bound(key)); }
+
+    template<typename Key, typename Comp_ = key_compare>
+    est::type_identity_t<size_type, typename Comp_::is_transparent> rank(const Key& key) const {
+        return index_of(this->lower_bound(key));
+    }
+
+    // - distance: O(log n) alternative to `std::distance`
+
+    difference_type distance(const_iterator first, const_iterator last) const {
+        return static_cast<difference_type>(index_of(last)) - static_cast<difference_type>(index_of(first));
+    }
+};
+
+template<typename NodeTraits, typename Alloc, typename Comp>
+using rbtree_ranked_unique = rbtree_ranked<rbtree_unique<NodeTraits, Alloc, Comp>>;
+
+template<typename NodeTraits, typename Alloc, typename Comp>
+using rbtree_ranked_multi = rbtree_ranked<rbtree_multi<NodeTraits, Alloc, Comp>>;
+
+}  // namespace detail
+
+}  // namespace uxs
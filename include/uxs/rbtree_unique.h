@@ -22,6 +22,7 @@ class rbtree_unique : public rbtree_base<NodeTraits, Alloc, Comp> {
     using allocator_type = typename super::allocator_type;
     using value_type = typename super::value_type;
     using key_compare = typename super::key_compare;
+    using size_type = typename super::size_type;
     using iterator = typename super::iterator;
     using const_iterator = typename super::const_iterator;
     using node_type = typename super::node_type;
@@ -79,7 +80,7 @@ class rbtree_unique : public rbtree_base<NodeTraits, Alloc, Comp> {
             auto result = rbtree_find_insert_unique_pos<node_traits>(
                 std::addressof(this->head_), node_traits::get_key(node_traits::get_value(node)), this->get_compare());
             if (result.second) {
-                rbtree_insert(std::addressof(this->head_), node, result.first, result.second);
+                node_traits::insert(std::addressof(this->head_), node, result.first, result.second);
                 ++this->size_;
                 return std::make_pair(iterator(node), true);
             }
@@ -101,7 +102,7 @@ class rbtree_unique : public rbtree_base<NodeTraits, Alloc, Comp> {
                                                                      node_traits::get_key(node_traits::get_value(node)),
                                                                      this->get_compare());
             if (result.second) {
-                rbtree_insert(std::addressof(this->head_), node, result.first, result.second);
+                node_traits::insert(std::addressof(this->head_), node, result.first, result.second);
                 ++this->size_;
                 return iterator(node);
             }
@@ -123,7 +124,7 @@ class rbtree_unique : public rbtree_base<NodeTraits, Alloc, Comp> {
             std::addressof(this->head_), node_traits::get_key(node_traits::get_value(node)), this->get_compare());
         if (result.second) {
             node_traits::set_head(node, std::addressof(this->head_));
-            rbtree_insert(std::addressof(this->head_), node, result.first, result.second);
+            node_traits::insert(std::addressof(this->head_), node, result.first, result.second);
             ++this->size_;
             nh.node_ = nullptr;
             return {iterator(node), true, node_type(*this)};
@@ -142,7 +143,7 @@ class rbtree_unique : public rbtree_base<NodeTraits, Alloc, Comp> {
                                                                  this->get_compare());
         if (result.second) {
             node_traits::set_head(node, std::addressof(this->head_));
-            rbtree_insert(std::addressof(this->head_), node, result.first, result.second);
+            node_traits::insert(std::addressof(this->head_), node, result.first, result.second);
             ++this->size_;
             nh.node_ = nullptr;
             return iterator(node);
@@ -167,6 +168,14 @@ class rbtree_unique : public rbtree_base<NodeTraits, Alloc, Comp> {
         insert_impl(first, last);
     }
 
+    // - set algebra: sorted node sequences are merged in linear time and relinked into a balanced tree;
+    //   if the other tree is much smaller, its elements are processed one by one
+
+    void merge_union(const rbtree_unique& other);
+    void merge_union(rbtree_unique&& other);
+    void merge_intersection(const rbtree_unique& other);
+    void merge_difference(const rbtree_unique& other);
+
  protected:
     template<typename InputIt>
     void assign_range(InputIt first, InputIt last);
@@ -175,6 +184,7 @@ class rbtree_unique : public rbtree_base<NodeTraits, Alloc, Comp> {
     template<typename InputIt>
     void insert_impl(InputIt first, InputIt last) {
         assert(super::check_iterator_range(first, last, is_random_access_iterator<InputIt>()));
+        if (!this->size_ && this->try_build_sorted(first, last, true)) { return; }
         for (; first != last; ++first) { emplace_hint(this->end(), *first); }
     }
 
@@ -184,7 +194,7 @@ class rbtree_unique : public rbtree_base<NodeTraits, Alloc, Comp> {
         if (result.second) {
             auto* node = this->new_node(std::piecewise_construct, std::forward_as_tuple(std::forward<Key2>(key)),
                                         std::forward_as_tuple(std::forward<Args>(args)...));
-            rbtree_insert(std::addressof(this->head_), node, result.first, result.second);
+            node_traits::insert(std::addressof(this->head_), node, result.first, result.second);
             ++this->size_;
             return std::make_pair(iterator(node), true);
         }
@@ -198,7 +208,7 @@ class rbtree_unique : public rbtree_base<NodeTraits, Alloc, Comp> {
         if (result.second) {
             auto* node = this->new_node(std::piecewise_construct, std::forward_as_tuple(std::forward<Key2>(key)),
                                         std::forward_as_tuple(std::forward<Args>(args)...));
-            rbtree_insert(std::addressof(this->head_), node, result.first, result.second);
+            node_traits::insert(std::addressof(this->head_), node, result.first, result.second);
             ++this->size_;
             return std::make_pair(iterator(node), true);
         }
@@ -219,7 +229,7 @@ void rbtree_unique<NodeTraits, Alloc, Comp>::assign_range(InputIt first, InputIt
                 std::addressof(this->head_), std::addressof(this->head_),
                 node_traits::get_key(node_traits::get_value(*cache)), this->get_compare());
             if (result.second) {
-                rbtree_insert(std::addressof(this->head_), cache.advance(), result.first, result.second);
+                node_traits::insert(std::addressof(this->head_), cache.advance(), result.first, result.second);
                 ++this->size_;
             }
         }
@@ -239,9 +249,9 @@ void rbtree_unique<NodeTraits, Alloc, Comp>::merge_impl(rbtree_base<NodeTraits,
         auto result = rbtree_find_insert_unique_pos<node_traits>(
             std::addressof(this->head_), node_traits::get_key(node_traits::get_value(node)), this->get_compare());
         if (result.second) {
-            auto* next = rbtree_remove(std::addressof(other.head_), node);
+            auto* next = node_traits::remove(std::addressof(other.head_), node);
             node_traits::set_head(node, std::addressof(this->head_));
-            rbtree_insert(std::addressof(this->head_), node, result.first, result.second);
+            node_traits::insert(std::addressof(this->head_), node, result.first, result.second);
             ++this->size_, --other.size_;
             node = next;
         } else {
@@ -250,6 +260,155 @@ void rbtree_unique<NodeTraits, Alloc, Comp>::merge_impl(rbtree_base<NodeTraits,
     } while (node != std::addressof(other.head_));
 }
 
+template<typename NodeTraits, typename Alloc, typename Comp>
+void rbtree_unique<NodeTraits, Alloc, Comp>::merge_union(const rbtree_unique& other) {
+    if (!other.size_ || std::addressof(other) == this) { return; }
+    if (!this->prefer_linear_merge(other.size_)) {
+        auto hint = this->end();
+        for (const auto& val : other) { hint = std::next(emplace_hint(hint, val)); }
+        return;
+    }
+    typename super::sorted_chain_t chain;
+    size_type rest = this->size_;
+    auto* node = this->detach_chain();
+    auto* other_node = other.head_.parent;
+    try {
+        for (; other_node != std::addressof(other.head_); other_node = rbtree_next(other_node)) {
+            while (rest && this->node_less(node, other_node)) {
+                auto* next = node->right;
+                chain.push_back(node), --rest;
+                node = next;
+            }
+            if (rest && !this->node_less(other_node, node)) {
+                auto* next = node->right;
+                chain.push_back(node), --rest;
+                node = next;
+            } else {
+                chain.push_back(this->new_node(node_traits::get_value(other_node)));
+            }
+        }
+    } catch (...) {
+        chain.splice(node, rest);
+        this->link_chain(chain);
+        throw;
+    }
+    chain.splice(node, rest);
+    this->link_chain(chain);
+}
+
+template<typename NodeTraits, typename Alloc, typename Comp>
+void rbtree_unique<NodeTraits, Alloc, Comp>::merge_union(rbtree_unique&& other) {
+    if (!other.size_ || std::addressof(other) == this) { return; }
+    if (!is_alloc_always_equal<alloc_type>::value && !this->is_same_alloc(other)) {
+        merge_union(static_cast<const rbtree_unique&>(other));
+        other.tidy();
+        return;
+    }
+    if (!this->prefer_linear_merge(other.size_)) {
+        merge_impl(std::move(other));
+        other.tidy();
+        return;
+    }
+    typename super::sorted_chain_t chain;
+    size_type rest = this->size_, other_rest = other.size_;
+    auto* node = this->detach_chain();
+    auto* other_node = other.detach_chain();
+    try {
+        while (rest && other_rest) {
+            if (this->node_less(node, other_node)) {
+                auto* next = node->right;
+                chain.push_back(node), --rest;
+                node = next;
+            } else {
+                auto* other_next = other_node->right;
+                if (this->node_less(other_node, node)) {
+                    chain.push_back(other_node);
+                } else {
+                    other.delete_node(other_node);
+                }
+                other_node = other_next, --other_rest;
+            }
+        }
+    } catch (...) {
+        chain.splice(node, rest);
+        this->link_chain(chain);
+        typename super::sorted_chain_t other_chain;
+        other_chain.splice(other_node, other_rest);
+        other.link_chain(other_chain);
+        throw;
+    }
+    chain.splice(node, rest);
+    chain.splice(other_node, other_rest);
+    this->link_chain(chain);
+}
+
+template<typename NodeTraits, typename Alloc, typename Comp>
+void rbtree_unique<NodeTraits, Alloc, Comp>::merge_intersection(const rbtree_unique& other) {
+    if (!this->size_ || std::addressof(other) == this) { return; }
+    typename super::sorted_chain_t chain;
+    size_type rest = this->size_;
+    auto* node = this->detach_chain();
+    auto* other_node = other.head_.parent;
+    try {
+        while (rest && other_node != std::addressof(other.head_)) {
+            if (this->node_less(other_node, node)) {
+                other_node = rbtree_next(other_node);
+                continue;
+            }
+            auto* next = node->right;
+            if (this->node_less(node, other_node)) {
+                this->delete_node(node);
+            } else {
+                chain.push_back(node);
+                other_node = rbtree_next(other_node);
+            }
+            node = next, --rest;
+        }
+    } catch (...) {
+        chain.splice(node, rest);
+        this->link_chain(chain);
+        throw;
+    }
+    this->delete_chain(node, rest);
+    this->link_chain(chain);
+}
+
+template<typename NodeTraits, typename Alloc, typename Comp>
+void rbtree_unique<NodeTraits, Alloc, Comp>::merge_difference(const rbtree_unique& other) {
+    if (!this->size_ || !other.size_) { return; }
+    if (std::addressof(other) == this) { return this->tidy(); }
+    if (!this->prefer_linear_merge(other.size_)) {
+        for (const auto& val : other) { this->erase(node_traits::get_key(val)); }
+        return;
+    }
+    typename super::sorted_chain_t chain;
+    size_type rest = this->size_;
+    auto* node = this->detach_chain();
+    auto* other_node = other.head_.parent;
+    try {
+        while (rest && other_node != std::addressof(other.head_)) {
+            if (this->node_less(other_node, node)) {
+                other_node = rbtree_next(other_node);
+                continue;
+            }
+            auto* next = node->right;
+            if (this->node_less(node, other_node)) {
+                chain.push_back(node);
+            } else {
+                this->delete_node(node);
+                other_node = rbtree_next(other_node);
+            }
+            node = next, --rest;
+        }
+    } catch (...) {
+        chain.splice(node, rest);
+        this->link_chain(chain);
+        throw;
+    }
+    chain.splice(node, rest);
+    this->link_chain(chain);
+}
+
 }  // namespace detail
 
 }  // namespace uxs
@@ -2,10 +2,57 @@
 
 #include "string_alg.h"
 
+#include <memory>
 #include <regex>
 
 namespace uxs {
 
+class UXS_EXPORT_ALL_STUFF_FOR_GNUC regex_error : public std::runtime_error {
+ public:
+    UXS_EXPORT explicit regex_error(const char* message);
+    UXS_EXPORT explicit regex_error(const std::string& message);
+    UXS_EXPORT const char* what() const noexcept override;
+};
+
+namespace detail {
+class regex_impl;
+}
+
+// Regular expression compiled to an automaton: searching time is linear in the length of the text,
+// there is no backtracking. ECMAScript syntax subset is supported: alternations, groups `(...)` and `(?:...)`,
+// greedy and lazy quantifiers `*`, `+`, `?`, `{n}`, `{n,}`, `{n,m}`, character classes, `.`, `^`, `$` and
+// escapes `\d`, `\w`, `\s`, `\D`, `\W`, `\S`, `\n`, `\r`, `\t`, `\f`, `\v`, `\0`, `\xHH`, `\uHHHH`;
+// back references, assertions `\b`, `\B` and lookarounds are not supported. The leftmost match is found,
+// and alternatives and quantifier repetitions are preferred in the order of a backtracking matcher, as in RE2;
+// unlike ECMAScript, an iteration matching the empty string is not rejected, so the match can differ for
+// quantified subexpressions which may be empty, e.g. `(?:b?|.+){1,2}`. Automaton states are built on demand
+// and cached in the object under a lock, so the object can be used by several threads concurrently.
+// A moved-from object matches nothing
+template<typename CharT>
+class basic_regex {
+ public:
+    UXS_EXPORT explicit basic_regex(std::basic_string_view<CharT> pattern);
+    UXS_EXPORT basic_regex(const basic_regex& other);
+    UXS_EXPORT basic_regex& operator=(const basic_regex& other);
+    UXS_EXPORT basic_regex(basic_regex&& other) noexcept;
+    UXS_EXPORT basic_regex& operator=(basic_regex&& other) noexcept;
+    UXS_EXPORT ~basic_regex();
+
+    // Returns the leftmost match or `{last, last}`
+    UXS_EXPORT std::pair<const CharT*, const CharT*> find(const CharT* first, const CharT* last) const;
+    // Returns the match ending last or `{first, first}`
+    UXS_EXPORT std::pair<const CharT*, const CharT*> rfind(const CharT* first, const CharT* last) const;
+    // Checks if the whole text matches
+    UXS_EXPORT bool match(const CharT* first, const CharT* last) const;
+    bool match(std::basic_string_view<CharT> s) const { return match(s.data(), s.data() + s.size()); }
+
+ private:
+    std::unique_ptr<detail::regex_impl> impl_;
+};
+
+using regex = basic_regex<char>;
+using wregex = basic_regex<wchar_t>;
+
 namespace detail {
 template<typename CharT, typename RegexTraits, typename Traits>
 struct string_finder<std::basic_regex<CharT, RegexTraits>, Traits> {
@@ -40,8 +87,48 @@ struct reversed_string_finder<std::basic_regex<CharT, RegexTraits>, Traits> {
         return result;
     }
 };
+template<typename CharT, typename Traits>
+struct string_finder<uxs::basic_regex<CharT>, Traits> {
+    const uxs::basic_regex<CharT>& regex;
+    using is_finder = int;
+    using iterator = typename std::basic_string_view<CharT, Traits>::const_iterator;
+    explicit string_finder(const uxs::basic_regex<CharT>& tgt) : regex(tgt) {}
+    std::pair<iterator, iterator> operator()(iterator begin, iterator end) const {
+        // the pattern is tried on an empty range too: it can match an empty string
+        const CharT* p = begin != end ? std::addressof(*begin) : nullptr;
+        const auto m = regex.find(p, p + (end - begin));
+        return std::make_pair(begin + (m.first - p), begin + (m.second - p));
+    }
+};
+
+template<typename CharT, typename Traits>
+struct reversed_string_finder<uxs::basic_regex<CharT>, Traits> {
+    const uxs::basic_regex<CharT>& regex;
+    using is_reversed_finder = int;
+    using iterator = typename std::basic_string_view<CharT, Traits>::const_iterator;
+    explicit reversed_string_finder(const uxs::basic_regex<CharT>& tgt) : regex(tgt) {}
+    std::pair<iterator, iterator> operator()(iterator begin, iterator end) const {
+        const CharT* p = begin != end ? std::addressof(*begin) : nullptr;
+        const auto m = regex.rfind(p, p + (end - begin));
+        return std::make_pair(begin + (m.first - p), begin + (m.second - p));
+    }
+};
 }  // namespace detail
 
+inline detail::string_finder<regex, std::char_traits<char>> sfinder(const regex& re) {
+    return detail::string_finder<regex, std::char_traits<char>>(re);
+}
+inline detail::reversed_string_finder<regex, std::char_traits<char>> rsfinder(const regex& re) {
+    return detail::reversed_string_finder<regex, std::char_traits<char>>(re);
+}
+
+inline detail::string_finder<wregex, std::char_traits<wchar_t>> sfinder(const wregex& re) {
+    return detail::string_finder<wregex, std::char_traits<wchar_t>>(re);
+}
+inline detail::reversed_string_finder<wregex, std::char_traits<wchar_t>> rsfinder(const wregex& re) {
+    return detail::reversed_string_finder<wregex, std::char_traits<wchar_t>>(re);
+}
+
 inline detail::string_finder<std::regex, std::char_traits<char>> sfinder(const std::regex& re) {
     return detail::string_finder<std::regex, std::char_traits<char>>(re);
 }
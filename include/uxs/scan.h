@@ -0,0 +1,235 @@
+#pragma once
+
+#include "format_base.h"
+#include "io/ibuf.h"
+
+#include <array>
+
+namespace uxs {
+
+enum class scan_errc : std::uint8_t {
+    ok = 0,
+    eof,             // input is ended before all values are read
+    mismatch,        // input text doesn't match format text
+    invalid_value,   // field can't be converted to argument value
+    invalid_format,  // format string is invalid; only runtime format strings are not checked at compile time
+};
+
+struct scan_result {
+    scan_errc ec;
+    std::size_t count;   // number of assigned arguments
+    std::size_t n_read;  // number of consumed characters
+    explicit operator bool() const noexcept { return ec == scan_errc::ok; }
+};
+
+namespace detail {
+
+enum class scan_arg_type : std::uint8_t {
+    none = 0,
+    boolean,
+    character,
+    int8,
+    int16,
+    int32,
+    int64,
+    uint8,
+    uint16,
+    uint32,
+    uint64,
+    float32,
+    float64,
+    long_double,
+    string,
+    string_view,
+};
+
+template<typename Ty, typename CharT, typename = void>
+struct scan_arg_type_index : std::integral_constant<scan_arg_type, scan_arg_type::none> {};
+template<typename CharT>
+struct scan_arg_type_index<bool, CharT> : std::integral_constant<scan_arg_type, scan_arg_type::boolean> {};
+template<typename CharT>
+struct scan_arg_type_index<CharT, CharT> : std::integral_constant<scan_arg_type, scan_arg_type::character> {};
+constexpr scan_arg_type get_scan_integer_type(bool is_signed, std::size_t sz) noexcept {
+    return static_cast<scan_arg_type>(static_cast<unsigned>(is_signed ? scan_arg_type::int8 : scan_arg_type::uint8) +
+                                      (sz == 1 ? 0 : (sz == 2 ? 1 : (sz == 4 ? 2 : 3))));
+}
+
+template<typename Ty, typename CharT>
+struct scan_arg_type_index<
+    Ty, CharT,
+    std::enable_if_t<std::is_integral<Ty>::value && !std::is_same<Ty, bool>::value && !std::is_same<Ty, CharT>::value>>
+    : std::integral_constant<scan_arg_type, get_scan_integer_type(std::is_signed<Ty>::value, sizeof(Ty))> {};
+template<typename CharT>
+struct scan_arg_type_index<float, CharT> : std::integral_constant<scan_arg_type, scan_arg_type::float32> {};
+template<typename CharT>
+struct scan_arg_type_index<double, CharT> : std::integral_constant<scan_arg_type, scan_arg_type::float64> {};
+template<typename CharT>
+struct scan_arg_type_index<long double, CharT> : std::integral_constant<scan_arg_type, scan_arg_type::long_double> {};
+template<typename CharT>
+struct scan_arg_type_index<std::basic_string<CharT>, CharT>
+    : std::integral_constant<scan_arg_type, scan_arg_type::string> {};
+template<typename CharT>
+struct scan_arg_type_index<std::basic_string_view<CharT>, CharT>
+    : std::integral_constant<scan_arg_type, scan_arg_type::string_view> {};
+
+struct scan_arg {
+    scan_arg_type type;
+    void* val;
+};
+
+template<typename CharT, typename Ty>
+scan_arg make_scan_arg(Ty& val) noexcept {
+    static_assert(scan_arg_type_index<Ty, CharT>::value != scan_arg_type::none, "unsupported scan argument type");
+    return scan_arg{scan_arg_type_index<Ty, CharT>::value, static_cast<void*>(std::addressof(val))};
+}
+
+template<typename CharT>
+UXS_CONSTEXPR bool is_valid_scan_type(scan_arg_type arg_type, CharT type) noexcept {
+    if (!type) { return true; }
+    switch (arg_type) {
+        case scan_arg_type::boolean: return type == 's' || type == 'd';
+        case scan_arg_type::character: return type == 'c';
+        case scan_arg_type::int8:
+        case scan_arg_type::int16:
+        case scan_arg_type::int32:
+        case scan_arg_type::int64:
+        case scan_arg_type::uint8:
+        case scan_arg_type::uint16:
+        case scan_arg_type::uint32:
+        case scan_arg_type::uint64:
+            return type == 'd' || type == 'x' || type == 'X' || type == 'o' || type == 'b' || type == 'B';
+        case scan_arg_type::float32:
+        case scan_arg_type::float64:
+        case scan_arg_type::long_double:
+            return type == 'f' || type == 'F' || type == 'e' || type == 'E' || type == 'g' || type == 'G';
+        case scan_arg_type::string:
+        case scan_arg_type::string_view: return type == 's';
+        default: return false;
+    }
+}
+
+// Parses replacement field `{[id][:[width][type]]}` starting after the opening brace,
+// returns the position after the closing brace or `npos` if the field is invalid;
+// `arg_id` is left unchanged if there is no explicit argument identifier
+template<typename CharT>
+UXS_CONSTEXPR std::size_t parse_scan_field(std::basic_string_view<CharT> fmt, std::size_t pos, std::size_t& arg_id,
+                                           std::size_t& width, CharT& type) noexcept {
+    const std::size_t npos = std::basic_string_view<CharT>::npos;
+    unsigned dig = 0;
+    width = 0, type = 0;
+    if (pos < fmt.size() && (dig = dig_v(fmt[pos])) < 10) {
+        arg_id = dig;
+        while (++pos < fmt.size() && (dig = dig_v(fmt[pos])) < 10) { arg_id = 10 * arg_id + dig; }
+    }
+    if (pos < fmt.size() && fmt[pos] == ':') {
+        while (++pos < fmt.size() && (dig = dig_v(fmt[pos])) < 10) { width = 10 * width + dig; }
+        if (pos < fmt.size() && fmt[pos] != '}') { type = fmt[pos++]; }
+    }
+    return pos < fmt.size() && fmt[pos] == '}' ? pos + 1 : npos;
+}
+
+#if defined(UXS_HAS_CONSTEVAL)
+template<typename CharT>
+constexpr void check_scan_format(std::basic_string_view<CharT> fmt, est::span<const scan_arg_type> arg_types) {
+    std::size_t next_arg_id = 0;
+    bool manual_indexing = false;
+    for (std::size_t pos = 0; pos < fmt.size();) {
+        const CharT ch = fmt[pos++];
+        if (ch == '}') {
+            if (pos == fmt.size() || fmt[pos++] != '}') { throw format_error("invalid specifier syntax"); }
+        } else if (ch == '{') {
+            if (pos < fmt.size() && fmt[pos] == '{') {
+                ++pos;
+                continue;
+            }
+            std::size_t arg_id = unspecified_size, width = 0;
+            CharT type = 0;
+            pos = parse_scan_field(fmt, pos, arg_id, width, type);
+            if (pos == std::basic_string_view<CharT>::npos) { throw format_error("invalid specifier syntax"); }
+            if (arg_id == unspecified_size) {
+                if (manual_indexing) { throw format_error("automatic argument indexing error"); }
+                arg_id = next_arg_id++;
+            } else if (next_arg_id) {
+                throw format_error("manual argument indexing error");
+            } else {
+                manual_indexing = true;
+            }
+            if (arg_id >= arg_types.size()) { throw format_error("out of argument list"); }
+            if (!is_valid_scan_type(arg_types[arg_id], type)) { throw format_error("unacceptable type specifier"); }
+        }
+    }
+}
+#endif  // defined(UXS_HAS_CONSTEVAL)
+
+}  // namespace detail
+
+template<typename CharT, typename... Args>
+class basic_scan_string {
+ public:
+    using char_type = CharT;
+    template<typename Ty,
+             typename = std::enable_if_t<std::is_convertible<const Ty&, std::basic_string_view<char_type>>::value>>
+    UXS_CONSTEVAL basic_scan_string(const Ty& fmt) noexcept : fmt_(fmt) {
+#if defined(UXS_HAS_CONSTEVAL)
+        constexpr std::array<detail::scan_arg_type, sizeof...(Args)> arg_types{
+            detail::scan_arg_type_index<Args, char_type>::value...};
+        detail::check_scan_format<char_type>(fmt_, est::as_span(arg_types.data(), arg_types.size()));
+#endif  // defined(UXS_HAS_CONSTEVAL)
+    }
+    UXS_CONSTEXPR basic_scan_string(basic_runtime_format<CharT> fmt) noexcept : fmt_(fmt.str) {}
+    UXS_CONSTEXPR std::basic_string_view<char_type> get() const noexcept { return fmt_; }
+
+ private:
+    std::basic_string_view<char_type> fmt_;
+};
+
+template<typename... Args>
+using scan_string = basic_scan_string<char, est::type_identity_t<Args>...>;
+template<typename... Args>
+using wscan_string = basic_scan_string<wchar_t, est::type_identity_t<Args>...>;
+
+// Reads values according to the format string. Fields are separated like `scanf` does:
+// - white space in format string matches any amount of white space in input, including none;
+// - white space is skipped before each field, except of `{:c}` fields;
+// - a field is the longest sequence of characters which can be a part of a value of argument type,
+//   and it must be converted completely; field width limits the number of characters.
+// Supported argument types are `bool`, the character type, integers, floating-point numbers,
+// `std::basic_string` and, for string input only, `std::basic_string_view` referencing the input
+template<typename CharT>
+UXS_EXPORT scan_result vscan(std::basic_string_view<CharT> s, std::basic_string_view<CharT> fmt,
+                             est::span<const detail::scan_arg> args);
+
+// Values are read directly from the buffer window; only fields that cross window boundaries are copied
+template<typename CharT>
+UXS_EXPORT scan_result vscan(basic_ibuf<CharT>& in, std::basic_string_view<CharT> fmt,
+                             est::span<const detail::scan_arg> args);
+
+template<typename... Args>
+scan_result scan(std::string_view s, scan_string<Args...> fmt, Args&... args) {
+    const std::array<detail::scan_arg, sizeof...(Args)> arg_list{detail::make_scan_arg<char>(args)...};
+    return vscan(s, fmt.get(), est::as_span(arg_list.data(), arg_list.size()));
+}
+
+template<typename... Args>
+scan_result scan(std::wstring_view s, wscan_string<Args...> fmt, Args&... args) {
+    const std::array<detail::scan_arg, sizeof...(Args)> arg_list{detail::make_scan_arg<wchar_t>(args)...};
+    return vscan(s, fmt.get(), est::as_span(arg_list.data(), arg_list.size()));
+}
+
+template<typename... Args>
+scan_result scan(ibuf& in, scan_string<Args...> fmt, Args&... args) {
+    static_assert(std::conjunction<std::negation<std::is_same<Args, std::string_view>>...>::value,
+                  "string views can't reference buffered input");
+    const std::array<detail::scan_arg, sizeof...(Args)> arg_list{detail::make_scan_arg<char>(args)...};
+    return vscan(in, fmt.get(), est::as_span(arg_list.data(), arg_list.size()));
+}
+
+template<typename... Args>
+scan_result scan(wibuf& in, wscan_string<Args...> fmt, Args&... args) {
+    static_assert(std::conjunction<std::negation<std::is_same<Args, std::wstring_view>>...>::value,
+                  "string views can't reference buffered input");
+    const std::array<detail::scan_arg, sizeof...(Args)> arg_list{detail::make_scan_arg<wchar_t>(args)...};
+    return vscan(in, fmt.get(), est::as_span(arg_list.data(), arg_list.size()));
+}
+
+}  // namespace uxs
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "function_call_iterator.h"
+#include "span.h"
 #include "string_util.h"
 
 #include <algorithm>
@@ -13,6 +14,63 @@ UXS_IMPLEMENT_BITWISE_OPS_FOR_ENUM(split_opts);
 
 namespace detail {
 
+// Vectorized searching; characters following `\\` are skipped by `*_unescaped` functions
+UXS_EXPORT const char* find_char_unescaped(const char* first, const char* last, char ch) noexcept;
+UXS_EXPORT const char* find_char_of_unescaped(const char* first, const char* last, std::string_view chars) noexcept;
+UXS_EXPORT const char* find_substring(const char* first, const char* last, std::string_view s) noexcept;
+
+template<typename Iter, typename CharT, typename Traits>
+Iter find_char_unescaped(Iter first, Iter last, CharT ch, Traits) {
+    for (; first != last; ++first) {
+        if (Traits::eq(*first, '\\')) {
+            if (++first == last) { break; }
+        } else if (Traits::eq(*first, ch)) {
+            return first;
+        }
+    }
+    return last;
+}
+
+template<typename Iter>
+Iter find_char_unescaped(Iter first, Iter last, char ch, std::char_traits<char>) {
+    if (first == last) { return last; }
+    const char* p = std::addressof(*first);
+    return first + (find_char_unescaped(p, p + (last - first), ch) - p);
+}
+
+template<typename Iter, typename CharT, typename Traits>
+Iter find_char_of_unescaped(Iter first, Iter last, std::basic_string_view<CharT, Traits> chars, Traits) {
+    for (; first != last; ++first) {
+        if (Traits::eq(*first, '\\')) {
+            if (++first == last) { break; }
+        } else if (Traits::find(chars.data(), chars.size(), *first)) {
+            return first;
+        }
+    }
+    return last;
+}
+
+template<typename Iter>
+Iter find_char_of_unescaped(Iter first, Iter last, std::string_view chars, std::char_traits<char>) {
+    if (first == last) { return last; }
+    const char* p = std::addressof(*first);
+    return first + (find_char_of_unescaped(p, p + (last - first), chars) - p);
+}
+
+template<typename Iter, typename CharT, typename Traits>
+Iter find_substring(Iter first, Iter last, std::basic_string_view<CharT, Traits> s, Traits) {
+    for (Iter last_pos = last - s.size() + 1; first != last_pos; ++first) {
+        if (std::equal(s.begin(), s.end(), first, Traits::eq)) { return first; }
+    }
+    return last;
+}
+
+template<typename Iter>
+Iter find_substring(Iter first, Iter last, std::string_view s, std::char_traits<char>) {
+    const char* p = std::addressof(*first);
+    return first + (find_substring(p, p + (last - first), s) - p);
+}
+
 template<typename CharT, typename Traits>
 struct string_finder {
     CharT ch;
@@ -20,14 +78,21 @@ struct string_finder {
     using iterator = typename std::basic_string_view<CharT, Traits>::const_iterator;
     explicit string_finder(CharT tgt) : ch(tgt) {}
     std::pair<iterator, iterator> operator()(iterator begin, iterator end) const {
-        for (; begin != end; ++begin) {
-            if (Traits::eq(*begin, '\\')) {
-                if (++begin == end) { break; }
-            } else if (Traits::eq(*begin, ch)) {
-                return std::make_pair(begin, begin + 1);
-            }
-        }
-        return std::make_pair(end, end);
+        begin = find_char_unescaped(begin, end, ch, Traits{});
+        return std::make_pair(begin, begin != end ? begin + 1 : end);
+    }
+};
+
+// Finds any of the characters
+template<typename CharT, typename Traits>
+struct char_set_finder {
+    std::basic_string_view<CharT, Traits> chars;
+    using is_finder = int;
+    using iterator = typename std::basic_string_view<CharT, Traits>::const_iterator;
+    explicit char_set_finder(std::basic_string_view<CharT, Traits> tgt) : chars(tgt) {}
+    std::pair<iterator, iterator> operator()(iterator begin, iterator end) const {
+        begin = find_char_of_unescaped(begin, end, chars, Traits{});
+        return std::make_pair(begin, begin != end ? begin + 1 : end);
     }
 };
 
@@ -57,10 +122,8 @@ struct string_finder<std::basic_string_view<CharT, Traits>, Traits> {
     std::pair<iterator, iterator> operator()(iterator begin, iterator end) const {
         if (static_cast<std::size_t>(end - begin) < s.size()) { return std::make_pair(end, end); }
         if (!s.size()) { return std::make_pair(begin, begin); }
-        for (iterator last = end - s.size() + 1; begin != last; ++begin) {
-            if (std::equal(s.begin(), s.end(), begin, Traits::eq)) { return std::make_pair(begin, begin + s.size()); }
-        }
-        return std::make_pair(end, end);
+        begin = find_substring(begin, end, s, Traits{});
+        return std::make_pair(begin, begin != end ? begin + s.size() : end);
     }
 };
 
@@ -96,6 +159,10 @@ inline detail::reversed_string_finder<std::string_view, std::char_traits<char>>
     return detail::reversed_string_finder<std::string_view, std::char_traits<char>>(s);
 }
 
+inline detail::char_set_finder<char, std::char_traits<char>> sfinder_any_of(std::string_view chars) {
+    return detail::char_set_finder<char, std::char_traits<char>>(chars);
+}
+
 inline detail::string_finder<wchar_t, std::char_traits<wchar_t>> sfinder(wchar_t ch) {
     return detail::string_finder<wchar_t, std::char_traits<wchar_t>>(ch);
 }
@@ -108,6 +175,9 @@ inline detail::string_finder<std::wstring_view, std::char_traits<wchar_t>> sfind
 inline detail::reversed_string_finder<std::wstring_view, std::char_traits<wchar_t>> rsfinder(std::wstring_view s) {
     return detail::reversed_string_finder<std::wstring_view, std::char_traits<wchar_t>>(s);
 }
+inline detail::char_set_finder<wchar_t, std::char_traits<wchar_t>> sfinder_any_of(std::wstring_view chars) {
+    return detail::char_set_finder<wchar_t, std::char_traits<wchar_t>>(chars);
+}
 
 // --------------------------
 
@@ -214,6 +284,70 @@ auto split_string(std::wstring_view s, Finder finder,
 
 // --------------------------
 
+// Lazy version of `split_string`: tokens are found on demand while iterating;
+// iterators refer to the view, so the view must outlive them
+template<typename CharT, typename Traits, typename Finder, split_opts opts>
+class basic_split_view {
+ public:
+    using value_type = std::basic_string_view<CharT, Traits>;
+
+    class iterator : public iterator_facade<iterator, value_type, std::forward_iterator_tag, const value_type&,
+                                            const value_type*> {
+     public:
+        iterator() = default;
+        explicit iterator(const basic_split_view& v) : v_(&v), next_(v.s_.begin()) { increment(); }
+
+        void increment() {
+            uxs_iterator_assert(v_);
+            while (!is_last_) {
+                const auto sub = v_->finder_(next_, v_->s_.end());
+                token_ = v_->s_.substr(next_ - v_->s_.begin(), sub.first - next_);
+                is_last_ = sub.first == v_->s_.end();
+                next_ = sub.second;
+                if (!(opts & split_opts::skip_empty) || !token_.empty()) { return; }
+            }
+            v_ = nullptr;
+        }
+
+        const value_type& dereference() const {
+            uxs_iterator_assert(v_);
+            return token_;
+        }
+
+        bool is_equal_to(const iterator& it) const {
+            return v_ == it.v_ && (!v_ || token_.data() == it.token_.data());
+        }
+
+     private:
+        const basic_split_view* v_ = nullptr;
+        typename value_type::const_iterator next_{};
+        value_type token_;
+        bool is_last_ = false;
+    };
+
+    using const_iterator = iterator;
+
+    basic_split_view(value_type s, Finder finder) : s_(s), finder_(std::move(finder)) {}
+    iterator begin() const { return iterator(*this); }
+    iterator end() const { return iterator(); }
+
+ private:
+    value_type s_;
+    Finder finder_;
+};
+
+template<split_opts opts = split_opts::no_opts, typename Finder, typename = std::void_t<typename Finder::is_finder>>
+basic_split_view<char, std::char_traits<char>, Finder, opts> split_view(std::string_view s, Finder finder) {
+    return basic_split_view<char, std::char_traits<char>, Finder, opts>(s, std::move(finder));
+}
+
+template<split_opts opts = split_opts::no_opts, typename Finder, typename = std::void_t<typename Finder::is_finder>>
+basic_split_view<wchar_t, std::char_traits<wchar_t>, Finder, opts> split_view(std::wstring_view s, Finder finder) {
+    return basic_split_view<wchar_t, std::char_traits<wchar_t>, Finder, opts>(s, std::move(finder));
+}
+
+// --------------------------
+
 template<split_opts opts, typename CharT, typename Traits, typename Finder>
 est::type_identity_t<std::basic_string_view<CharT, Traits>, typename Finder::is_finder> basic_string_section(
     std::basic_string_view<CharT, Traits> s, Finder finder, std::size_t start,
@@ -343,6 +477,97 @@ auto string_to_words(std::wstring_view s, wchar_t sep,
 
 // --------------------------
 
+// Lazy version of `string_to_words`; iterators refer to the view, so the view must outlive them
+template<typename CharT, typename Traits>
+class basic_words_view {
+ public:
+    using value_type = std::basic_string_view<CharT, Traits>;
+
+    class iterator : public iterator_facade<iterator, value_type, std::forward_iterator_tag, const value_type&,
+                                            const value_type*> {
+     public:
+        iterator() = default;
+        explicit iterator(const basic_words_view& v) : v_(&v), next_(v.s_.begin()) { increment(); }
+
+        void increment() {
+            uxs_iterator_assert(v_);
+            const auto end = v_->s_.end();
+            if (is_last_) {
+                v_ = nullptr;
+                return;
+            }
+            for (auto p = next_;; ++p) {
+                while (p != end && is_space(*p)) { ++p; }  // skip spaces
+                auto p0 = p;
+                if (p == end) {
+                    if (state_ != state_t::sep_found) {
+                        v_ = nullptr;
+                        return;
+                    }
+                } else {
+                    const state_t prev_state = state_;
+                    do {  // find separator or blank
+                        if (*p == '\\') {
+                            if (++p == end) { break; }
+                        } else if (is_space(*p)) {
+                            state_ = state_t::skip_sep;
+                            break;
+                        } else if (*p == v_->sep_) {
+                            state_ = state_t::sep_found;
+                            break;
+                        }
+                    } while (++p != end);
+                    if (p == p0 && prev_state == state_t::skip_sep) { continue; }
+                }
+                token_ = v_->s_.substr(p0 - v_->s_.begin(), p - p0);
+                if (p == end) {
+                    is_last_ = true;
+                } else {
+                    next_ = p + 1;
+                }
+                return;
+            }
+        }
+
+        const value_type& dereference() const {
+            uxs_iterator_assert(v_);
+            return token_;
+        }
+
+        bool is_equal_to(const iterator& it) const {
+            return v_ == it.v_ && (!v_ || token_.data() == it.token_.data());
+        }
+
+     private:
+        enum class state_t { start = 0, sep_found, skip_sep };
+        const basic_words_view* v_ = nullptr;
+        typename value_type::const_iterator next_{};
+        value_type token_;
+        state_t state_ = state_t::start;
+        bool is_last_ = false;
+    };
+
+    using const_iterator = iterator;
+
+    basic_words_view(value_type s, CharT sep) : s_(s), sep_(sep) {}
+    iterator begin() const { return iterator(*this); }
+    iterator end() const { return iterator(); }
+
+ private:
+    value_type s_;
+    CharT sep_;
+};
+
+inline basic_words_view<char, std::char_traits<char>> words_view(std::string_view s, char sep) {
+    return basic_words_view<char, std::char_traits<char>>(s, sep);
+}
+
+inline basic_words_view<wchar_t, std::char_traits<wchar_t>> words_view(std::wstring_view s, wchar_t sep) {
+    return basic_words_view<wchar_t, std::char_traits<wchar_t>>(s, sep);
+}
+
+// --------------------------
+
 template<typename StrTy, typename Range, typename InputFn = nofunc>
 StrTy& pack_basic_strings(StrTy& s, const Range& r, typename StrTy::value_type sep, InputFn fn = InputFn{}) {
     if (std::begin(r) != std::end(r)) {
@@ -460,6 +685,9 @@ UXS_EXPORT std::vector<std::string> unpack_strings(std::string_view s, char sep)
 UXS_EXPORT std::string encode_escapes(std::string_view s, std::string_view symb, std::string_view code);
 UXS_EXPORT std::string decode_escapes(std::string_view s, std::string_view symb, std::string_view code);
 UXS_EXPORT int compare_strings_nocase(std::string_view lhs, std::string_view rhs);
+UXS_EXPORT std::size_t hash_string_nocase(std::string_view s) noexcept;
+UXS_EXPORT void to_lower_inplace(est::span<char> s) noexcept;
+UXS_EXPORT void to_upper_inplace(est::span<char> s) noexcept;
 UXS_EXPORT std::string to_lower(std::string_view s);
 UXS_EXPORT std::string to_upper(std::string_view s);
 
@@ -468,6 +696,9 @@ UXS_EXPORT std::vector<std::wstring> unpack_strings(std::wstring_view s, wchar_t
 UXS_EXPORT std::wstring encode_escapes(std::wstring_view s, std::wstring_view symb, std::wstring_view code);
 UXS_EXPORT std::wstring decode_escapes(std::wstring_view s, std::wstring_view symb, std::wstring_view code);
 UXS_EXPORT int compare_strings_nocase(std::wstring_view lhs, std::wstring_view rhs);
+UXS_EXPORT std::size_t hash_string_nocase(std::wstring_view s) noexcept;
+UXS_EXPORT void to_lower_inplace(est::span<wchar_t> s) noexcept;
+UXS_EXPORT void to_upper_inplace(est::span<wchar_t> s) noexcept;
 UXS_EXPORT std::wstring to_lower(std::wstring_view s);
 UXS_EXPORT std::wstring to_upper(std::wstring_view s);
 
@@ -501,6 +732,21 @@ struct less_nocase<void> {
     }
 };
 
+// Hash function consistent with `equal_to_nocase`
+template<typename Ty = void>
+struct hash_nocase {
+    std::size_t operator()(const Ty& s) const { return hash_string_nocase(s); }
+};
+
+template<>
+struct hash_nocase<void> {
+    using is_transparent = int;
+    template<typename Ty>
+    std::size_t operator()(const Ty& s) const {
+        return hash_string_nocase(s);
+    }
+};
+
 template<typename StrTy, typename Func = nofunc>
 is_equal_to_predicate<StrTy, Func, equal_to_nocase<>> is_equal_to_nocase(const StrTy& s, const Func& fn = Func{}) {
     return is_equal_to_predicate<StrTy, Func, equal_to_nocase<>>(s, fn);
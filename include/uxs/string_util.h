@@ -66,8 +66,18 @@ struct utf_string_adapter<char> {
     }
     template<typename StrTy>
     void append(StrTy& out, std::wstring_view s) const {
-        std::uint32_t code = 0;
-        for (auto p = s.begin(); from_wchar(p, s.end(), p, code) != 0;) { to_utf8(code, std::back_inserter(out)); }
+        enum : unsigned { chunk_size = 64 };
+        char buf[max_utf8_from_wchars(chunk_size)];
+        const wchar_t *first = s.data(), *last = first + s.size();
+        while (first != last) {
+            const wchar_t* chunk_last = last - first > chunk_size ? first + chunk_size : last;
+#if WCHAR_MAX <= 0xffff
+            // do not split surrogate pair
+            if (chunk_last != last && (*(chunk_last - 1) & 0xfc00) == 0xd800) { --chunk_last; }
+#endif  // WCHAR_MAX <= 0xffff
+            out.append(buf, from_wchars_to_utf8(first, chunk_last, buf) - buf);
+            first = chunk_last;
+        }
     }
 };
 template<>
@@ -78,8 +88,15 @@ struct utf_string_adapter<wchar_t> {
     std::wstring operator()(std::string_view s) const { return from_utf8_to_wide(s); }
     template<typename StrTy>
     void append(StrTy& out, std::string_view s) const {
-        std::uint32_t code = 0;
-        for (auto p = s.begin(); from_utf8(p, s.end(), p, code) != 0;) { to_wchar(code, std::back_inserter(out)); }
+        enum : unsigned { chunk_size = 256 };
+        wchar_t buf[max_wchars_from_utf8(chunk_size)];
+        const char *first = s.data(), *last = first + s.size();
+        while (first != last) {
+            const char* chunk_last = last - first > chunk_size ? utf8_sequence_boundary(first, first + chunk_size) :
+                                                                 last;
+            out.append(buf, from_utf8_to_wchars(first, chunk_last, buf) - buf);
+            first = chunk_last;
+        }
     }
     template<typename StrTy>
     void append(StrTy& out, std::wstring_view s) const {
@@ -6,6 +6,7 @@
 #include <cstring>
 #include <locale>
 #include <stdexcept>
+#include <vector>
 
 namespace uxs {
 
@@ -141,6 +142,15 @@ class basic_membuffer {
 using membuffer = basic_membuffer<char>;
 using wmembuffer = basic_membuffer<wchar_t>;
 
+namespace detail {
+// Page blocks for large dynamic buffers of trivial elements; `sz` is rounded up to the page size,
+// `realloc_dynbuffer_pages` keeps the contents; allocation functions throw `std::bad_alloc` on failure
+enum : std::size_t { dynbuffer_page_size = 0x200000 };
+UXS_EXPORT void* alloc_dynbuffer_pages(std::size_t& sz);
+UXS_EXPORT void* realloc_dynbuffer_pages(void* p, std::size_t old_sz, std::size_t& new_sz);
+UXS_EXPORT void free_dynbuffer_pages(void* p, std::size_t sz) noexcept;
+}  // namespace detail
+
 template<typename Ty, typename Alloc>
 class basic_dynbuffer : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>, public basic_membuffer<Ty> {
  private:
@@ -158,7 +168,11 @@ class basic_dynbuffer : protected std::allocator_traits<Alloc>::template rebind_
     using difference_type = typename basic_membuffer<Ty>::difference_type;
 
     ~basic_dynbuffer() override {
-        if (is_allocated_) { this->deallocate(first_, capacity()); }
+        if (storage_ == storage_type::allocated) {
+            this->deallocate(first_, capacity());
+        } else if (storage_ == storage_type::pages) {
+            detail::free_dynbuffer_pages(first_, capacity() * sizeof(Ty));
+        }
     }
 
     bool empty() const noexcept { return first_ == this->curr(); }
@@ -187,16 +201,40 @@ class basic_dynbuffer : protected std::allocator_traits<Alloc>::template rebind_
             delta_sz = std::max(extra, max_avail >> 1);
         }
         sz += delta_sz;
+        if (use_pages::value && sz >= pages_threshold / sizeof(Ty)) { return grow_pages(sz); }
         Ty* first = this->allocate(sz);
         this->set(std::copy(first_, this->curr(), first), first + sz);
-        if (is_allocated_) { this->deallocate(first_, cap); }
-        first_ = first, is_allocated_ = true;
+        if (storage_ == storage_type::allocated) { this->deallocate(first_, cap); }
+        first_ = first, storage_ = storage_type::allocated;
         return this->avail();
     }
 
  private:
+    enum class storage_type : std::uint8_t { not_allocated = 0, allocated, pages };
+
+    // Large buffers of trivial elements are allocated in pages, which are remapped on growth without copying
+    using use_pages = std::integral_constant<bool, std::is_trivially_copyable<Ty>::value &&
+                                                       std::is_same<alloc_type, std::allocator<Ty>>::value>;
+    enum : std::size_t { pages_threshold = detail::dynbuffer_page_size };
+
     Ty* first_;
-    bool is_allocated_ = false;
+    storage_type storage_ = storage_type::not_allocated;
+
+    size_type grow_pages(size_type sz) {
+        std::size_t sz_bytes = sz * sizeof(Ty);
+        const size_type size = this->size();
+        Ty* first;
+        if (storage_ == storage_type::pages) {
+            first = static_cast<Ty*>(detail::realloc_dynbuffer_pages(first_, capacity() * sizeof(Ty), sz_bytes));
+        } else {
+            first = static_cast<Ty*>(detail::alloc_dynbuffer_pages(sz_bytes));
+            std::copy(first_, this->curr(), first);
+            if (storage_ == storage_type::allocated) { this->deallocate(first_, capacity()); }
+        }
+        this->set(first + size, first + sz_bytes / sizeof(Ty));
+        first_ = first, storage_ = storage_type::pages;
+        return this->avail();
+    }
 };
 
 template<typename Ty, std::size_t InlineBufSize = 0, typename Alloc = std::allocator<Ty>>
@@ -238,6 +276,139 @@ class basic_membuffer_with_size_tracker final : public basic_membuffer<Ty> {
 using membuffer_with_size_tracker = basic_membuffer_with_size_tracker<char>;
 using wmembuffer_with_size_tracker = basic_membuffer_with_size_tracker<wchar_t>;
 
+// Counts characters without storing them; long appends are counted without copying
+template<typename Ty>
+class basic_membuffer_size_counter final : public basic_membuffer<Ty> {
+ public:
+    basic_membuffer_size_counter() noexcept : basic_membuffer<Ty>(buf_, buf_ + block_size) {}
+    std::size_t size() const noexcept { return size_ + (this->curr() - buf_); }
+
+ private:
+    enum : unsigned { block_size = 256 / sizeof(Ty) };
+    Ty buf_[block_size];
+    std::size_t size_ = 0;
+
+    std::size_t try_grow(std::size_t extra) override {
+        size_ += this->curr() - buf_;
+        this->set(buf_);
+        if (extra <= block_size) { return block_size; }
+        size_ += extra;
+        return 0;
+    }
+};
+
+using membuffer_size_counter = basic_membuffer_size_counter<char>;
+using wmembuffer_size_counter = basic_membuffer_size_counter<wchar_t>;
+
+namespace detail {
+template<typename Container, typename Ty>
+struct is_contiguous_container : std::false_type {};
+template<typename Ty, typename Traits, typename Alloc>
+struct is_contiguous_container<std::basic_string<Ty, Traits, Alloc>, Ty> : std::true_type {};
+template<typename Ty, typename Alloc>
+struct is_contiguous_container<std::vector<Ty, Alloc>, Ty> : std::true_type {};
+}  // namespace detail
+
+// Writes through output iterator in blocks; not more than `limit` characters are written,
+// and the rest is only counted. `flush()` must be called to write the last block
+template<typename Ty, typename OutputIt, typename = void>
+class basic_iterator_membuffer final : public basic_membuffer<Ty> {
+ public:
+    explicit basic_iterator_membuffer(OutputIt out, std::size_t limit = std::numeric_limits<std::size_t>::max())
+        : basic_membuffer<Ty>(buf_, buf_ + std::min<std::size_t>(limit, block_size)), out_(std::move(out)),
+          limit_(limit) {}
+
+    // Total size of the text, including not written characters
+    std::size_t size() const noexcept { return size_ + (this->curr() - buf_); }
+
+    OutputIt flush() {
+        const std::size_t n = this->curr() - buf_;
+        out_ = std::copy_n(buf_, n, std::move(out_));
+        size_ += n;
+        this->set(buf_, buf_ + std::min<std::size_t>(limit_ - std::min(size_, limit_), block_size));
+        return out_;
+    }
+
+ private:
+    enum : unsigned { block_size = 256 / sizeof(Ty) };
+    OutputIt out_;
+    std::size_t limit_;
+    std::size_t size_ = 0;
+    Ty buf_[block_size];
+
+    std::size_t try_grow(std::size_t extra) override {
+        flush();
+        if (this->avail()) { return this->avail(); }
+        size_ += extra;
+        return 0;
+    }
+};
+
+// Writes directly to the tail of `std::basic_string` or `std::vector`; the container is grown as needed
+// and trimmed to the written text by `flush()` or the destructor
+template<typename Ty, typename Container>
+class basic_iterator_membuffer<Ty, std::back_insert_iterator<Container>,
+                               std::enable_if_t<detail::is_contiguous_container<Container, Ty>::value>>
+    final : public basic_membuffer<Ty> {
+ public:
+    explicit basic_iterator_membuffer(std::back_insert_iterator<Container> out,
+                                      std::size_t limit = std::numeric_limits<std::size_t>::max()) noexcept
+        : basic_membuffer<Ty>(nullptr, nullptr), out_(out), container_(get_container(out)),
+          offset_(container_.size()), limit_(limit) {}
+    ~basic_iterator_membuffer() override { trim(); }
+
+    // Total size of the text, including not written characters
+    std::size_t size() const noexcept { return n_skipped_ + (this->curr() - first_); }
+
+    std::back_insert_iterator<Container> flush() noexcept {
+        trim();
+        return out_;
+    }
+
+ private:
+    enum : unsigned { min_grow_size = 256 / sizeof(Ty) };
+    std::back_insert_iterator<Container> out_;
+    Container& container_;
+    std::size_t offset_;
+    std::size_t limit_;
+    std::size_t n_skipped_ = 0;
+    Ty* first_ = nullptr;
+
+    static Container& get_container(std::back_insert_iterator<Container> out) noexcept {
+        struct accessor : std::back_insert_iterator<Container> {
+            explicit accessor(std::back_insert_iterator<Container> out) : std::back_insert_iterator<Container>(out) {}
+            Container& get() const noexcept { return *this->container; }
+        };
+        return accessor(out).get();
+    }
+
+    void trim() noexcept {
+        const std::size_t sz = this->curr() - first_;
+        container_.resize(offset_ + sz);  // doesn't reallocate
+        if (!sz) { return; }
+        first_ = &container_[offset_];
+        this->set(first_ + sz, first_ + sz);
+    }
+
+    std::size_t try_grow(std::size_t extra) override {
+        const std::size_t sz = this->curr() - first_;
+        if (sz == limit_) {
+            n_skipped_ += extra;
+            return 0;
+        }
+        const std::size_t delta_sz = std::min(std::max({extra, sz, std::size_t(min_grow_size)}), limit_ - sz);
+        container_.resize(offset_ + sz + delta_sz);
+        first_ = &container_[offset_];
+        this->set(first_ + sz, first_ + sz + delta_sz);
+        return delta_sz;
+    }
+};
+
+template<typename OutputIt>
+using iterator_membuffer = basic_iterator_membuffer<char, OutputIt>;
+template<typename OutputIt>
+using iterator_wmembuffer = basic_iterator_membuffer<wchar_t, OutputIt>;
+
 // --------------------------
 
 enum class fmt_flags : unsigned {
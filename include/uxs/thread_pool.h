@@ -0,0 +1,44 @@
+#pragma once
+
+#include "utility.h"
+
+#include <memory>
+
+namespace uxs {
+
+// Work-stealing thread pool for fork-join loops: each worker has its own task queue, it takes the latest
+// pushed tasks from its queue and steals the earliest (and so the largest) tasks from queues of other workers.
+// The calling thread takes part in the work, so the pool of `n` threads has `n - 1` worker threads.
+// Loops can be nested: a loop started from a task is processed by the same pool
+class thread_pool {
+ public:
+    // `thread_count == 0` means the number of hardware threads
+    UXS_EXPORT explicit thread_pool(unsigned thread_count = 0);
+    UXS_EXPORT ~thread_pool();
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    UXS_EXPORT unsigned concurrency() const noexcept;
+
+    // The pool used by parallel algorithms
+    UXS_EXPORT static thread_pool& instance();
+
+    // Calls `func(first, last)` for disjoint subranges covering `[0, count)`: ranges longer than `grain`
+    // are split in halves. Returns when all calls are finished; the first thrown exception is rethrown,
+    // and the rest of not yet started calls are skipped
+    template<typename Func>
+    void for_each_range(std::size_t count, std::size_t grain, Func&& func) {
+        run(count, grain, [](void* ctx, std::size_t first, std::size_t last) {
+            (*static_cast<std::remove_reference_t<Func>*>(ctx))(first, last);
+        }, static_cast<void*>(std::addressof(func)));
+    }
+
+ private:
+    struct impl;
+    std::unique_ptr<impl> impl_;
+
+    UXS_EXPORT void run(std::size_t count, std::size_t grain, void (*fn)(void*, std::size_t, std::size_t),
+                        void* ctx);
+};
+
+}  // namespace uxs
@@ -0,0 +1,230 @@
+#pragma once
+
+#include "iterator.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace uxs {
+
+namespace detail {
+
+//-----------------------------------------------------------------------------
+// Common front-end of ordered containers: `Derived` is the final container class, and `Tree` is its
+// implementation (`rbtree_unique`, `btree_multi`, ...). Final classes inherit constructors from it
+
+template<typename Derived, typename Tree>
+class tree_front_end : public Tree {
+ protected:
+    using super = Tree;
+    using alloc_traits = typename super::alloc_traits;
+    using alloc_type = typename super::alloc_type;
+
+ public:
+    using allocator_type = typename super::allocator_type;
+    using key_type = typename super::key_type;
+    using value_type = typename super::value_type;
+    using key_compare = typename super::key_compare;
+    using value_compare = std::conditional_t<std::is_same<key_type, value_type>::value, key_compare,
+                                             typename super::value_compare_func>;
+    using iterator = typename super::iterator;
+    using const_iterator = typename super::const_iterator;
+
+    tree_front_end() noexcept(noexcept(super())) : super() {}
+    explicit tree_front_end(const allocator_type& alloc) noexcept(noexcept(super(alloc))) : super(alloc) {}
+    explicit tree_front_end(const key_compare& comp, const allocator_type& alloc = allocator_type())
+        : super(comp, alloc) {}
+
+#if __cplusplus < 201703L
+    ~tree_front_end() = default;
+    tree_front_end(const tree_front_end&) = default;
+    tree_front_end& operator=(const tree_front_end&) = default;
+    tree_front_end(tree_front_end&& other) noexcept(noexcept(super(std::move(other)))) : super(std::move(other)) {}
+    tree_front_end& operator=(tree_front_end&& other) noexcept(std::is_nothrow_move_assignable<super>::value) {
+        super::operator=(std::move(other));
+        return *this;
+    }
+#endif  // __cplusplus < 201703L
+
+    tree_front_end(std::initializer_list<value_type> l, const allocator_type& alloc) : super(alloc) {
+        try {
+            this->insert_impl(l.begin(), l.end());
+        } catch (...) {
+            this->tidy();
+            throw;
+        }
+    }
+
+    tree_front_end(std::initializer_list<value_type> l, const key_compare& comp = key_compare(),
+                   const allocator_type& alloc = allocator_type())
+        : super(comp, alloc) {
+        try {
+            this->insert_impl(l.begin(), l.end());
+        } catch (...) {
+            this->tidy();
+            throw;
+        }
+    }
+
+    Derived& operator=(std::initializer_list<value_type> l) {
+        this->assign_range(l.begin(), l.end());
+        return static_cast<Derived&>(*this);
+    }
+
+    template<typename InputIt, typename = std::enable_if_t<is_input_iterator<InputIt>::value>>
+    tree_front_end(InputIt first, InputIt last, const allocator_type& alloc) : super(alloc) {
+        try {
+            this->insert_impl(first, last);
+        } catch (...) {
+            this->tidy();
+            throw;
+        }
+    }
+
+    template<typename InputIt, typename = std::enable_if_t<is_input_iterator<InputIt>::value>>
+    tree_front_end(InputIt first, InputIt last, const key_compare& comp = key_compare(),
+                   const allocator_type& alloc = allocator_type())
+        : super(comp, alloc) {
+        try {
+            this->insert_impl(first, last);
+        } catch (...) {
+            this->tidy();
+            throw;
+        }
+    }
+
+    tree_front_end(const Derived& other, const allocator_type& alloc) : super(other, alloc) {}
+    tree_front_end(Derived&& other, const allocator_type& alloc) noexcept(noexcept(super(std::move(other), alloc)))
+        : super(std::move(other), alloc) {}
+
+    void swap(Derived& other) noexcept(std::is_nothrow_swappable<key_compare>::value) {
+        if (std::addressof(other) == this) { return; }
+        this->swap_impl(other, typename alloc_traits::propagate_on_container_swap());
+    }
+
+    value_compare value_comp() const { return value_compare(this->get_compare()); }
+
+    friend bool operator==(const Derived& lhs, const Derived& rhs) {
+        if (lhs.size() != rhs.size()) { return false; }
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+    friend bool operator<(const Derived& lhs, const Derived& rhs) {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+    friend bool operator!=(const Derived& lhs, const Derived& rhs) { return !(lhs == rhs); }
+    friend bool operator<=(const Derived& lhs, const Derived& rhs) { return !(rhs < lhs); }
+    friend bool operator>(const Derived& lhs, const Derived& rhs) { return rhs < lhs; }
+    friend bool operator>=(const Derived& lhs, const Derived& rhs) { return !(lhs < rhs); }
+};
+
+// Front-end of maps with unique keys: adds element access by key
+template<typename Derived, typename Tree>
+class map_front_end : public tree_front_end<Derived, Tree> {
+ protected:
+    using super = tree_front_end<Derived, Tree>;
+
+ public:
+    using key_type = typename super::key_type;
+    using mapped_type = typename super::node_traits::mapped_type;
+    using key_compare = typename super::key_compare;
+    using iterator = typename super::iterator;
+    using const_iterator = typename super::const_iterator;
+
+    using super::super;
+    using super::operator=;
+
+    const mapped_type& at(const key_type& key) const {
+        auto it = this->find(key);
+        if (it != this->end()) { return it->second; }
+        throw std::out_of_range("invalid map key");
+    }
+
+    mapped_type& at(const key_type& key) {
+        auto it = this->find(key);
+        if (it != this->end()) { return it->second; }
+        throw std::out_of_range("invalid map key");
+    }
+
+    mapped_type& operator[](const key_type& key) { return this->try_emplace_impl(key).first->second; }
+    mapped_type& operator[](key_type&& key) { return this->try_emplace_impl(std::move(key)).first->second; }
+
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+        return this->try_emplace_impl(key, std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+        return this->try_emplace_impl(std::move(key), std::forward<Args>(args)...);
+    }
+
+    template<typename Key2, typename Comp_ = key_compare, typename... Args>
+    est::type_identity_t<std::pair<iterator, bool>, typename Comp_::is_transparent> try_emplace(Key2&& key,
+                                                                                                Args&&... args) {
+        return this->try_emplace_impl(std::forward<Key2>(key), std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    iterator try_emplace(const_iterator hint, const key_type& key, Args&&... args) {
+        return this->try_emplace_hint_impl(hint, key, std::forward<Args>(args)...).first;
+    }
+
+    template<typename... Args>
+    iterator try_emplace(const_iterator hint, key_type&& key, Args&&... args) {
+        return this->try_emplace_hint_impl(hint, std::move(key), std::forward<Args>(args)...).first;
+    }
+
+    template<typename Key2, typename Comp_ = key_compare, typename... Args>
+    est::type_identity_t<iterator, typename Comp_::is_transparent> try_emplace_hint(const_iterator hint, Key2&& key,
+                                                                                    Args&&... args) {
+        return this->try_emplace_hint_impl(hint, std::forward<Key2>(key), std::forward<Args>(args)...).first;
+    }
+
+    template<typename Ty2>
+    std::pair<iterator, bool> insert_or_assign(const key_type& key, Ty2&& obj) {
+        auto result = this->try_emplace_impl(key, std::forward<Ty2>(obj));
+        if (!result.second) { result.first->second = std::forward<Ty2>(obj); }
+        return result;
+    }
+
+    template<typename Ty2>
+    std::pair<iterator, bool> insert_or_assign(key_type&& key, Ty2&& obj) {
+        auto result = this->try_emplace_impl(std::move(key), std::forward<Ty2>(obj));
+        if (!result.second) { result.first->second = std::forward<Ty2>(obj); }
+        return result;
+    }
+
+    template<typename Key2, typename Ty2, typename Comp_ = key_compare>
+    est::type_identity_t<std::pair<iterator, bool>, typename Comp_::is_transparent> insert_or_assign(Key2&& key,
+                                                                                                     Ty2&& obj) {
+        auto result = this->try_emplace_impl(std::forward<Key2>(key), std::forward<Ty2>(obj));
+        if (!result.second) { result.first->second = std::forward<Ty2>(obj); }
+        return result;
+    }
+
+    template<typename Ty2>
+    iterator insert_or_assign(const_iterator hint, const key_type& key, Ty2&& obj) {
+        auto result = this->try_emplace_hint_impl(hint, key, std::forward<Ty2>(obj));
+        if (!result.second) { result.first->second = std::forward<Ty2>(obj); }
+        return result.first;
+    }
+
+    template<typename Ty2>
+    iterator insert_or_assign(const_iterator hint, key_type&& key, Ty2&& obj) {
+        auto result = this->try_emplace_hint_impl(hint, std::move(key), std::forward<Ty2>(obj));
+        if (!result.second) { result.first->second = std::forward<Ty2>(obj); }
+        return result.first;
+    }
+
+    template<typename Key2, typename Ty2, typename Comp_ = key_compare>
+    est::type_identity_t<iterator, typename Comp_::is_transparent> insert_or_assign(const_iterator hint, Key2&& key,
+                                                                                    Ty2&& obj) {
+        auto result = this->try_emplace_hint_impl(hint, std::forward<Key2>(key), std::forward<Ty2>(obj));
+        if (!result.second) { result.first->second = std::forward<Ty2>(obj); }
+        return result.first;
+    }
+};
+
+}  // namespace detail
+
+}  // namespace uxs
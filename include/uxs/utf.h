@@ -79,25 +79,25 @@ unsigned to_utf16(std::uint32_t code, OutputIt out, std::size_t n = std::numeric
 #if WCHAR_MAX > 0xffff
 template<typename InputIt>
 unsigned from_wchar(InputIt first, InputIt last, InputIt& next, std::uint32_t& code) {
-    return from_utf16(first, last, next, code);
+    if (first == last) { return 0; }
+    code = static_cast<std::uint32_t>(*first++);
+    next = first;
+    return 1;
 }
 template<typename OutputIt>
 unsigned to_wchar(std::uint32_t code, OutputIt out, std::size_t n = std::numeric_limits<std::size_t>::max()) {
-    return to_utf16(code, out, n);
+    if (n == 0) { return 0; }
+    *out++ = static_cast<wchar_t>(code);
+    return 1;
 }
 #else   // WCHAR_MAX > 0xffff
 template<typename InputIt>
 unsigned from_wchar(InputIt first, InputIt last, InputIt& next, std::uint32_t& code) {
-    if (first == last) { return 0; }
-    code = static_cast<std::uint32_t>(*first++);
-    next = first;
-    return 1;
+    return from_utf16(first, last, next, code);
 }
 template<typename OutputIt>
 unsigned to_wchar(std::uint32_t code, OutputIt out, std::size_t n = std::numeric_limits<std::size_t>::max()) {
-    if (n == 0) { return 0; }
-    *out++ = code;
-    return 1;
+    return to_utf16(code, out, n);
 }
 #endif  // WCHAR_MAX > 0xffff
 
@@ -145,6 +145,29 @@ struct utf_encoder<wchar_t> {
     }
 };
 
+// Bulk conversions of contiguous sequences: the result is the same as of code point by code point
+// conversion, but runs of ASCII characters are processed by blocks. Output buffer must have room for
+// `max_wchars_from_utf8(last - first)` or `max_utf8_from_wchars(last - first)` characters
+inline UXS_CONSTEXPR std::size_t max_wchars_from_utf8(std::size_t n) { return n; }
+inline UXS_CONSTEXPR std::size_t max_utf8_from_wchars(std::size_t n) { return (WCHAR_MAX > 0xffff ? 4 : 3) * n; }
+UXS_EXPORT wchar_t* from_utf8_to_wchars(const char* first, const char* last, wchar_t* out) noexcept;
+UXS_EXPORT char* from_wchars_to_utf8(const wchar_t* first, const wchar_t* last, char* out) noexcept;
+
+// Returns the first byte, which does not start a well-formed UTF-8 sequence, or `last`; unlike `from_utf8`,
+// overlong encodings are rejected as well as surrogates and code points above 0x10FFFF
+UXS_EXPORT const char* find_invalid_utf8(const char* first, const char* last) noexcept;
+inline bool is_valid_utf8(const char* first, const char* last) noexcept {
+    return find_invalid_utf8(first, last) == last;
+}
+
+// Returns a position not greater than `last`, which does not split a multibyte sequence
+inline const char* utf8_sequence_boundary(const char* first, const char* last) noexcept {
+    for (const char* p = last; p != first && last - p < 4; --p) {
+        if ((*(p - 1) & 0xc0) != 0x80) { return (*(p - 1) & 0x80) ? p - 1 : p; }
+    }
+    return last;
+}
+
 UXS_EXPORT bool is_utf_code_printable(std::uint32_t code) noexcept;
 UXS_EXPORT unsigned get_utf_code_width(std::uint32_t code) noexcept;
 
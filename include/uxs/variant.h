@@ -6,6 +6,8 @@
 #include "optional.h"
 #include "stringcvt.h"  // NOLINT
 
+#include <vector>
+
 #define UXS_DECLARE_VARIANT_TYPE(ty, id) \
     template<> \
     struct variant_type_impl<ty> : variant_type_base_impl<ty, id> { \
@@ -22,7 +24,9 @@
     } \
     bool uxs::variant_type_impl<ty>::convert_to(variant_id type, void* to, const void* from) { \
         if (type != variant_id::string) { return false; } \
-        *static_cast<std::string*>(to) = uxs::to_string(*static_cast<const ty*>(from)); \
+        uxs::inline_dynbuffer buf; \
+        uxs::to_basic_string(buf, *static_cast<const ty*>(from)); \
+        static_cast<std::string*>(to)->assign(buf.data(), buf.size()); \
         return true; \
     }
 
@@ -188,6 +192,11 @@ UXS_DECLARE_VARIANT_TYPE(std::int64_t, variant_id::long_integer);
 UXS_DECLARE_VARIANT_TYPE(std::uint64_t, variant_id::unsigned_long_integer);
 UXS_DECLARE_VARIANT_TYPE(double, variant_id::double_precision);
 
+// Strings are kept directly in variant storage, so short strings fit into `std::string` small buffer
+// and take no dynamic memory
+static_assert(std::is_same<decltype(variant_type_impl<std::string>::deref(std::declval<void*>())), std::string&>::value,
+              "strings must be stored in place");
+
 class variant {
  public:
     enum : unsigned { max_type_id = 256 };
@@ -308,11 +317,15 @@ class variant {
 #undef UXS_VARIANT_IMPLEMENT_SCALAR_INIT_AND_COMPARE
 
     variant(std::string_view s) : variant(std::string(s)) {}
-    variant& operator=(std::string_view s) { return operator=(std::string(s)); }
+    variant& operator=(std::string_view s) {
+        if (!is<std::string>()) { return operator=(std::string(s)); }
+        variant_type_impl<std::string>::deref(&data_).assign(s.data(), s.size());  // reuse existing storage
+        return *this;
+    }
     bool is_equal_to(std::string_view s) const { return is_equal_to_impl<std::string, std::string_view>(s); }
 
     variant(const char* cstr) : variant(std::string(cstr)) {}
-    variant& operator=(const char* cstr) { return operator=(std::string(cstr)); }
+    variant& operator=(const char* cstr) { return operator=(std::string_view(cstr)); }
     bool is_equal_to(const char* cstr) const { return is_equal_to_impl<std::string, std::string_view>(cstr); }
 
  private:
@@ -338,6 +351,8 @@ class variant {
 
     friend UXS_EXPORT u8ibuf& operator>>(u8ibuf& is, variant& v);
     friend UXS_EXPORT u8iobuf& operator<<(u8iobuf& os, const variant& v);
+    friend UXS_EXPORT u8ibuf& deserialize_compact(u8ibuf& is, variant& v);
+    friend UXS_EXPORT u8iobuf& serialize_compact(u8iobuf& os, const variant& v);
 
     template<typename>
     friend struct variant_type_impl;
@@ -493,6 +508,17 @@ est::optional<Ty> variant::get_impl() const {
     return est::nullopt();
 }
 
+// Compact wire format: type identifiers, string lengths and integers are written as variable-length
+// integers (LEB128), signed integers are zigzag-encoded; values of custom types are written as usual.
+// Deserialization into a variant holding a value of the same type reuses its storage.
+UXS_EXPORT u8ibuf& deserialize_compact(u8ibuf& is, variant& v);
+UXS_EXPORT u8iobuf& serialize_compact(u8iobuf& os, const variant& v);
+
+// Bulk serialization of variant sequences in compact format, prefixed by element count;
+// `deserialize` reuses elements already present in the target vector
+UXS_EXPORT u8ibuf& deserialize(u8ibuf& is, std::vector<variant>& vs);
+UXS_EXPORT u8iobuf& serialize(u8iobuf& os, est::span<const variant> vs);
+
 namespace detail {
 // Use `detail::cref_wrapper` to avoid implicit conversion to `variant`
 template<typename Ty>
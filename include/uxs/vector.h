@@ -4,21 +4,53 @@
 #include "memory.h"
 
 #include <algorithm>
+#include <cstring>
 #include <stdexcept>
 
 namespace uxs {
 
+namespace detail {
+template<typename Ty, std::size_t InlineSize>
+class vector_inline_storage {
+ protected:
+    template<typename Pointer>
+    Pointer inline_data() const noexcept {
+        return std::pointer_traits<Pointer>::pointer_to(*reinterpret_cast<Ty*>(const_cast<std::uint8_t*>(buf_)));
+    }
+
+ private:
+    alignas(std::alignment_of<Ty>::value) std::uint8_t buf_[InlineSize * sizeof(Ty)];
+};
+
+template<typename Ty>
+class vector_inline_storage<Ty, 0> {
+ protected:
+    template<typename Pointer>
+    Pointer inline_data() const noexcept {
+        return Pointer();
+    }
+};
+}  // namespace detail
+
 //-----------------------------------------------------------------------------
 // Vector implementation
 
-template<typename Ty, typename Alloc = std::allocator<Ty>>
-class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty> {
+// If `InlineSize` is not zero, first `InlineSize` elements are stored inside of the object
+template<typename Ty, typename Alloc = std::allocator<Ty>, std::size_t InlineSize = 0>
+class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>,
+               private detail::vector_inline_storage<Ty, InlineSize> {
  private:
     static_assert(std::is_same<std::remove_cv_t<Ty>, Ty>::value,
                   "uxs::vector must have a non-const, non-volatile value type");
 
     using alloc_type = typename std::allocator_traits<Alloc>::template rebind_alloc<Ty>;
     using alloc_traits = std::allocator_traits<alloc_type>;
+    using inline_storage_type = detail::vector_inline_storage<Ty, InlineSize>;
+    using is_relocatable_by_memcpy = std::bool_constant<(is_trivially_relocatable<Ty>::value &&
+                                                         std::is_same<typename alloc_traits::pointer, Ty*>::value)>;
+    using is_nothrow_relocatable =
+        std::bool_constant<(is_relocatable_by_memcpy::value || std::is_nothrow_move_constructible<Ty>::value)>;
+    using is_nothrow_inline_move = std::bool_constant<(InlineSize == 0 || is_nothrow_relocatable::value)>;
 
  public:
     using value_type = Ty;
@@ -71,15 +103,19 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
         return *this;
     }
 
-    vector(vector&& other) noexcept : alloc_type(std::move(other)), v_(other.v_) { other.v_.nullify(); }
+    vector(vector&& other) noexcept(is_nothrow_inline_move::value) : alloc_type(std::move(other)) {
+        steal_data(other, std::bool_constant<(InlineSize != 0)>());
+    }
 
-    vector(vector&& other, const allocator_type& alloc) noexcept(is_alloc_always_equal<alloc_type>::value)
+    vector(vector&& other, const allocator_type& alloc) noexcept(is_alloc_always_equal<alloc_type>::value &&
+                                                                 is_nothrow_inline_move::value)
         : alloc_type(alloc) {
         construct_impl(std::move(other), alloc, is_alloc_always_equal<alloc_type>());
     }
 
-    vector& operator=(vector&& other) noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
-                                               is_alloc_always_equal<alloc_type>::value) {
+    vector& operator=(vector&& other) noexcept((alloc_traits::propagate_on_container_move_assignment::value ||
+                                                is_alloc_always_equal<alloc_type>::value) &&
+                                               is_nothrow_inline_move::value) {
         if (std::addressof(other) == this) { return *this; }
         assign_impl(std::move(other), std::bool_constant<(alloc_traits::propagate_on_container_move_assignment::value ||
                                                           is_alloc_always_equal<alloc_type>::value)>());
@@ -88,7 +124,7 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
 
     ~vector() { tidy(); }
 
-    void swap(vector& other) noexcept {
+    void swap(vector& other) noexcept(is_nothrow_inline_move::value) {
         if (std::addressof(other) == this) { return; }
         swap_impl(other, typename alloc_traits::propagate_on_container_swap());
     }
@@ -169,17 +205,15 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
     void reserve(size_type reserve_sz) {
         if (reserve_sz <= capacity()) { return; }
         auto v = alloc_new_checked(reserve_sz);
-        relocate(v, std::is_nothrow_move_constructible<Ty>());
+        relocate(v, is_nothrow_relocatable());
         reset(v);
     }
 
     void shrink_to_fit() {
-        if (v_.end == v_.boundary) { return; }
-        vector_ptrs_t v;
-        if (v_.begin != v_.end) {
-            v = alloc_new(size());
-            relocate(v, std::is_nothrow_move_constructible<Ty>());
-        }
+        if (v_.end == v_.boundary || is_inline(v_.begin)) { return; }
+        vector_ptrs_t v = inline_ptrs();
+        if (size() > InlineSize) { v = alloc_new(size()); }
+        if (v_.begin != v_.end) { relocate(v, is_nothrow_relocatable()); }
         reset(v);
     }
 
@@ -192,7 +226,7 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
                 v_.end = helpers::construct_default(*this, v_.end, count);
             } else {
                 auto v = alloc_new(grow_capacity(count));
-                resize_relocate_default(v, count, std::is_nothrow_move_constructible<Ty>());
+                resize_relocate_default(v, count, is_nothrow_relocatable());
                 reset(v);
             }
         }
@@ -207,7 +241,7 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
                 v_.end = helpers::construct_copy(*this, v_.end, count, const_value(val));
             } else {
                 auto v = alloc_new(grow_capacity(count));
-                resize_relocate_fill(v, count, val, std::is_nothrow_move_constructible<Ty>());
+                resize_relocate_fill(v, count, val, is_nothrow_relocatable());
                 reset(v);
             }
         }
@@ -238,12 +272,12 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
             if (p == v_.end) {
                 alloc_traits::construct(*this, std::addressof(*v_.end), std::forward<Args>(args)...);
             } else {
-                helpers::emplace(*this, p, v_.end, std::forward<Args>(args)...);
+                emplace_no_relocate(p, is_relocatable_by_memcpy(), std::forward<Args>(args)...);
             }
             return iterator(p, v_.begin, ++v_.end);
         }
         auto v = alloc_new(grow_capacity(1));
-        p = emplace_relocate(v, p, std::is_nothrow_move_constructible<Ty>(), std::forward<Args>(args)...);
+        p = emplace_relocate(v, p, is_nothrow_relocatable(), std::forward<Args>(args)...);
         reset(v);
         return iterator(p, v_.begin, v_.end);
     }
@@ -257,7 +291,7 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
             return *v_.end++;
         }
         auto v = alloc_new(grow_capacity(1));
-        emplace_back_relocate(v, std::is_nothrow_move_constructible<Ty>(), std::forward<Args>(args)...);
+        emplace_back_relocate(v, is_nothrow_relocatable(), std::forward<Args>(args)...);
         reset(v);
         return *(v_.end - 1);
     }
@@ -270,8 +304,7 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
     iterator erase(const_iterator pos) {
         auto p = to_ptr(pos);
         assert(p != v_.end);
-        std::move(p + 1, v_.end--, p);
-        alloc_traits::destroy(*this, std::addressof(*v_.end));
+        v_.end = helpers::erase(*this, p, p + 1, v_.end);
         return iterator(p, v_.begin, v_.end);
     }
 
@@ -280,10 +313,7 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
         auto p_last = to_ptr(last);
         assert(v_.begin <= p_first && p_first <= p_last && p_last <= v_.end);
         size_type count = static_cast<size_type>(p_last - p_first);
-        if (count) {
-            std::move(p_first + count, v_.end, p_first);
-            v_.end = helpers::truncate(*this, v_.end - count, v_.end);
-        }
+        if (count) { v_.end = helpers::erase(*this, p_first, p_last, v_.end); }
         return iterator(p_first, v_.begin, v_.end);
     }
 
@@ -297,12 +327,26 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
         pointer boundary{nullptr};
     };
 
-    vector_ptrs_t v_;
+    vector_ptrs_t v_ = inline_ptrs();
 
     enum : unsigned { start_capacity = 8 };
 
     bool is_same_alloc(const alloc_type& alloc) { return static_cast<alloc_type&>(*this) == alloc; }
 
+    vector_ptrs_t inline_ptrs() const noexcept {
+        auto p = inline_storage_type::template inline_data<pointer>();
+        return vector_ptrs_t(p, p, p + InlineSize);
+    }
+
+    bool is_inline(pointer p) const noexcept {
+        return InlineSize != 0 && p == inline_storage_type::template inline_data<pointer>();
+    }
+
+    void free_storage(const vector_ptrs_t& v) {
+        if (is_inline(v.begin)) { return; }
+        alloc_traits::deallocate(*this, v.begin, static_cast<size_type>(v.boundary - v.begin));
+    }
+
     pointer to_ptr(const_iterator it) const {
         auto p = it.ptr();
         uxs_iterator_assert(it.debug_begin() == v_.begin && it.debug_end() == v_.end);
@@ -338,23 +382,38 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
     }
     void tidy() {
         if (v_.begin != v_.boundary) { tidy(v_); }
-        v_.nullify();
+        v_ = inline_ptrs();
     }
     void tidy(vector_ptrs_t& v) {
         assert(v.begin != v.boundary);
         v.end = helpers::truncate(*this, v.begin, v.end);
-        alloc_traits::deallocate(*this, v.begin, static_cast<size_type>(v.boundary - v.begin));
+        free_storage(v);
     }
 
-    void construct_impl(vector&& other, const allocator_type& /*alloc*/, std::true_type) noexcept {
+    void steal_data(vector& other, std::false_type /* has inline storage */) noexcept {
         v_ = other.v_;
         other.v_.nullify();
     }
 
+    // Elements stored inline can't be stolen, they are moved one by one. This vector must be empty
+    void steal_data(vector& other, std::true_type /* has inline storage */) noexcept(is_nothrow_inline_move::value) {
+        if (other.is_inline(other.v_.begin)) {
+            v_.end = helpers::relocate(*this, v_.begin, other.v_.begin, other.v_.end);
+            other.v_.end = other.v_.begin;
+        } else {
+            v_ = other.v_;
+            other.v_ = other.inline_ptrs();
+        }
+    }
+
+    void construct_impl(vector&& other, const allocator_type& /*alloc*/,
+                        std::true_type) noexcept(is_nothrow_inline_move::value) {
+        steal_data(other, std::bool_constant<(InlineSize != 0)>());
+    }
+
     void construct_impl(vector&& other, const allocator_type& /*alloc*/, std::false_type) {
         if (is_same_alloc(other)) {
-            v_ = other.v_;
-            other.v_.nullify();
+            steal_data(other, std::bool_constant<(InlineSize != 0)>());
         } else {
             init(other.size(), std::make_move_iterator(other.begin()));
         }
@@ -372,48 +431,75 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
         }
     }
 
-    void assign_impl(vector&& other, std::true_type) noexcept {
-        reset(other.v_);
-        if (alloc_traits::propagate_on_container_move_assignment::value) { alloc_type::operator=(std::move(other)); }
-        other.v_.nullify();
+    void assign_impl(vector&& other, std::true_type) noexcept(is_nothrow_inline_move::value) {
+        if (alloc_traits::propagate_on_container_move_assignment::value) {
+            tidy();
+            alloc_type::operator=(std::move(other));
+        }
+        move_data(other, std::bool_constant<(InlineSize != 0)>());
     }
 
     void assign_impl(vector&& other, std::false_type) {
         if (is_same_alloc(other)) {
-            reset(other.v_);
-            other.v_.nullify();
+            move_data(other, std::bool_constant<(InlineSize != 0)>());
         } else {
             assign_impl(other.size(), std::make_move_iterator(other.begin()));
         }
     }
 
-    void swap_impl(vector& other, std::false_type) noexcept { std::swap(v_, other.v_); }
-    void swap_impl(vector& other, std::true_type) noexcept {
+    void move_data(vector& other, std::false_type /* has inline storage */) noexcept {
+        reset(other.v_);
+        other.v_.nullify();
+    }
+
+    void move_data(vector& other, std::true_type /* has inline storage */) noexcept(is_nothrow_inline_move::value) {
+        tidy();
+        steal_data(other, std::true_type());
+    }
+
+    void swap_impl(vector& other, std::false_type) noexcept(is_nothrow_inline_move::value) {
+        swap_data(other, std::bool_constant<(InlineSize != 0)>());
+    }
+    void swap_impl(vector& other, std::true_type) noexcept(is_nothrow_inline_move::value) {
         std::swap(static_cast<alloc_type&>(*this), static_cast<alloc_type&>(other));
-        std::swap(v_, other.v_);
+        swap_data(other, std::bool_constant<(InlineSize != 0)>());
+    }
+
+    void swap_data(vector& other, std::false_type /* has inline storage */) noexcept { std::swap(v_, other.v_); }
+
+    void swap_data(vector& other, std::true_type /* has inline storage */) noexcept(is_nothrow_inline_move::value) {
+        if (!is_inline(v_.begin) && !other.is_inline(other.v_.begin)) {
+            std::swap(v_, other.v_);
+            return;
+        }
+        vector tmp(std::move(other));
+        other.steal_data(*this, std::true_type());
+        steal_data(tmp, std::true_type());
     }
 
     void init_default(size_type sz) {
-        assert(v_.begin == nullptr);
+        assert(v_.begin == v_.end);
         if (!sz) { return; }
-        v_ = alloc_new_checked(sz);
+        if (sz > capacity()) { v_ = alloc_new_checked(sz); }
         try {
             v_.end = helpers::construct_default(*this, v_.end, sz);
         } catch (...) {
-            alloc_traits::deallocate(*this, v_.begin, capacity());
+            free_storage(v_);
+            v_ = inline_ptrs();
             throw;
         }
     }
 
     template<typename RandIt>
     void init(size_type sz, RandIt src) {
-        assert(v_.begin == nullptr);
+        assert(v_.begin == v_.end);
         if (!sz) { return; }
-        v_ = alloc_new_checked(sz);
+        if (sz > capacity()) { v_ = alloc_new_checked(sz); }
         try {
             v_.end = helpers::construct_copy(*this, v_.end, sz, src);
         } catch (...) {
-            alloc_traits::deallocate(*this, v_.begin, capacity());
+            free_storage(v_);
+            v_ = inline_ptrs();
             throw;
         }
     }
@@ -426,11 +512,11 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
 
     template<typename InputIt>
     void init_from_range(InputIt first, InputIt last, std::false_type /* random access iterator */) {
-        assert(v_.begin == nullptr);
+        assert(v_.begin == v_.end);
         try {
             for (; first != last; ++first) { emplace_back(*first); }
         } catch (...) {
-            tidy(v_);
+            tidy();
             throw;
         }
     }
@@ -477,30 +563,32 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
         }
     }
 
-    void relocate(vector_ptrs_t& v, std::true_type /* nothrow move */) noexcept {
-        v.end = helpers::construct_relocate(*this, v.end, v_.begin, v_.end);
+    void relocate(vector_ptrs_t& v, std::true_type /* nothrow relocate */) noexcept {
+        v.end = helpers::relocate(*this, v.end, v_.begin, v_.end);
+        v_.end = v_.begin;
     }
 
-    void relocate(vector_ptrs_t& v, std::false_type /* nothrow move */) {
+    void relocate(vector_ptrs_t& v, std::false_type /* nothrow relocate */) {
         try {
             v.end = helpers::construct_relocate_copy(*this, v.end, v_.begin, v_.end);
         } catch (...) {
-            alloc_traits::deallocate(*this, v.begin, static_cast<size_type>(v.boundary - v.begin));
+            free_storage(v);
             throw;
         }
     }
 
-    void resize_relocate_default(vector_ptrs_t& v, size_type count, std::true_type /* nothrow move */) {
+    void resize_relocate_default(vector_ptrs_t& v, size_type count, std::true_type /* nothrow relocate */) {
         try {
             v.end = helpers::construct_default(*this, v.begin + size(), count);
-            helpers::construct_relocate(*this, v.begin, v_.begin, v_.end);
+            helpers::relocate(*this, v.begin, v_.begin, v_.end);
+            v_.end = v_.begin;
         } catch (...) {
             alloc_traits::deallocate(*this, v.begin, static_cast<size_type>(v.boundary - v.begin));
             throw;
         }
     }
 
-    void resize_relocate_default(vector_ptrs_t& v, size_type count, std::false_type /* nothrow move */) {
+    void resize_relocate_default(vector_ptrs_t& v, size_type count, std::false_type /* nothrow relocate */) {
         try {
             v.end = helpers::construct_relocate_copy(*this, v.end, v_.begin, v_.end);
             v.end = helpers::construct_default(*this, v.end, count);
@@ -511,10 +599,11 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
     }
 
     void resize_relocate_fill(vector_ptrs_t& v, size_type count, const value_type& val,
-                              std::true_type /* nothrow move */) {
+                              std::true_type /* nothrow relocate */) {
         try {
             v.end = helpers::construct_copy(*this, v.begin + size(), count, const_value(val));
-            helpers::construct_relocate(*this, v.begin, v_.begin, v_.end);
+            helpers::relocate(*this, v.begin, v_.begin, v_.end);
+            v_.end = v_.begin;
         } catch (...) {
             alloc_traits::deallocate(*this, v.begin, static_cast<size_type>(v.boundary - v.begin));
             throw;
@@ -522,7 +611,7 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
     }
 
     void resize_relocate_fill(vector_ptrs_t& v, size_type count, const value_type& val,
-                              std::false_type /* nothrow move */) {
+                              std::false_type /* nothrow relocate */) {
         try {
             v.end = helpers::construct_relocate_copy(*this, v.end, v_.begin, v_.end);
             v.end = helpers::construct_copy(*this, v.end, count, const_value(val));
@@ -533,13 +622,14 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
     }
 
     template<typename... Args>
-    pointer emplace_relocate(vector_ptrs_t& v, pointer p, std::true_type /* nothrow move */, Args&&... args) {
+    pointer emplace_relocate(vector_ptrs_t& v, pointer p, std::true_type /* nothrow relocate */, Args&&... args) {
         try {
             size_type n = static_cast<size_type>(p - v_.begin);
             auto mid = v.begin + n;
             alloc_traits::construct(*this, std::addressof(*mid), std::forward<Args>(args)...);
-            helpers::construct_relocate(*this, v.begin, v_.begin, p);
-            v.end = helpers::construct_relocate(*this, mid + 1, p, v_.end);
+            helpers::relocate(*this, v.begin, v_.begin, p);
+            v.end = helpers::relocate(*this, mid + 1, p, v_.end);
+            v_.end = v_.begin;
             return mid;
         } catch (...) {
             alloc_traits::deallocate(*this, v.begin, static_cast<size_type>(v.boundary - v.begin));
@@ -548,7 +638,7 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
     }
 
     template<typename... Args>
-    pointer emplace_relocate(vector_ptrs_t& v, pointer p, std::false_type /* nothrow move */, Args&&... args) {
+    pointer emplace_relocate(vector_ptrs_t& v, pointer p, std::false_type /* nothrow relocate */, Args&&... args) {
         try {
             size_type n = static_cast<size_type>(p - v_.begin);
             v.end = helpers::construct_relocate_copy(*this, v.end, v_.begin, p);
@@ -562,11 +652,12 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
     }
 
     template<typename... Args>
-    void emplace_back_relocate(vector_ptrs_t& v, std::true_type /* nothrow move */, Args&&... args) {
+    void emplace_back_relocate(vector_ptrs_t& v, std::true_type /* nothrow relocate */, Args&&... args) {
         try {
             v.end = v.begin + size();
             alloc_traits::construct(*this, std::addressof(*v.end), std::forward<Args>(args)...);
-            helpers::construct_relocate(*this, v.begin, v_.begin, v_.end);
+            helpers::relocate(*this, v.begin, v_.begin, v_.end);
+            v_.end = v_.begin;
             ++v.end;
         } catch (...) {
             alloc_traits::deallocate(*this, v.begin, static_cast<size_type>(v.boundary - v.begin));
@@ -575,7 +666,7 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
     }
 
     template<typename... Args>
-    void emplace_back_relocate(vector_ptrs_t& v, std::false_type /* nothrow move */, Args&&... args) {
+    void emplace_back_relocate(vector_ptrs_t& v, std::false_type /* nothrow relocate */, Args&&... args) {
         try {
             v.end = helpers::construct_relocate_copy(*this, v.end, v_.begin, v_.end);
             alloc_traits::construct(*this, std::addressof(*v.end), std::forward<Args>(args)...);
@@ -589,11 +680,11 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
     template<typename RandIt, typename Bool>
     pointer insert_copy(pointer p, size_type count, RandIt src, Bool /* assignable */) {
         if (count <= static_cast<size_type>(v_.boundary - v_.end)) {
-            if (count) { insert_no_relocate(p, count, src, Bool()); }
+            if (count) { insert_no_relocate(p, count, src, Bool(), is_relocatable_by_memcpy()); }
             return p;
         }
         auto v = alloc_new(grow_capacity(count));
-        p = insert_relocate(v, p, count, src, std::is_nothrow_move_constructible<Ty>());
+        p = insert_relocate(v, p, count, src, is_nothrow_relocatable());
         reset(v);
         return p;
     }
@@ -605,7 +696,8 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
             value_type* val_copy = reinterpret_cast<value_type*>(&buf);
             alloc_traits::construct(*this, val_copy, val);
             try {
-                insert_no_relocate(p, count, const_value(*val_copy), std::is_copy_assignable<Ty>());
+                insert_no_relocate(p, count, const_value(*val_copy), std::is_copy_assignable<Ty>(),
+                                   is_relocatable_by_memcpy());
                 alloc_traits::destroy(*this, val_copy);
                 return p;
             } catch (...) {
@@ -614,19 +706,20 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
             }
         }
         auto v = alloc_new(grow_capacity(count));
-        p = insert_relocate(v, p, count, const_value(val), std::is_nothrow_move_constructible<Ty>());
+        p = insert_relocate(v, p, count, const_value(val), is_nothrow_relocatable());
         reset(v);
         return p;
     }
 
     template<typename RandIt>
     pointer insert_relocate(vector_ptrs_t& v, pointer p, size_type count, RandIt src,
-                            std::true_type /* nothrow move */) {
+                            std::true_type /* nothrow relocate */) {
         try {
             size_type n = static_cast<size_type>(p - v_.begin);
             auto mid = helpers::construct_copy(*this, v.begin + n, count, src);
-            helpers::construct_relocate(*this, v.begin, v_.begin, p);
-            v.end = helpers::construct_relocate(*this, mid, p, v_.end);
+            helpers::relocate(*this, v.begin, v_.begin, p);
+            v.end = helpers::relocate(*this, mid, p, v_.end);
+            v_.end = v_.begin;
             return v.begin + n;
         } catch (...) {
             alloc_traits::deallocate(*this, v.begin, static_cast<size_type>(v.boundary - v.begin));
@@ -636,7 +729,7 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
 
     template<typename RandIt>
     pointer insert_relocate(vector_ptrs_t& v, pointer p, size_type count, RandIt src,
-                            std::false_type /* nothrow move */) {
+                            std::false_type /* nothrow relocate */) {
         try {
             size_type n = static_cast<size_type>(p - v_.begin);
             v.end = helpers::construct_relocate_copy(*this, v.end, v_.begin, p);
@@ -650,7 +743,8 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
     }
 
     template<typename RandIt>
-    void insert_no_relocate(pointer p, size_type count, RandIt src, std::true_type /* assignable */) {
+    void insert_no_relocate(pointer p, size_type count, RandIt src, std::true_type /* assignable */,
+                            std::false_type /* relocate by memcpy */) {
         size_type tail = static_cast<size_type>(v_.end - p);
         if (tail == 0) {
             v_.end = helpers::construct_copy(*this, v_.end, count, src);
@@ -669,11 +763,40 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
     }
 
     template<typename RandIt>
-    void insert_no_relocate(pointer p, size_type count, RandIt src, std::false_type /* assignable */) {
+    void insert_no_relocate(pointer p, size_type count, RandIt src, std::false_type /* assignable */,
+                            std::false_type /* relocate by memcpy */) {
         v_.end = helpers::construct_copy(*this, v_.end, count, src);
         std::rotate(p, v_.end - count, v_.end);
     }
 
+    template<typename RandIt, typename Bool>
+    void insert_no_relocate(pointer p, size_type count, RandIt src, Bool /* assignable */,
+                            std::true_type /* relocate by memcpy */) {
+        const size_type tail = static_cast<size_type>(v_.end - p);
+        std::memmove(static_cast<void*>(p + count), static_cast<const void*>(p), tail * sizeof(Ty));
+        try {
+            helpers::construct_copy(*this, p, count, src);
+            v_.end += count;
+        } catch (...) {
+            std::memmove(static_cast<void*>(p), static_cast<const void*>(p + count), tail * sizeof(Ty));
+            throw;
+        }
+    }
+
+    template<typename... Args>
+    void emplace_no_relocate(pointer p, std::false_type /* relocate by memcpy */, Args&&... args) {
+        helpers::emplace(*this, p, v_.end, std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    void emplace_no_relocate(pointer p, std::true_type /* relocate by memcpy */, Args&&... args) {
+        alignas(std::alignment_of<value_type>::value) std::uint8_t buf[sizeof(value_type)];
+        alloc_traits::construct(*this, reinterpret_cast<value_type*>(&buf), std::forward<Args>(args)...);
+        const size_type tail = static_cast<size_type>(v_.end - p);
+        std::memmove(static_cast<void*>(p + 1), static_cast<const void*>(p), tail * sizeof(Ty));
+        std::memcpy(static_cast<void*>(p), static_cast<const void*>(&buf), sizeof(Ty));
+    }
+
     template<typename RandIt>
     pointer insert_range(pointer p, RandIt first, RandIt last, std::true_type /* random access iterator */) {
         assert(first <= last);
@@ -746,6 +869,42 @@ class vector : protected std::allocator_traits<Alloc>::template rebind_alloc<Ty>
             }
         }
 
+        // Moves elements to uninitialized memory, source elements are destroyed
+        static pointer relocate(alloc_type& alloc, pointer dst, pointer first, pointer last) {
+            return helpers::relocate_impl(alloc, dst, first, last, is_relocatable_by_memcpy());
+        }
+
+        static pointer relocate_impl(alloc_type& /*alloc*/, pointer dst, pointer first, pointer last,
+                                     std::true_type /* relocate by memcpy */) {
+            const size_type n = static_cast<size_type>(last - first);
+            if (n) { std::memcpy(static_cast<void*>(dst), static_cast<const void*>(first), n * sizeof(Ty)); }
+            return dst + n;
+        }
+
+        static pointer relocate_impl(alloc_type& alloc, pointer dst, pointer first, pointer last,
+                                     std::false_type /* relocate by memcpy */) {
+            dst = helpers::construct_relocate(alloc, dst, first, last);
+            helpers::truncate(alloc, first, last);
+            return dst;
+        }
+
+        static pointer erase(alloc_type& alloc, pointer first, pointer last, pointer end) {
+            return helpers::erase_impl(alloc, first, last, end, is_relocatable_by_memcpy());
+        }
+
+        static pointer erase_impl(alloc_type& alloc, pointer first, pointer last, pointer end,
+                                  std::true_type /* relocate by memcpy */) {
+            helpers::truncate(alloc, first, last);
+            const size_type tail = static_cast<size_type>(end - last);
+            std::memmove(static_cast<void*>(first), static_cast<const void*>(last), tail * sizeof(Ty));
+            return first + tail;
+        }
+
+        static pointer erase_impl(alloc_type& alloc, pointer first, pointer last, pointer end,
+                                  std::false_type /* relocate by memcpy */) {
+            return helpers::truncate(alloc, std::move(last, end, first), end);
+        }
+
         static pointer construct_relocate_copy(alloc_type& alloc, pointer dst, pointer first, pointer last) {
             return helpers::construct_relocate_copy_impl(alloc, dst, first, last, std::is_copy_constructible<Ty>());
         }
@@ -820,39 +979,44 @@ template<typename InputIt, typename Alloc = std::allocator<typename std::iterato
 vector(InputIt, InputIt, Alloc = Alloc()) -> vector<typename std::iterator_traits<InputIt>::value_type, Alloc>;
 #endif  // __cplusplus >= 201703L
 
-template<typename Ty, typename Alloc>
-bool operator==(const vector<Ty, Alloc>& lhs, const vector<Ty, Alloc>& rhs) {
+// Vector, which doesn't allocate memory until its size exceeds `InlineSize`
+template<typename Ty, std::size_t InlineSize, typename Alloc = std::allocator<Ty>>
+using small_vector = vector<Ty, Alloc, InlineSize>;
+
+template<typename Ty, typename Alloc, std::size_t InlineSize>
+bool operator==(const vector<Ty, Alloc, InlineSize>& lhs, const vector<Ty, Alloc, InlineSize>& rhs) {
     if (lhs.size() != rhs.size()) { return false; }
     return std::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template<typename Ty, typename Alloc>
-bool operator<(const vector<Ty, Alloc>& lhs, const vector<Ty, Alloc>& rhs) {
+template<typename Ty, typename Alloc, std::size_t InlineSize>
+bool operator<(const vector<Ty, Alloc, InlineSize>& lhs, const vector<Ty, Alloc, InlineSize>& rhs) {
     return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template<typename Ty, typename Alloc>
-bool operator!=(const vector<Ty, Alloc>& lhs, const vector<Ty, Alloc>& rhs) {
+template<typename Ty, typename Alloc, std::size_t InlineSize>
+bool operator!=(const vector<Ty, Alloc, InlineSize>& lhs, const vector<Ty, Alloc, InlineSize>& rhs) {
     return !(lhs == rhs);
 }
-template<typename Ty, typename Alloc>
-bool operator<=(const vector<Ty, Alloc>& lhs, const vector<Ty, Alloc>& rhs) {
+template<typename Ty, typename Alloc, std::size_t InlineSize>
+bool operator<=(const vector<Ty, Alloc, InlineSize>& lhs, const vector<Ty, Alloc, InlineSize>& rhs) {
     return !(rhs < lhs);
 }
-template<typename Ty, typename Alloc>
-bool operator>(const vector<Ty, Alloc>& lhs, const vector<Ty, Alloc>& rhs) {
+template<typename Ty, typename Alloc, std::size_t InlineSize>
+bool operator>(const vector<Ty, Alloc, InlineSize>& lhs, const vector<Ty, Alloc, InlineSize>& rhs) {
     return rhs < lhs;
 }
-template<typename Ty, typename Alloc>
-bool operator>=(const vector<Ty, Alloc>& lhs, const vector<Ty, Alloc>& rhs) {
+template<typename Ty, typename Alloc, std::size_t InlineSize>
+bool operator>=(const vector<Ty, Alloc, InlineSize>& lhs, const vector<Ty, Alloc, InlineSize>& rhs) {
     return !(lhs < rhs);
 }
 
 }  // namespace uxs
 
 namespace std {
-template<typename Ty, typename Alloc>
-void swap(uxs::vector<Ty, Alloc>& v1, uxs::vector<Ty, Alloc>& v2) noexcept(noexcept(v1.swap(v2))) {
+template<typename Ty, typename Alloc, std::size_t InlineSize>
+void swap(uxs::vector<Ty, Alloc, InlineSize>& v1,
+          uxs::vector<Ty, Alloc, InlineSize>& v2) noexcept(noexcept(v1.swap(v2))) {
     v1.swap(v2);
 }
 }  // namespace std
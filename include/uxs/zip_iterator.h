@@ -1,9 +1,13 @@
 #pragma once
 
+#include "functional.h"
 #include "iterator.h"
 #include "metaprog_alg.h"  // NOLINT
 
+#include <algorithm>
+#include <cstdint>
 #include <tuple>
+#include <vector>
 
 namespace uxs {
 
@@ -124,4 +128,204 @@ auto zip(Range&&... r) noexcept -> iterator_range<zip_iterator<decltype(std::end
             zip_iterator<decltype(std::end(r))...>(std::end(r)...)};
 }
 
+// ---- structure-of-arrays algorithms
+
+namespace detail {
+template<typename Iter, typename IndexTy>
+void apply_permutation(Iter first, const std::vector<IndexTy>& perm, std::true_type /*trivial*/) {
+    std::vector<typename std::iterator_traits<Iter>::value_type> tmp(perm.size());
+    for (std::size_t i = 0; i < perm.size(); ++i) { tmp[i] = first[perm[i]]; }
+    std::copy(tmp.begin(), tmp.end(), first);
+}
+template<typename Iter, typename IndexTy>
+void apply_permutation(Iter first, const std::vector<IndexTy>& perm, std::false_type /*trivial*/) {
+    std::vector<typename std::iterator_traits<Iter>::value_type> tmp;
+    tmp.reserve(perm.size());
+    for (const IndexTy i : perm) { tmp.emplace_back(std::move(first[i])); }
+    std::move(tmp.begin(), tmp.end(), first);
+}
+
+template<typename Iter, typename IndexTy>
+void apply_permutation(Iter first, const std::vector<IndexTy>& perm) {
+    static_assert(is_random_access_iterator<Iter>::value, "random access iterator is required");
+    using value_type = typename std::iterator_traits<Iter>::value_type;
+    apply_permutation(first, perm,
+                      std::bool_constant<std::is_trivially_copyable<value_type>::value &&
+                                         std::is_trivially_default_constructible<value_type>::value>{});
+}
+template<typename... Iter, typename IndexTy, std::size_t... Indices>
+void apply_permutation(zip_iterator<Iter...> first, const std::vector<IndexTy>& perm, std::index_sequence<Indices...>) {
+    dummy_variadic((apply_permutation(first.template base<Indices>(), perm), 0)...);
+}
+template<typename... Iter, typename IndexTy>
+void apply_permutation(zip_iterator<Iter...> first, const std::vector<IndexTy>& perm) {
+    apply_permutation(first, perm, std::index_sequence_for<Iter...>{});
+}
+
+// Trivial keys are copied and sorted together with indices, so they are accessed sequentially
+template<typename IndexTy, typename KeyIter, typename Comp>
+std::vector<IndexTy> sort_permutation(KeyIter keys, std::size_t count, Comp comp, bool stable, std::true_type) {
+    using key_type = typename std::iterator_traits<KeyIter>::value_type;
+    std::vector<std::pair<key_type, IndexTy>> items(count);
+    for (std::size_t i = 0; i < count; ++i) { items[i] = std::make_pair(keys[i], static_cast<IndexTy>(i)); }
+    const auto item_comp = [&comp](const std::pair<key_type, IndexTy>& lhs, const std::pair<key_type, IndexTy>& rhs) {
+        return comp(lhs.first, rhs.first);
+    };
+    if (stable) {
+        std::stable_sort(items.begin(), items.end(), item_comp);
+    } else {
+        std::sort(items.begin(), items.end(), item_comp);
+    }
+    std::vector<IndexTy> perm(count);
+    for (std::size_t i = 0; i < count; ++i) { perm[i] = items[i].second; }
+    return perm;
+}
+template<typename IndexTy, typename KeyIter, typename Comp>
+std::vector<IndexTy> sort_permutation(KeyIter keys, std::size_t count, Comp comp, bool stable, std::false_type) {
+    std::vector<IndexTy> perm(count);
+    for (std::size_t i = 0; i < count; ++i) { perm[i] = static_cast<IndexTy>(i); }
+    const auto index_comp = [keys, &comp](IndexTy lhs, IndexTy rhs) { return comp(keys[lhs], keys[rhs]); };
+    if (stable) {
+        std::stable_sort(perm.begin(), perm.end(), index_comp);
+    } else {
+        std::sort(perm.begin(), perm.end(), index_comp);
+    }
+    return perm;
+}
+
+// Integral keys compared with `less` or `greater` are sorted with LSD radix sort, which is stable
+template<typename Comp, typename Key>
+struct radix_sort_order : std::integral_constant<int, 0> {};
+template<typename Key>
+struct radix_sort_order<less<>, Key> : std::integral_constant<int, 1> {};
+template<typename Key>
+struct radix_sort_order<std::less<Key>, Key> : std::integral_constant<int, 1> {};
+template<typename Key>
+struct radix_sort_order<greater<>, Key> : std::integral_constant<int, -1> {};
+template<typename Key>
+struct radix_sort_order<std::greater<Key>, Key> : std::integral_constant<int, -1> {};
+#if __cplusplus < 201402L
+template<typename Key>
+struct radix_sort_order<less<Key>, Key> : std::integral_constant<int, 1> {};
+template<typename Key>
+struct radix_sort_order<greater<Key>, Key> : std::integral_constant<int, -1> {};
+#endif  // __cplusplus < 201402L
+
+template<typename IndexTy, typename KeyIter>
+std::vector<IndexTy> radix_sort_permutation(KeyIter keys, std::size_t count, bool descending) {
+    using key_type = typename std::iterator_traits<KeyIter>::value_type;
+    using ukey_type = typename std::make_unsigned<key_type>::type;
+    enum : unsigned { digit_bits = 8, digit_count = 1 << digit_bits, pass_count = sizeof(ukey_type) };
+    struct item_t {
+        ukey_type key;
+        IndexTy index;
+    };
+    const ukey_type sign_bit = std::is_signed<key_type>::value ? ukey_type(1) << (8 * sizeof(ukey_type) - 1) : 0;
+    const ukey_type inverse_mask = descending ? ~ukey_type(0) : 0;
+    // histograms of all digits are built at once
+    std::unique_ptr<item_t[]> items(new item_t[count]), tmp(new item_t[count]);
+    std::vector<std::size_t> offsets(pass_count * digit_count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const ukey_type key = static_cast<ukey_type>(static_cast<ukey_type>(keys[i]) ^ sign_bit ^ inverse_mask);
+        items[i].key = key, items[i].index = static_cast<IndexTy>(i);
+        for (unsigned pass = 0; pass < pass_count; ++pass) {
+            ++offsets[pass * digit_count + ((key >> (pass * digit_bits)) & (digit_count - 1))];
+        }
+    }
+    for (unsigned pass = 0; pass < pass_count; ++pass) {
+        const unsigned shift = pass * digit_bits;
+        std::size_t* pass_offsets = &offsets[pass * digit_count];
+        if (pass_offsets[(items[0].key >> shift) & (digit_count - 1)] == count) { continue; }  // the same digits
+        for (std::size_t digit = 0, offset = 0; digit < digit_count; ++digit) {
+            offset += pass_offsets[digit];
+            pass_offsets[digit] = offset - pass_offsets[digit];
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            tmp[pass_offsets[(items[i].key >> shift) & (digit_count - 1)]++] = items[i];
+        }
+        items.swap(tmp);
+    }
+    std::vector<IndexTy> perm(count);
+    for (std::size_t i = 0; i < count; ++i) { perm[i] = items[i].index; }
+    return perm;
+}
+
+template<typename IndexTy, typename KeyIter, typename Comp, int Order>
+std::vector<IndexTy> sort_permutation(KeyIter keys, std::size_t count, Comp comp, bool stable,
+                                      std::integral_constant<int, Order>) {
+    if (count >= 1024) { return radix_sort_permutation<IndexTy>(keys, count, Order < 0); }
+    return sort_permutation<IndexTy>(keys, count, comp, stable, std::true_type{});
+}
+template<typename IndexTy, typename KeyIter, typename Comp>
+std::vector<IndexTy> sort_permutation(KeyIter keys, std::size_t count, Comp comp, bool stable,
+                                      std::integral_constant<int, 0>) {
+    using key_type = typename std::iterator_traits<KeyIter>::value_type;
+    return sort_permutation<IndexTy>(keys, count, comp, stable,
+                                     std::bool_constant<std::is_trivially_copyable<key_type>::value &&
+                                                        std::is_default_constructible<key_type>::value>{});
+}
+
+template<typename IndexTy, typename KeyIter, typename Comp>
+std::vector<IndexTy> sort_permutation(KeyIter keys, std::size_t count, Comp comp, bool stable) {
+    using key_type = typename std::iterator_traits<KeyIter>::value_type;
+    using radix_order = std::conditional_t<std::is_integral<key_type>::value && !std::is_same<key_type, bool>::value,
+                                           radix_sort_order<Comp, key_type>, std::integral_constant<int, 0>>;
+    return sort_permutation<IndexTy>(keys, count, comp, stable, radix_order{});
+}
+
+template<typename IndexTy, typename... Iter, typename Comp>
+void zip_sort_impl(zip_iterator<Iter...> first, std::size_t count, Comp comp, bool stable) {
+    apply_permutation(first, sort_permutation<IndexTy>(first.template base<0>(), count, comp, stable));
+}
+
+template<typename... Iter, typename Comp>
+void zip_sort(zip_iterator<Iter...> first, zip_iterator<Iter...> last, Comp comp, bool stable) {
+    static_assert(std::conjunction<is_random_access_iterator<Iter>...>::value, "random access iterators are required");
+    const std::size_t count = static_cast<std::size_t>(last - first);
+    if (count < 2) { return; }
+    if (count <= std::numeric_limits<std::uint32_t>::max()) {
+        zip_sort_impl<std::uint32_t>(first, count, comp, stable);
+    } else {
+        zip_sort_impl<std::size_t>(first, count, comp, stable);
+    }
+}
+}  // namespace detail
+
+// Sorts structure-of-arrays data by the elements of the first sequence; `comp` compares these elements.
+// Keys are sorted together with indices, and then each sequence is permuted once, so elements are not
+// moved through tuple-of-references proxies
+template<typename... Iter, typename Comp = less<>>
+void zip_sort(zip_iterator<Iter...> first, zip_iterator<Iter...> last, Comp comp = Comp{}) {
+    detail::zip_sort(first, last, comp, false);
+}
+
+template<typename Range, typename Comp = less<>>
+auto zip_sort(Range&& r, Comp comp = Comp{}) -> decltype(detail::zip_sort(std::begin(r), std::end(r), comp, false)) {
+    detail::zip_sort(std::begin(r), std::end(r), comp, false);
+}
+
+template<typename... Iter, typename Comp = less<>>
+void zip_stable_sort(zip_iterator<Iter...> first, zip_iterator<Iter...> last, Comp comp = Comp{}) {
+    detail::zip_sort(first, last, comp, true);
+}
+
+template<typename Range, typename Comp = less<>>
+auto zip_stable_sort(Range&& r,
+                     Comp comp = Comp{}) -> decltype(detail::zip_sort(std::begin(r), std::end(r), comp, true)) {
+    detail::zip_sort(std::begin(r), std::end(r), comp, true);
+}
+
+// Reorders elements so that `i`-th element becomes equal to the former `perm[i]`-th element;
+// `first` is a random access iterator or a zip iterator, then each sequence is reordered separately
+template<typename Iter, typename IndexTy>
+std::enable_if_t<is_random_access_iterator<Iter>::value> zip_apply_permutation(Iter first,
+                                                                              const std::vector<IndexTy>& perm) {
+    detail::apply_permutation(first, perm);
+}
+
+template<typename Range, typename IndexTy>
+auto zip_apply_permutation(Range&& r, const std::vector<IndexTy>& perm) -> decltype(void(std::begin(r))) {
+    detail::apply_permutation(std::begin(r), perm);
+}
+
 }  // namespace uxs
@@ -0,0 +1,90 @@
+#include "uxs/huge_page_allocator.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#if !defined(MPOL_PREFERRED)
+#    define MPOL_PREFERRED 1
+#endif  // !defined(MPOL_PREFERRED)
+
+using namespace uxs;
+
+namespace {
+
+std::size_t round_up_to_huge_page(std::size_t sz) {
+    return (sz + huge_page_size - 1) & ~static_cast<std::size_t>(huge_page_size - 1);
+}
+
+void advise_huge_pages(void* p, std::size_t sz) {
+#if defined(MADV_HUGEPAGE)
+    ::madvise(p, sz, MADV_HUGEPAGE);
+#endif  // defined(MADV_HUGEPAGE)
+}
+
+// Sets preferred NUMA node for not yet touched pages; it's a hint, so errors are ignored
+void bind_to_local_node(void* p, std::size_t sz) {
+#if defined(SYS_getcpu) && defined(SYS_mbind)
+    enum : unsigned { bits_per_word = 8 * sizeof(unsigned long), max_node_count = 1024 };
+    unsigned cpu = 0, node = 0;
+    if (::syscall(SYS_getcpu, &cpu, &node, nullptr) != 0 || node >= max_node_count) { return; }
+    unsigned long mask[max_node_count / bits_per_word] = {};
+    mask[node / bits_per_word] = 1ul << (node % bits_per_word);
+    ::syscall(SYS_mbind, p, sz, MPOL_PREFERRED, mask, max_node_count + 1, 0);
+#endif  // defined(SYS_getcpu) && defined(SYS_mbind)
+}
+
+}  // namespace
+
+void* uxs::alloc_huge_pages(std::size_t sz, huge_page_flags flags) {
+    sz = round_up_to_huge_page(sz);
+    void* p = MAP_FAILED;
+#if defined(MAP_HUGETLB)
+    if (!!(flags & huge_page_flags::explicit_pages)) {
+        p = ::mmap(nullptr, sz, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    }
+#endif  // defined(MAP_HUGETLB)
+    if (p == MAP_FAILED) {
+        // allocate one extra huge page and cut unaligned ends off, so the block can be backed by huge pages
+        void* p0 = ::mmap(nullptr, sz + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p0 == MAP_FAILED) { throw std::bad_alloc(); }
+        const std::size_t head = static_cast<std::size_t>(-reinterpret_cast<std::uintptr_t>(p0)) & (huge_page_size - 1);
+        if (head) { ::munmap(p0, head); }
+        p = static_cast<std::uint8_t*>(p0) + head;
+        ::munmap(static_cast<std::uint8_t*>(p) + sz, huge_page_size - head);
+        if (!!(flags & huge_page_flags::transparent)) { advise_huge_pages(p, sz); }
+    }
+    if (!!(flags & huge_page_flags::numa_local)) { bind_to_local_node(p, sz); }
+    return p;
+}
+
+void uxs::free_huge_pages(void* p, std::size_t sz) noexcept { ::munmap(p, round_up_to_huge_page(sz)); }
+
+void* uxs::alloc_pages(std::size_t sz) {
+    sz = round_up_to_huge_page(sz);
+    void* p = ::mmap(nullptr, sz, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) { throw std::bad_alloc(); }
+    advise_huge_pages(p, sz);
+    return p;
+}
+
+void* uxs::realloc_pages(void* p, std::size_t old_sz, std::size_t new_sz) {
+    old_sz = round_up_to_huge_page(old_sz), new_sz = round_up_to_huge_page(new_sz);
+    if (new_sz == old_sz) { return p; }
+#if defined(MREMAP_MAYMOVE)
+    void* new_p = ::mremap(p, old_sz, new_sz, MREMAP_MAYMOVE);
+    if (new_p == MAP_FAILED) { throw std::bad_alloc(); }
+    advise_huge_pages(new_p, new_sz);
+#else   // defined(MREMAP_MAYMOVE)
+    void* new_p = alloc_pages(new_sz);
+    std::memcpy(new_p, p, std::min(old_sz, new_sz));
+    ::munmap(p, old_sz);
+#endif  // defined(MREMAP_MAYMOVE)
+    return new_p;
+}
+
+void uxs::free_pages(void* p, std::size_t sz) noexcept { ::munmap(p, round_up_to_huge_page(sz)); }
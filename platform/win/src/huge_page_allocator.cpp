@@ -0,0 +1,87 @@
+#include "uxs/huge_page_allocator.h"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+using namespace uxs;
+
+namespace {
+
+std::size_t round_up_to_huge_page(std::size_t sz) {
+    return (sz + huge_page_size - 1) & ~static_cast<std::size_t>(huge_page_size - 1);
+}
+
+void* virtual_alloc(void* addr, std::size_t sz, DWORD alloc_type, huge_page_flags flags) {
+    if (!!(flags & huge_page_flags::numa_local)) {
+        PROCESSOR_NUMBER proc;
+        USHORT node = 0;
+        ::GetCurrentProcessorNumberEx(&proc);
+        if (::GetNumaProcessorNodeEx(&proc, &node)) {
+            return ::VirtualAllocExNuma(::GetCurrentProcess(), addr, sz, alloc_type, PAGE_READWRITE, node);
+        }
+    }
+    return ::VirtualAlloc(addr, sz, alloc_type, PAGE_READWRITE);
+}
+
+bool is_huge_page_aligned(const void* p) { return (reinterpret_cast<std::uintptr_t>(p) & (huge_page_size - 1)) == 0; }
+
+// `VirtualAlloc` aligns blocks by allocation granularity (64 KiB) only, and a part of a reserved region can't be
+// released, so a region with one extra huge page is reserved to find an aligned address, and then it is released
+// and the block is allocated at this address; another thread can take the address in between, so it is retried
+void* virtual_alloc_aligned(std::size_t sz, huge_page_flags flags) {
+    enum : unsigned { max_attempt_count = 16 };
+    for (unsigned attempt = 0; attempt < max_attempt_count; ++attempt) {
+        void* p0 = ::VirtualAlloc(nullptr, sz + huge_page_size, MEM_RESERVE, PAGE_NOACCESS);
+        if (!p0) { return nullptr; }
+        const std::uintptr_t addr = (reinterpret_cast<std::uintptr_t>(p0) + huge_page_size - 1) &
+                                    ~static_cast<std::uintptr_t>(huge_page_size - 1);
+        ::VirtualFree(p0, 0, MEM_RELEASE);
+        void* p = virtual_alloc(reinterpret_cast<void*>(addr), sz, MEM_RESERVE | MEM_COMMIT, flags);
+        if (p) { return p; }
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+// There are no transparent huge pages in Windows, so only explicit large pages are used; they also require
+// `SeLockMemoryPrivilege`, and normal pages are used if the allocation of large pages fails
+void* uxs::alloc_huge_pages(std::size_t sz, huge_page_flags flags) {
+    sz = round_up_to_huge_page(sz);
+    void* p = nullptr;
+    const std::size_t large_page_size = ::GetLargePageMinimum();
+    if (!!(flags & huge_page_flags::explicit_pages) && large_page_size && sz % large_page_size == 0) {
+        p = virtual_alloc(nullptr, sz, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, flags);
+        if (p && !is_huge_page_aligned(p)) {
+            ::VirtualFree(p, 0, MEM_RELEASE);
+            p = nullptr;
+        }
+    }
+    if (!p) { p = virtual_alloc_aligned(sz, flags); }
+    if (!p) { throw std::bad_alloc(); }
+    return p;
+}
+
+void uxs::free_huge_pages(void* p, std::size_t /*sz*/) noexcept { ::VirtualFree(p, 0, MEM_RELEASE); }
+
+void* uxs::alloc_pages(std::size_t sz) {
+    void* p = ::VirtualAlloc(nullptr, round_up_to_huge_page(sz), MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (!p) { throw std::bad_alloc(); }
+    return p;
+}
+
+// There is no way to remap pages in Windows, so the contents are copied
+void* uxs::realloc_pages(void* p, std::size_t old_sz, std::size_t new_sz) {
+    old_sz = round_up_to_huge_page(old_sz), new_sz = round_up_to_huge_page(new_sz);
+    if (new_sz == old_sz) { return p; }
+    void* new_p = alloc_pages(new_sz);
+    std::memcpy(new_p, p, (std::min)(old_sz, new_sz));
+    ::VirtualFree(p, 0, MEM_RELEASE);
+    return new_p;
+}
+
+void uxs::free_pages(void* p, std::size_t /*sz*/) noexcept { ::VirtualFree(p, 0, MEM_RELEASE); }
@@ -1,10 +1,68 @@
 #include "uxs/impl/format_impl.h"
 
+#include <mutex>
+
 using namespace uxs;
 
+namespace {
+
+// The only mutex for all buffers, because writing to a buffer can flush the buffer tied to it
+std::mutex g_print_mutex;
+
+template<typename CharT>
+struct line_buffer {
+    inline_basic_dynbuffer<CharT> buf;
+    bool is_busy = false;
+};
+
+template<typename CharT>
+void format_line(inline_basic_dynbuffer<CharT>& line, locale_ref loc, std::basic_string_view<CharT> fmt,
+                 basic_format_args<basic_format_context<CharT>> args, bool endl) {
+    detail::basic_vformat(line, loc, fmt, args);
+    if (endl) { line.push_back('\n'); }
+}
+
+template<typename CharT>
+void write_line(basic_iobuf<CharT>& out, const inline_basic_dynbuffer<CharT>& line, bool endl) {
+    std::lock_guard<std::mutex> lock(g_print_mutex);
+    out.write(est::as_span(line.data(), line.size()));
+    if (endl) { out.flush(); }
+}
+
+}  // namespace
+
 namespace uxs {
 namespace sfmt {
 template UXS_EXPORT void vformat(format_context, format_parse_context);
 template UXS_EXPORT void vformat(wformat_context, wformat_parse_context);
 }  // namespace sfmt
+
+namespace detail {
+
+template<typename CharT>
+void vprint_atomic(basic_iobuf<CharT>& out, locale_ref loc, std::basic_string_view<CharT> fmt,
+                   basic_format_args<basic_format_context<CharT>> args, bool endl) {
+    static thread_local line_buffer<CharT> tls;
+    if (tls.is_busy) {  // nested call from a formatter
+        inline_basic_dynbuffer<CharT> line;
+        format_line(line, loc, fmt, args, endl);
+        write_line(out, line, endl);
+        return;
+    }
+    tls.buf.clear();
+    tls.is_busy = true;
+    try {
+        format_line(tls.buf, loc, fmt, args, endl);
+    } catch (...) {
+        tls.is_busy = false;
+        throw;
+    }
+    tls.is_busy = false;
+    write_line(out, tls.buf, endl);
+}
+
+template UXS_EXPORT void vprint_atomic(iobuf&, locale_ref, std::string_view, format_args, bool);
+template UXS_EXPORT void vprint_atomic(wiobuf&, locale_ref, std::wstring_view, wformat_args, bool);
+
+}  // namespace detail
 }  // namespace uxs
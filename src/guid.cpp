@@ -1,5 +1,7 @@
 #include "uxs/guid.h"
 
+#include "simd.h"
+
 #include <random>
 
 using namespace uxs;
@@ -11,8 +13,132 @@ namespace {
 std::random_device g_rd;
 std::seed_seq g_seed{g_rd(), g_rd(), g_rd(), g_rd(), g_rd()};
 std::mt19937 g_generator(g_seed);
+
+// positions of hexadecimal digits in canonical representation
+const unsigned g_hex_pos[] = {0,  1,  2,  3,  4,  5,  6,  7,  9,  10, 11, 12, 14, 15, 16, 17,
+                              19, 20, 21, 22, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35};
+
+bool is_canonical_layout(const char* p) noexcept {
+    return p[8] == '-' && p[13] == '-' && p[18] == '-' && p[23] == '-';
+}
+
+void to_canonical_chars_scalar(const guid& id, char* p, bool upper) noexcept {
+    const char* digs = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    const std::uint32_t l = id.data32(0);
+    const std::uint16_t w1 = id.data16(2), w2 = id.data16(3);
+    std::uint8_t bytes[16];
+    bytes[0] = static_cast<std::uint8_t>(l >> 24), bytes[1] = static_cast<std::uint8_t>(l >> 16);
+    bytes[2] = static_cast<std::uint8_t>(l >> 8), bytes[3] = static_cast<std::uint8_t>(l);
+    bytes[4] = static_cast<std::uint8_t>(w1 >> 8), bytes[5] = static_cast<std::uint8_t>(w1);
+    bytes[6] = static_cast<std::uint8_t>(w2 >> 8), bytes[7] = static_cast<std::uint8_t>(w2);
+    for (unsigned i = 8; i < 16; ++i) { bytes[i] = id.data8(i); }
+    for (unsigned i = 0; i < 16; ++i) {
+        p[g_hex_pos[2 * i]] = digs[bytes[i] >> 4];
+        p[g_hex_pos[2 * i + 1]] = digs[bytes[i] & 0xf];
+    }
+    p[8] = '-', p[13] = '-', p[18] = '-', p[23] = '-';
+}
+
+bool from_canonical_chars_scalar(const char* p, guid& id) noexcept {
+    if (!is_canonical_layout(p)) { return false; }
+    std::uint8_t bytes[16];
+    for (unsigned i = 0; i < 16; ++i) {
+        const unsigned hi = dig_v(p[g_hex_pos[2 * i]]), lo = dig_v(p[g_hex_pos[2 * i + 1]]);
+        if ((hi | lo) >= 16) { return false; }
+        bytes[i] = static_cast<std::uint8_t>((hi << 4) | lo);
+    }
+    id = guid((static_cast<std::uint32_t>(bytes[0]) << 24) | (static_cast<std::uint32_t>(bytes[1]) << 16) |
+                  (static_cast<std::uint32_t>(bytes[2]) << 8) | bytes[3],
+              static_cast<std::uint16_t>((bytes[4] << 8) | bytes[5]),
+              static_cast<std::uint16_t>((bytes[6] << 8) | bytes[7]), bytes[8], bytes[9], bytes[10], bytes[11],
+              bytes[12], bytes[13], bytes[14], bytes[15]);
+    return true;
+}
+
+#if UXS_USE_X86_SIMD != 0
+// Byte order of `data32(0)`, `data16(2)` and `data16(3)` fields is reversed in text representation.
+// Note that this shuffle mask is its own inverse.
+#    define UXS_GUID_TEXT_ORDER_MASK _mm_setr_epi8(3, 2, 1, 0, 5, 4, 7, 6, 8, 9, 10, 11, 12, 13, 14, 15)
+
+UXS_SIMD_TARGET("ssse3")
+void to_canonical_chars_ssse3(const guid& id, char* p, bool upper) noexcept {
+    const __m128i lut = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(upper ? "0123456789ABCDEF" : "0123456789abcdef"));
+    const __m128i nibble_mask = _mm_set1_epi8(0xf);
+    const __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&id)),
+                                       UXS_GUID_TEXT_ORDER_MASK);
+    const __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(v, 4), nibble_mask));
+    const __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(v, nibble_mask));
+    const __m128i a = _mm_unpacklo_epi8(hi, lo);  // digits 0..15
+    const __m128i b = _mm_unpackhi_epi8(hi, lo);  // digits 16..31
+    const char z = -128;                          // zeroing shuffle index
+    const __m128i out0 = _mm_or_si128(
+        _mm_shuffle_epi8(a, _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, z, 8, 9, 10, 11, z, 12, 13)),
+        _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, '-', 0, 0, 0, 0, '-', 0, 0));
+    const __m128i out1 = _mm_or_si128(
+        _mm_or_si128(_mm_shuffle_epi8(a, _mm_setr_epi8(14, 15, z, z, z, z, z, z, z, z, z, z, z, z, z, z)),
+                     _mm_shuffle_epi8(b, _mm_setr_epi8(z, z, z, 0, 1, 2, 3, z, 4, 5, 6, 7, 8, 9, 10, 11))),
+        _mm_setr_epi8(0, 0, '-', 0, 0, 0, 0, '-', 0, 0, 0, 0, 0, 0, 0, 0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), out0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p + 16), out1);
+    const int tail = _mm_cvtsi128_si32(_mm_srli_si128(b, 12));
+    std::memcpy(p + 32, &tail, sizeof(tail));
+}
+
+// converts hexadecimal digits to nibbles, `valid` mask is cleared for non-digit characters
+UXS_SIMD_TARGET("ssse3")
+__m128i hex_to_nibbles(__m128i v, __m128i& valid) noexcept {
+    const __m128i d = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+    const __m128i l = _mm_sub_epi8(_mm_or_si128(v, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i is_d = _mm_and_si128(_mm_cmpgt_epi8(d, _mm_set1_epi8(-1)), _mm_cmplt_epi8(d, _mm_set1_epi8(10)));
+    const __m128i is_l = _mm_and_si128(_mm_cmpgt_epi8(l, _mm_set1_epi8(-1)), _mm_cmplt_epi8(l, _mm_set1_epi8(6)));
+    valid = _mm_and_si128(valid, _mm_or_si128(is_d, is_l));
+    return _mm_or_si128(_mm_and_si128(is_d, d), _mm_and_si128(is_l, _mm_add_epi8(l, _mm_set1_epi8(10))));
+}
+
+UXS_SIMD_TARGET("ssse3")
+bool from_canonical_chars_ssse3(const char* p, guid& id) noexcept {
+    if (!is_canonical_layout(p)) { return false; }
+    const char z = -128;  // zeroing shuffle index
+    const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 8));
+    const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 20));
+    // gather 32 hexadecimal digits skipping dashes
+    const __m128i a = _mm_or_si128(
+        _mm_shuffle_epi8(v0, _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 12, 14, 15, z, z)),
+        _mm_shuffle_epi8(v1, _mm_setr_epi8(z, z, z, z, z, z, z, z, z, z, z, z, z, z, 8, 9)));
+    const __m128i b = _mm_or_si128(
+        _mm_shuffle_epi8(v1, _mm_setr_epi8(11, z, z, z, z, z, z, z, z, z, z, z, z, z, z, z)),
+        _mm_shuffle_epi8(v2, _mm_setr_epi8(z, 0, 1, 2, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)));
+    __m128i valid = _mm_set1_epi8(-1);
+    const __m128i na = hex_to_nibbles(a, valid);
+    const __m128i nb = hex_to_nibbles(b, valid);
+    if (_mm_movemask_epi8(valid) != 0xffff) { return false; }
+    // join pairs of nibbles: hi * 16 + lo
+    const __m128i weights = _mm_set1_epi16(0x0110);
+    const __m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(na, weights), _mm_maddubs_epi16(nb, weights));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&id), _mm_shuffle_epi8(bytes, UXS_GUID_TEXT_ORDER_MASK));
+    return true;
+}
+
+#    undef UXS_GUID_TEXT_ORDER_MASK
+#endif  // UXS_USE_X86_SIMD != 0
 }  // namespace
 
+void guid::to_canonical_chars(char* p, bool upper) const noexcept {
+#if UXS_USE_X86_SIMD != 0
+    if (simd::has_cpu_feature(simd::cpu_feature::ssse3)) { return to_canonical_chars_ssse3(*this, p, upper); }
+#endif  // UXS_USE_X86_SIMD != 0
+    to_canonical_chars_scalar(*this, p, upper);
+}
+
+/*static*/ bool guid::from_canonical_chars(const char* p, guid& id) noexcept {
+#if UXS_USE_X86_SIMD != 0
+    if (simd::has_cpu_feature(simd::cpu_feature::ssse3)) { return from_canonical_chars_ssse3(p, id); }
+#endif  // UXS_USE_X86_SIMD != 0
+    return from_canonical_chars_scalar(p, id);
+}
+
 /*static*/ guid guid::generate() {
     guid id;
     std::uniform_int_distribution<std::uint32_t> distribution(0, std::numeric_limits<std::uint32_t>::max());
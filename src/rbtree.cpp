@@ -48,6 +48,31 @@ inline void rbtree_rotate_right(rbtree_node_t* node) noexcept {
     node->parent = left;
 }
 
+inline std::size_t& rbtree_size_ref(rbtree_node_t* node) noexcept {
+    return static_cast<rbtree_ranked_node_t*>(node)->size;
+}
+
+struct rbtree_rotation {
+    static void left(rbtree_node_t* node) noexcept { rbtree_rotate_left(node); }
+    static void right(rbtree_node_t* node) noexcept { rbtree_rotate_right(node); }
+};
+
+// Rotations for order-statistic tree: subtree sizes are recalculated for two rotated nodes
+struct rbtree_ranked_rotation {
+    static void left(rbtree_node_t* node) noexcept {
+        rbtree_node_t* right = node->right;
+        rbtree_rotate_left(node);
+        rbtree_size_ref(right) = rbtree_size_ref(node);
+        rbtree_size_ref(node) = rbtree_subtree_size(node->left) + rbtree_subtree_size(node->right) + 1;
+    }
+    static void right(rbtree_node_t* node) noexcept {
+        rbtree_node_t* left = node->left;
+        rbtree_rotate_right(node);
+        rbtree_size_ref(left) = rbtree_size_ref(node);
+        rbtree_size_ref(node) = rbtree_subtree_size(node->left) + rbtree_subtree_size(node->right) + 1;
+    }
+};
+
 UXS_NOALIAS rbtree_node_t* uxs::rbtree_next(rbtree_node_t* node) noexcept {
     if (node->right) { return rbtree_left_bound(node->right); }
     return rbtree_right_parent(node);
@@ -58,7 +83,8 @@ UXS_NOALIAS rbtree_node_t* uxs::rbtree_prev(rbtree_node_t* node) noexcept {
     return rbtree_left_parent(node);
 }
 
-void uxs::rbtree_insert(rbtree_node_t* head, rbtree_node_t* node, rbtree_node_t* pos, int dir) noexcept {
+template<typename Rotate>
+void rbtree_insert_impl(rbtree_node_t* head, rbtree_node_t* node, rbtree_node_t* pos, int dir) noexcept {
     node->left = node->right = nullptr;
     node->parent = pos;
     node->color = rbtree_node_t::color_t::red;
@@ -81,20 +107,20 @@ void uxs::rbtree_insert(rbtree_node_t* head, rbtree_node_t* node, rbtree_node_t*
         if (parent->left == pos) {
             if (!parent->right || parent->right->color == rbtree_node_t::color_t::black) {
                 if (node == pos->right) {
-                    rbtree_rotate_left(pos);
+                    Rotate::left(pos);
                     pos = node;
                 }
-                rbtree_rotate_right(parent);
+                Rotate::right(parent);
                 pos->color = rbtree_node_t::color_t::black;
                 return;
             }
             parent->right->color = rbtree_node_t::color_t::black;
         } else if (!parent->left || parent->left->color == rbtree_node_t::color_t::black) {
             if (node == pos->left) {
-                rbtree_rotate_right(pos);
+                Rotate::right(pos);
                 pos = node;
             }
-            rbtree_rotate_left(parent);
+            Rotate::left(parent);
             pos->color = rbtree_node_t::color_t::black;
             return;
         } else {
@@ -109,7 +135,8 @@ void uxs::rbtree_insert(rbtree_node_t* head, rbtree_node_t* node, rbtree_node_t*
     head->left->color = rbtree_node_t::color_t::black;
 }
 
-rbtree_node_t* uxs::rbtree_remove(rbtree_node_t* head, rbtree_node_t* pos) noexcept {
+template<typename Rotate>
+rbtree_node_t* rbtree_remove_impl(rbtree_node_t* head, rbtree_node_t* pos) noexcept {
     rbtree_node_t* fix = pos->right;
     rbtree_node_t* parent = pos->parent;
     rbtree_node_t::color_t color = pos->color;
@@ -200,7 +227,7 @@ rbtree_node_t* uxs::rbtree_remove(rbtree_node_t* head, rbtree_node_t* pos) noexc
             if (node->color != rbtree_node_t::color_t::black) {
                 node->color = rbtree_node_t::color_t::black;
                 parent->color = rbtree_node_t::color_t::red;
-                rbtree_rotate_left(parent);
+                Rotate::left(parent);
                 node = parent->right;
             }
 
@@ -209,14 +236,14 @@ rbtree_node_t* uxs::rbtree_remove(rbtree_node_t* head, rbtree_node_t* pos) noexc
                 if (!node->right || node->right->color == rbtree_node_t::color_t::black) {
                     node->left->color = rbtree_node_t::color_t::black;
                     node->color = rbtree_node_t::color_t::red;
-                    rbtree_rotate_right(node);
+                    Rotate::right(node);
                     node = parent->right;
                 }
 
                 node->color = parent->color;
                 parent->color = rbtree_node_t::color_t::black;
                 node->right->color = rbtree_node_t::color_t::black;
-                rbtree_rotate_left(parent);
+                Rotate::left(parent);
                 return pos;
             }
 
@@ -227,7 +254,7 @@ rbtree_node_t* uxs::rbtree_remove(rbtree_node_t* head, rbtree_node_t* pos) noexc
             if (node->color != rbtree_node_t::color_t::black) {
                 node->color = rbtree_node_t::color_t::black;
                 parent->color = rbtree_node_t::color_t::red;
-                rbtree_rotate_right(parent);
+                Rotate::right(parent);
                 node = parent->left;
             }
 
@@ -236,14 +263,14 @@ rbtree_node_t* uxs::rbtree_remove(rbtree_node_t* head, rbtree_node_t* pos) noexc
                 if (!node->left || node->left->color == rbtree_node_t::color_t::black) {
                     node->right->color = rbtree_node_t::color_t::black;
                     node->color = rbtree_node_t::color_t::red;
-                    rbtree_rotate_left(node);
+                    Rotate::left(node);
                     node = parent->left;
                 }
 
                 node->color = parent->color;
                 parent->color = rbtree_node_t::color_t::black;
                 node->left->color = rbtree_node_t::color_t::black;
-                rbtree_rotate_right(parent);
+                Rotate::right(parent);
                 return pos;
             }
 
@@ -257,3 +284,49 @@ rbtree_node_t* uxs::rbtree_remove(rbtree_node_t* head, rbtree_node_t* pos) noexc
     fix->color = rbtree_node_t::color_t::black;
     return pos;
 }
+
+void uxs::rbtree_insert(rbtree_node_t* head, rbtree_node_t* node, rbtree_node_t* pos, int dir) noexcept {
+    rbtree_insert_impl<rbtree_rotation>(head, node, pos, dir);
+}
+
+rbtree_node_t* uxs::rbtree_remove(rbtree_node_t* head, rbtree_node_t* pos) noexcept {
+    return rbtree_remove_impl<rbtree_rotation>(head, pos);
+}
+
+void uxs::rbtree_ranked_insert(rbtree_node_t* head, rbtree_node_t* node, rbtree_node_t* pos, int dir) noexcept {
+    rbtree_size_ref(node) = 1;
+    for (rbtree_node_t* p = pos; p != head; p = p->parent) { ++rbtree_size_ref(p); }
+    rbtree_insert_impl<rbtree_ranked_rotation>(head, node, pos, dir);
+}
+
+rbtree_node_t* uxs::rbtree_ranked_remove(rbtree_node_t* head, rbtree_node_t* pos) noexcept {
+    // if the node has two children, its successor is unlinked from its place and takes the place of the node
+    rbtree_node_t* unlinked = pos->left && pos->right ? rbtree_left_bound(pos->right) : pos;
+    for (rbtree_node_t* p = unlinked; p != head; p = p->parent) { --rbtree_size_ref(p); }
+    if (unlinked != pos) { rbtree_size_ref(unlinked) = rbtree_size_ref(pos); }
+    return rbtree_remove_impl<rbtree_ranked_rotation>(head, pos);
+}
+
+UXS_NOALIAS rbtree_node_t* uxs::rbtree_ranked_nth(rbtree_node_t* head, std::size_t n) noexcept {
+    rbtree_node_t* node = head->left;
+    if (n >= rbtree_subtree_size(node)) { return head; }
+    while (true) {
+        const std::size_t left_size = rbtree_subtree_size(node->left);
+        if (n == left_size) { return node; }
+        if (n < left_size) {
+            node = node->left;
+        } else {
+            n -= left_size + 1;
+            node = node->right;
+        }
+    }
+}
+
+UXS_NOALIAS std::size_t uxs::rbtree_ranked_index(const rbtree_node_t* head, const rbtree_node_t* node) noexcept {
+    if (node == head) { return rbtree_subtree_size(head->left); }
+    std::size_t index = rbtree_subtree_size(node->left);
+    for (const rbtree_node_t* parent = node->parent; parent != head; node = parent, parent = node->parent) {
+        if (node == parent->right) { index += rbtree_subtree_size(parent->left) + 1; }
+    }
+    return index;
+}
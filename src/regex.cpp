@@ -0,0 +1,701 @@
+#include "uxs/regex.h"
+
+#include "uxs/memory.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <map>
+#include <mutex>
+
+using namespace uxs;
+
+regex_error::regex_error(const char* message) : std::runtime_error(message) {}
+regex_error::regex_error(const std::string& message) : std::runtime_error(message) {}
+const char* regex_error::what() const noexcept { return std::runtime_error::what(); }
+
+namespace {
+
+using code_range_t = std::pair<std::uint32_t, std::uint32_t>;
+using code_set_t = std::vector<code_range_t>;
+
+enum : std::uint32_t { unlimited_count = ~std::uint32_t(0), max_repeat_count = 1000, max_inst_count = 100000 };
+
+// ---- parser
+
+enum class node_type : std::uint8_t { empty = 0, chars, concat, alter, repeat, assert_begin, assert_end };
+
+struct node_t {
+    node_type type;
+    std::uint32_t a;  // set index or the first operand
+    std::uint32_t b;  // the second operand
+    std::uint32_t min_count;
+    std::uint32_t max_count;
+    bool greedy;
+};
+
+void normalize_code_set(code_set_t& set) {
+    if (set.empty()) { return; }
+    std::sort(set.begin(), set.end());
+    auto out = set.begin();
+    for (auto it = set.begin() + 1; it != set.end(); ++it) {
+        if (it->first <= out->second || it->first - out->second == 1) {
+            out->second = std::max(out->second, it->second);
+        } else {
+            *++out = *it;
+        }
+    }
+    set.erase(out + 1, set.end());
+}
+
+code_set_t invert_code_set(const code_set_t& set, std::uint32_t max_code) {
+    code_set_t result;
+    std::uint32_t from = 0;
+    for (const auto& r : set) {
+        if (r.first > from) { result.emplace_back(from, r.first - 1); }
+        if (r.second == max_code) { return result; }
+        from = r.second + 1;
+    }
+    result.emplace_back(from, max_code);
+    return result;
+}
+
+class parser {
+ public:
+    parser(std::vector<std::uint32_t> pattern, std::uint32_t max_code)
+        : pattern_(std::move(pattern)), max_code_(max_code) {}
+
+    std::uint32_t parse() {
+        const std::uint32_t n = parse_alter();
+        if (pos_ != pattern_.size()) { throw regex_error("unmatched `)`"); }
+        return n;
+    }
+
+    std::vector<node_t>& nodes() { return nodes_; }
+    std::vector<code_set_t>& sets() { return sets_; }
+
+ private:
+    std::vector<std::uint32_t> pattern_;
+    std::uint32_t max_code_;
+    std::size_t pos_ = 0;
+    std::vector<node_t> nodes_;
+    std::vector<code_set_t> sets_;
+
+    bool at_end() const { return pos_ == pattern_.size(); }
+    std::uint32_t peek() const { return pattern_[pos_]; }
+    bool skip_if(std::uint32_t ch) {
+        if (at_end() || pattern_[pos_] != ch) { return false; }
+        ++pos_;
+        return true;
+    }
+
+    std::uint32_t new_node(node_type type, std::uint32_t a = 0, std::uint32_t b = 0) {
+        nodes_.push_back(node_t{type, a, b, 0, 0, true});
+        return static_cast<std::uint32_t>(nodes_.size() - 1);
+    }
+
+    std::uint32_t new_chars_node(code_set_t set) {
+        normalize_code_set(set);
+        sets_.push_back(std::move(set));
+        return new_node(node_type::chars, static_cast<std::uint32_t>(sets_.size() - 1));
+    }
+
+    std::uint32_t parse_alter() {
+        std::uint32_t n = parse_concat();
+        while (skip_if('|')) { n = new_node(node_type::alter, n, parse_concat()); }
+        return n;
+    }
+
+    std::uint32_t parse_concat() {
+        std::uint32_t n = new_node(node_type::empty);
+        while (!at_end() && peek() != '|' && peek() != ')') {
+            const std::uint32_t m = parse_repeat();
+            n = nodes_[n].type != node_type::empty ? new_node(node_type::concat, n, m) : m;
+        }
+        return n;
+    }
+
+    std::uint32_t parse_count() {
+        std::uint32_t count = 0;
+        if (at_end() || dig_v(peek()) >= 10) { throw regex_error("invalid repetition count"); }
+        do {
+            count = 10 * count + dig_v(pattern_[pos_++]);
+            if (count > max_repeat_count) { throw regex_error("too big repetition count"); }
+        } while (!at_end() && dig_v(peek()) < 10);
+        return count;
+    }
+
+    std::uint32_t parse_repeat() {
+        std::uint32_t n = parse_atom();
+        while (!at_end()) {
+            std::uint32_t min_count = 0, max_count = unlimited_count;
+            if (skip_if('*')) {
+            } else if (skip_if('+')) {
+                min_count = 1;
+            } else if (skip_if('?')) {
+                max_count = 1;
+            } else if (skip_if('{')) {
+                min_count = max_count = parse_count();
+                if (skip_if(',')) { max_count = !at_end() && peek() == '}' ? unlimited_count : parse_count(); }
+                if (!skip_if('}') || max_count < min_count) { throw regex_error("invalid repetition count"); }
+            } else {
+                break;
+            }
+            const bool greedy = !skip_if('?');
+            n = new_node(node_type::repeat, n);
+            nodes_[n].min_count = min_count, nodes_[n].max_count = max_count, nodes_[n].greedy = greedy;
+        }
+        return n;
+    }
+
+    std::uint32_t parse_atom() {
+        const std::uint32_t ch = pattern_[pos_++];
+        switch (ch) {
+            case '(': {
+                if (skip_if('?') && !skip_if(':')) { throw regex_error("lookarounds are not supported"); }
+                const std::uint32_t n = parse_alter();
+                if (!skip_if(')')) { throw regex_error("unmatched `(`"); }
+                return n;
+            } break;
+            case '[': return new_chars_node(parse_class());
+            case '.': return new_chars_node(invert_code_set({{'\n', '\n'}, {'\r', '\r'}}, max_code_));
+            case '^': return new_node(node_type::assert_begin);
+            case '$': return new_node(node_type::assert_end);
+            case '\\': {
+                code_set_t set;
+                if (parse_escape(set, false)) { return new_chars_node(std::move(set)); }
+                return new_chars_node({{pattern_[pos_ - 1], pattern_[pos_ - 1]}});
+            } break;
+            case '*':
+            case '+':
+            case '?':
+            case '{': throw regex_error("nothing to repeat");
+            default: break;
+        }
+        return new_chars_node({{ch, ch}});
+    }
+
+    code_set_t parse_class() {
+        code_set_t set;
+        const bool invert = skip_if('^');
+        while (!skip_if(']')) {
+            if (at_end()) { throw regex_error("unmatched `[`"); }
+            std::uint32_t lo = pattern_[pos_++];
+            if (lo == '\\' && parse_escape(set, true)) { continue; }
+            if (lo == '\\') { lo = pattern_[pos_ - 1]; }
+            std::uint32_t hi = lo;
+            if (pos_ + 1 < pattern_.size() && peek() == '-' && pattern_[pos_ + 1] != ']') {
+                hi = pattern_[++pos_];
+                ++pos_;
+                code_set_t tmp;
+                if (hi == '\\') {
+                    if (parse_escape(tmp, true)) { throw regex_error("invalid character range"); }
+                    hi = pattern_[pos_ - 1];
+                }
+                if (hi < lo) { throw regex_error("invalid character range"); }
+            }
+            set.emplace_back(lo, hi);
+        }
+        if (!invert) { return set; }
+        normalize_code_set(set);
+        return invert_code_set(set, max_code_);
+    }
+
+    std::uint32_t parse_hex(unsigned n_digs) {
+        std::uint32_t code = 0;
+        for (; n_digs; --n_digs) {
+            const unsigned dig = !at_end() ? dig_v(peek()) : 16;
+            if (dig >= 16) { throw regex_error("invalid escape sequence"); }
+            code = (code << 4) | dig, ++pos_;
+        }
+        return code;
+    }
+
+    // Parses escape sequence after `\`; returns `true` if it is a character class, otherwise the escaped
+    // character is replaced in the pattern, so `pattern_[pos_ - 1]` is the character
+    bool parse_escape(code_set_t& set, bool in_class) {
+        if (at_end()) { throw regex_error("invalid escape sequence"); }
+        const std::uint32_t ch = pattern_[pos_++];
+        code_set_t cls;
+        switch (ch) {
+            case 'd':
+            case 'D': cls = {{'0', '9'}}; break;
+            case 'w':
+            case 'W': cls = {{'0', '9'}, {'A', 'Z'}, {'_', '_'}, {'a', 'z'}}; break;
+            case 's':
+            case 'S': cls = {{'\t', '\r'}, {' ', ' '}}; break;
+            case 'n': pattern_[pos_ - 1] = '\n'; return false;
+            case 'r': pattern_[pos_ - 1] = '\r'; return false;
+            case 't': pattern_[pos_ - 1] = '\t'; return false;
+            case 'f': pattern_[pos_ - 1] = '\f'; return false;
+            case 'v': pattern_[pos_ - 1] = '\v'; return false;
+            case '0': pattern_[pos_ - 1] = '\0'; return false;
+            case 'x':
+            case 'u': {
+                const std::uint32_t code = parse_hex(ch == 'x' ? 2 : 4);
+                if (code > max_code_) { throw regex_error("invalid escape sequence"); }
+                pattern_[pos_ - 1] = code;
+                return false;
+            } break;
+            case 'b': {
+                if (!in_class) { throw regex_error("word boundary assertions are not supported"); }
+                pattern_[pos_ - 1] = '\b';
+                return false;
+            } break;
+            case 'B': throw regex_error("word boundary assertions are not supported");
+            default: {
+                if (dig_v(ch) < 10) { throw regex_error("back references are not supported"); }
+                return false;
+            } break;
+        }
+        if (ch == 'D' || ch == 'W' || ch == 'S') { cls = invert_code_set(cls, max_code_); }
+        set.insert(set.end(), cls.begin(), cls.end());
+        return true;
+    }
+};
+
+// ---- program
+
+enum class op_t : std::uint8_t { chars = 0, split, match, assert_begin, assert_end };
+
+struct inst_t {
+    op_t op;
+    std::uint32_t next;
+    std::uint32_t arg;  // set index for `chars`, alternative for `split`
+};
+
+struct program_t {
+    std::vector<inst_t> insts;
+    std::uint32_t start = 0;
+};
+
+// Builds the program from the end, so each instruction is created after its continuation;
+// reversed program matches reversed texts
+class compiler {
+ public:
+    compiler(const std::vector<node_t>& nodes, bool reversed) : nodes_(nodes), reversed_(reversed) {}
+
+    program_t compile(std::uint32_t root) {
+        program_t prog;
+        prog_ = &prog;
+        const std::uint32_t match = emit(op_t::match, 0);
+        prog.start = compile_node(root, match);
+        return prog;
+    }
+
+ private:
+    const std::vector<node_t>& nodes_;
+    bool reversed_;
+    program_t* prog_ = nullptr;
+
+    std::uint32_t emit(op_t op, std::uint32_t next, std::uint32_t arg = 0) {
+        if (prog_->insts.size() >= max_inst_count) { throw regex_error("regular expression is too complex"); }
+        prog_->insts.push_back(inst_t{op, next, arg});
+        return static_cast<std::uint32_t>(prog_->insts.size() - 1);
+    }
+
+    std::uint32_t split(std::uint32_t first, std::uint32_t second, bool greedy) {
+        return greedy ? emit(op_t::split, first, second) : emit(op_t::split, second, first);
+    }
+
+    std::uint32_t compile_node(std::uint32_t n, std::uint32_t next) {
+        const node_t& node = nodes_[n];
+        switch (node.type) {
+            case node_type::empty: return next;
+            case node_type::chars: return emit(op_t::chars, next, node.a);
+            case node_type::concat: {
+                if (reversed_) { return compile_node(node.b, compile_node(node.a, next)); }
+                return compile_node(node.a, compile_node(node.b, next));
+            } break;
+            case node_type::alter: {
+                const std::uint32_t first = compile_node(node.a, next);
+                return split(first, compile_node(node.b, next), true);
+            } break;
+            case node_type::repeat: {
+                std::uint32_t curr = next;
+                if (node.max_count == unlimited_count) {
+                    curr = emit(op_t::split, 0, 0);
+                    const std::uint32_t body = compile_node(node.a, curr);
+                    prog_->insts[curr] = inst_t{op_t::split, node.greedy ? body : next, node.greedy ? next : body};
+                } else {
+                    for (std::uint32_t i = node.min_count; i < node.max_count; ++i) {
+                        curr = split(compile_node(node.a, curr), next, node.greedy);
+                    }
+                }
+                for (std::uint32_t i = 0; i < node.min_count; ++i) { curr = compile_node(node.a, curr); }
+                return curr;
+            } break;
+            case node_type::assert_begin: return emit(reversed_ ? op_t::assert_end : op_t::assert_begin, next);
+            case node_type::assert_end: return emit(reversed_ ? op_t::assert_begin : op_t::assert_end, next);
+        }
+        return next;
+    }
+};
+
+// ---- alphabet
+
+// Code units are split into classes, so that each character set includes a class entirely
+class alphabet_t {
+ public:
+    explicit alphabet_t(const std::vector<code_set_t>& sets) {
+        for (const auto& set : sets) {
+            for (const auto& r : set) {
+                bounds_.push_back(r.first);
+                if (r.second != ~std::uint32_t(0)) { bounds_.push_back(r.second + 1); }
+            }
+        }
+        std::sort(bounds_.begin(), bounds_.end());
+        bounds_.erase(std::unique(bounds_.begin(), bounds_.end()), bounds_.end());
+        if (!bounds_.empty() && bounds_[0] == 0) { bounds_.erase(bounds_.begin()); }
+        count_ = static_cast<std::uint32_t>(bounds_.size() + 1);
+        for (std::uint32_t code = 0; code < low_.size(); ++code) { low_[code] = find_class(code); }
+        set_classes_.resize(sets.size() * count_);
+        for (std::size_t i = 0; i < sets.size(); ++i) {
+            for (const auto& r : sets[i]) {
+                for (std::uint32_t cls = find_class(r.first); cls <= find_class(r.second); ++cls) {
+                    set_classes_[i * count_ + cls] = 1;
+                }
+            }
+        }
+    }
+
+    std::uint32_t count() const noexcept { return count_; }
+    std::uint32_t get(std::uint32_t code) const noexcept { return code < low_.size() ? low_[code] : find_class(code); }
+    bool contains(std::uint32_t set, std::uint32_t cls) const noexcept { return set_classes_[set * count_ + cls]; }
+
+ private:
+    std::vector<std::uint32_t> bounds_;
+    std::uint32_t count_;
+    std::array<std::uint32_t, 256> low_;
+    std::vector<std::uint8_t> set_classes_;
+
+    std::uint32_t find_class(std::uint32_t code) const noexcept {
+        return static_cast<std::uint32_t>(std::upper_bound(bounds_.begin(), bounds_.end(), code) - bounds_.begin());
+    }
+};
+
+// ---- lazy DFA
+
+// Each state is the list of program threads ordered by priority; in `leftmost-first` mode threads
+// following a matched thread are dropped, so the state reproduces backtracking semantics. In unanchored
+// mode a new thread is started at each position with the lowest priority until the first match is found
+class dfa_t {
+ public:
+    enum : std::uint32_t { dead_state = 0, max_state_count = 4096 };
+
+    dfa_t(const program_t& prog, const alphabet_t& alphabet, bool longest, bool unanchored)
+        : prog_(prog), alphabet_(alphabet), longest_(longest), unanchored_(unanchored),
+          restart_(static_cast<std::uint32_t>(prog.insts.size())), marks_(prog.insts.size() + 1) {
+        reset();
+    }
+
+    std::uint32_t start(bool at_boundary) {
+        std::uint32_t& s = start_[at_boundary ? 1 : 0];
+        if (s != unknown_state) { return s; }
+        begin_list();
+        add_thread(prog_.start, at_boundary);
+        if (unanchored_) { add_restart(); }
+        return (s = intern_list());
+    }
+
+    std::uint32_t next(std::uint32_t s, std::uint32_t cls) {
+        const std::uint32_t t = trans_[s * alphabet_.count() + cls];
+        return t != unknown_state ? t : calc_next(s, cls);
+    }
+
+    bool is_match(std::uint32_t s) const noexcept { return states_[s].is_match; }
+
+    // Checks if some thread matches at the end of the text; `at_begin` is `true` for empty texts
+    bool is_match_at_end(std::uint32_t s, bool at_begin) {
+        int& result = states_[s].match_at_end[at_begin ? 1 : 0];
+        if (result < 0) { result = calc_match_at_end(s, at_begin) ? 1 : 0; }
+        return result != 0;
+    }
+
+ private:
+    enum : std::uint32_t { unknown_state = ~std::uint32_t(0) };
+
+    struct state_t {
+        std::vector<std::uint32_t> threads;
+        bool is_match;
+        int match_at_end[2];
+    };
+
+    const program_t& prog_;
+    const alphabet_t& alphabet_;
+    bool longest_;
+    bool unanchored_;
+    std::uint32_t restart_;  // pseudo-thread starting new threads
+    std::vector<state_t> states_;
+    std::map<std::vector<std::uint32_t>, std::uint32_t> index_;
+    std::vector<std::uint32_t> trans_;
+    std::uint32_t start_[2];
+    std::vector<std::uint32_t> list_;
+    std::vector<std::uint32_t> stack_;
+    std::vector<std::uint32_t> marks_;
+    std::uint32_t mark_ = 0;
+    bool is_cut_ = false;
+
+    void reset() {
+        states_.clear(), index_.clear(), trans_.clear();
+        start_[0] = start_[1] = unknown_state;
+        list_.clear();
+        intern_list();  // dead state
+    }
+
+    void begin_list() {
+        list_.clear();
+        is_cut_ = false;
+        if (++mark_ == 0) {
+            std::fill(marks_.begin(), marks_.end(), 0);
+            mark_ = 1;
+        }
+    }
+
+    void add_thread(std::uint32_t pc, bool at_begin) {
+        if (is_cut_) { return; }
+        stack_.push_back(pc);
+        while (!stack_.empty()) {
+            pc = stack_.back();
+            stack_.pop_back();
+            if (marks_[pc] == mark_) { continue; }
+            marks_[pc] = mark_;
+            const inst_t& inst = prog_.insts[pc];
+            switch (inst.op) {
+                case op_t::chars:
+                case op_t::assert_end: list_.push_back(pc); break;
+                case op_t::match: {
+                    list_.push_back(pc);
+                    if (!longest_) {
+                        is_cut_ = true;
+                        stack_.clear();
+                        return;
+                    }
+                } break;
+                case op_t::split: stack_.push_back(inst.arg), stack_.push_back(inst.next); break;
+                case op_t::assert_begin: {
+                    if (at_begin) { stack_.push_back(inst.next); }
+                } break;
+            }
+        }
+    }
+
+    void add_restart() {
+        if (is_cut_) { return; }
+        add_thread(prog_.start, false);
+        if (!is_cut_) { list_.push_back(restart_); }
+    }
+
+    std::uint32_t intern_list() {
+        const auto it = index_.find(list_);
+        if (it != index_.end()) { return it->second; }
+        const std::uint32_t s = static_cast<std::uint32_t>(states_.size());
+        const bool is_match = std::any_of(list_.begin(), list_.end(), [this](std::uint32_t pc) {
+            return pc != restart_ && prog_.insts[pc].op == op_t::match;
+        });
+        states_.push_back(state_t{list_, is_match, {-1, -1}});
+        index_.emplace(list_, s);
+        trans_.resize(states_.size() * alphabet_.count(), unknown_state);
+        return s;
+    }
+
+    std::uint32_t calc_next(std::uint32_t s, std::uint32_t cls) {
+        if (states_.size() >= max_state_count) {
+            // drop all cached states, but keep the current state
+            std::vector<std::uint32_t> threads = std::move(states_[s].threads);
+            reset();
+            list_ = std::move(threads);
+            s = intern_list();
+        }
+        begin_list();
+        for (const std::uint32_t pc : states_[s].threads) {
+            if (pc == restart_) {
+                add_restart();
+                continue;
+            }
+            const inst_t& inst = prog_.insts[pc];
+            if (inst.op == op_t::chars && alphabet_.contains(inst.arg, cls)) { add_thread(inst.next, false); }
+        }
+        const std::uint32_t t = intern_list();
+        trans_[s * alphabet_.count() + cls] = t;
+        return t;
+    }
+
+    bool calc_match_at_end(std::uint32_t s, bool at_begin) {
+        begin_list();
+        for (const std::uint32_t thread : states_[s].threads) {
+            stack_.push_back(thread != restart_ ? thread : prog_.start);
+            while (!stack_.empty()) {
+                const std::uint32_t pc = stack_.back();
+                stack_.pop_back();
+                if (marks_[pc] == mark_) { continue; }
+                marks_[pc] = mark_;
+                const inst_t& inst = prog_.insts[pc];
+                switch (inst.op) {
+                    case op_t::match: stack_.clear(); return true;
+                    case op_t::split: stack_.push_back(inst.arg), stack_.push_back(inst.next); break;
+                    case op_t::assert_end: stack_.push_back(inst.next); break;
+                    case op_t::assert_begin: {
+                        if (at_begin) { stack_.push_back(inst.next); }
+                    } break;
+                    default: break;
+                }
+            }
+        }
+        return false;
+    }
+};
+
+template<typename CharT>
+std::uint32_t code_unit(CharT ch) noexcept {
+    return static_cast<typename std::make_unsigned<CharT>::type>(ch);
+}
+
+// Returns the end of the last found match or `nullptr`
+template<typename CharT>
+const CharT* scan_forward(dfa_t& dfa, const alphabet_t& alphabet, const CharT* first, const CharT* last,
+                          bool at_boundary) {
+    std::uint32_t s = dfa.start(at_boundary);
+    const CharT* match = dfa.is_match(s) ? first : nullptr;
+    const bool is_empty = first == last;
+    for (; first != last; ++first) {
+        s = dfa.next(s, alphabet.get(code_unit(*first)));
+        if (s == dfa_t::dead_state) { return match; }
+        if (dfa.is_match(s)) { match = first + 1; }
+    }
+    return dfa.is_match_at_end(s, is_empty && at_boundary) ? last : match;
+}
+
+// Returns the beginning of the last found match or `nullptr`; the text is read backward
+template<typename CharT>
+const CharT* scan_backward(dfa_t& dfa, const alphabet_t& alphabet, const CharT* first, const CharT* last,
+                           bool at_boundary) {
+    std::uint32_t s = dfa.start(at_boundary);
+    const CharT* match = dfa.is_match(s) ? last : nullptr;
+    const bool is_empty = first == last;
+    while (last != first) {
+        s = dfa.next(s, alphabet.get(code_unit(*--last)));
+        if (s == dfa_t::dead_state) { return match; }
+        if (dfa.is_match(s)) { match = last; }
+    }
+    return dfa.is_match_at_end(s, is_empty && at_boundary) ? first : match;
+}
+
+}  // namespace
+
+namespace uxs {
+namespace detail {
+
+class regex_impl {
+ public:
+    regex_impl(std::vector<std::uint32_t> pattern, std::uint32_t max_code) {
+        parser p(std::move(pattern), max_code);
+        const std::uint32_t root = p.parse();
+        fwd_prog_ = compiler(p.nodes(), false).compile(root);
+        rev_prog_ = compiler(p.nodes(), true).compile(root);
+        sets_ = std::move(p.sets());
+        init();
+    }
+
+    regex_impl(const regex_impl& other) : fwd_prog_(other.fwd_prog_), rev_prog_(other.rev_prog_), sets_(other.sets_) {
+        init();
+    }
+
+    regex_impl& operator=(const regex_impl&) = delete;
+
+    // The end of the leftmost match is found by forward scanning, and then its beginning is found
+    // by backward scanning from the end
+    template<typename CharT>
+    std::pair<const CharT*, const CharT*> find(const CharT* first, const CharT* last) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const CharT* match_last = scan_forward(*fwd_search_, *alphabet_, first, last, true);
+        if (!match_last) { return std::make_pair(last, last); }
+        return std::make_pair(scan_backward(*rev_longest_, *alphabet_, first, match_last, match_last == last),
+                              match_last);
+    }
+
+    template<typename CharT>
+    std::pair<const CharT*, const CharT*> rfind(const CharT* first, const CharT* last) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const CharT* match_first = scan_backward(*rev_search_, *alphabet_, first, last, true);
+        if (!match_first) { return std::make_pair(first, first); }
+        return std::make_pair(match_first,
+                              scan_forward(*fwd_longest_, *alphabet_, match_first, last, match_first == first));
+    }
+
+    template<typename CharT>
+    bool match(const CharT* first, const CharT* last) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return scan_forward(*fwd_longest_, *alphabet_, first, last, true) == last;
+    }
+
+ private:
+    program_t fwd_prog_;
+    program_t rev_prog_;
+    std::vector<code_set_t> sets_;
+    std::unique_ptr<alphabet_t> alphabet_;
+    std::unique_ptr<dfa_t> fwd_search_;
+    std::unique_ptr<dfa_t> fwd_longest_;
+    std::unique_ptr<dfa_t> rev_search_;
+    std::unique_ptr<dfa_t> rev_longest_;
+    std::mutex mutex_;  // guards automaton states built on demand
+
+    void init() {
+        alphabet_ = est::make_unique<alphabet_t>(sets_);
+        fwd_search_ = est::make_unique<dfa_t>(fwd_prog_, *alphabet_, false, true);
+        fwd_longest_ = est::make_unique<dfa_t>(fwd_prog_, *alphabet_, true, false);
+        rev_search_ = est::make_unique<dfa_t>(rev_prog_, *alphabet_, false, true);
+        rev_longest_ = est::make_unique<dfa_t>(rev_prog_, *alphabet_, true, false);
+    }
+};
+
+}  // namespace detail
+
+template<typename CharT>
+basic_regex<CharT>::basic_regex(std::basic_string_view<CharT> pattern) {
+    std::vector<std::uint32_t> codes;
+    codes.reserve(pattern.size());
+    for (const CharT ch : pattern) { codes.push_back(code_unit(ch)); }
+    impl_ = est::make_unique<detail::regex_impl>(std::move(codes),
+                                                 std::numeric_limits<typename std::make_unsigned<CharT>::type>::max());
+}
+
+template<typename CharT>
+basic_regex<CharT>::basic_regex(const basic_regex& other)
+    : impl_(other.impl_ ? est::make_unique<detail::regex_impl>(*other.impl_) : nullptr) {}
+
+template<typename CharT>
+basic_regex<CharT>& basic_regex<CharT>::operator=(const basic_regex& other) {
+    if (&other == this) { return *this; }
+    impl_ = other.impl_ ? est::make_unique<detail::regex_impl>(*other.impl_) : nullptr;
+    return *this;
+}
+
+template<typename CharT>
+basic_regex<CharT>::basic_regex(basic_regex&& other) noexcept = default;
+template<typename CharT>
+basic_regex<CharT>& basic_regex<CharT>::operator=(basic_regex&& other) noexcept = default;
+template<typename CharT>
+basic_regex<CharT>::~basic_regex() = default;
+
+template<typename CharT>
+std::pair<const CharT*, const CharT*> basic_regex<CharT>::find(const CharT* first, const CharT* last) const {
+    if (!impl_) { return std::make_pair(last, last); }
+    return impl_->find(first, last);
+}
+
+template<typename CharT>
+std::pair<const CharT*, const CharT*> basic_regex<CharT>::rfind(const CharT* first, const CharT* last) const {
+    if (!impl_) { return std::make_pair(first, first); }
+    return impl_->rfind(first, last);
+}
+
+template<typename CharT>
+bool basic_regex<CharT>::match(const CharT* first, const CharT* last) const {
+    return impl_ && impl_->match(first, last);
+}
+
+template class basic_regex<char>;
+template class basic_regex<wchar_t>;
+
+}  // namespace uxs
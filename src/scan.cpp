@@ -0,0 +1,337 @@
+#include "uxs/scan.h"
+
+#include <cstring>
+
+using namespace uxs;
+
+namespace {
+
+template<typename CharT>
+class string_scan_input {
+ public:
+    enum : bool { is_contiguous = true };
+    explicit string_scan_input(std::basic_string_view<CharT> s) noexcept
+        : first_(s.data()), curr_(s.data()), last_(s.data() + s.size()) {}
+    const CharT* curr() const noexcept { return curr_; }
+    const CharT* last() const noexcept { return last_; }
+    void advance_to(const CharT* p) noexcept { curr_ = p; }
+    bool fetch() noexcept { return false; }
+    std::size_t n_read() const noexcept { return curr_ - first_; }
+
+ private:
+    const CharT* first_;
+    const CharT* curr_;
+    const CharT* last_;
+};
+
+template<typename CharT>
+class ibuf_scan_input {
+ public:
+    enum : bool { is_contiguous = false };
+    explicit ibuf_scan_input(basic_ibuf<CharT>& in) noexcept : in_(in) {}
+    const CharT* curr() const noexcept { return in_.first_avail(); }
+    const CharT* last() const noexcept { return in_.last_avail(); }
+    void advance_to(const CharT* p) noexcept {
+        n_read_ += p - curr();
+        in_.advance(p - curr());
+    }
+    bool fetch() { return in_.peek() != iotraits<CharT>::eof(); }
+    std::size_t n_read() const noexcept { return n_read_; }
+
+ private:
+    basic_ibuf<CharT>& in_;
+    std::size_t n_read_ = 0;
+};
+
+template<typename Input>
+bool skip_spaces(Input& in) {
+    do {
+        auto* p = in.curr();
+        while (p != in.last() && is_space(*p)) { ++p; }
+        in.advance_to(p);
+        if (p != in.last()) { return true; }
+    } while (in.fetch());
+    return false;
+}
+
+// Consumes the longest sequence of characters satisfying the predicate, but not more than `width`;
+// for contiguous input the result always references the input, otherwise the sequence is copied
+// to the buffer only if it crosses the input window boundary
+template<typename CharT, typename Input, typename Pred>
+std::basic_string_view<CharT> read_field(Input& in, std::size_t width, Pred pred,
+                                         inline_basic_dynbuffer<CharT>& buf) {
+    const CharT* first = in.curr();
+    const CharT* p = first;
+    std::size_t n_left = width ? width : std::numeric_limits<std::size_t>::max();
+    if (Input::is_contiguous) {
+        const CharT* last = static_cast<std::size_t>(in.last() - p) > n_left ? p + n_left : in.last();
+        while (p != last && pred(*p)) { ++p; }
+        in.advance_to(p);
+        return std::basic_string_view<CharT>(first, p - first);
+    }
+    while (true) {
+        const CharT* last = static_cast<std::size_t>(in.last() - p) > n_left ? p + n_left : in.last();
+        const CharT* p0 = p;
+        while (p != last && pred(*p)) { ++p; }
+        n_left -= p - p0;
+        if (p != in.last() || !n_left) { break; }
+        buf.append(first, p);
+        in.advance_to(p);
+        if (!in.fetch()) { return std::basic_string_view<CharT>(buf.data(), buf.size()); }
+        first = p = in.curr();
+    }
+    in.advance_to(p);
+    if (!buf.size()) { return std::basic_string_view<CharT>(first, p - first); }
+    buf.append(first, p);
+    return std::basic_string_view<CharT>(buf.data(), buf.size());
+}
+
+template<typename CharT>
+struct integer_field {
+    unsigned base;
+    bool is_first = true;
+    explicit integer_field(unsigned b) : base(b) {}
+    bool operator()(CharT ch) {
+        const bool is_sign = is_first && (ch == '+' || ch == '-');
+        is_first = false;
+        return is_sign || dig_v(ch) < base;
+    }
+};
+
+// Accepts the longest prefix of a floating-point number: `[+-]digits[.digits][(e|E)[+-]digits]`,
+// `[+-]inf` or `[+-]nan`; the prefix is validated later by the parser
+template<typename CharT>
+struct float_field {
+    const char* word = nullptr;  // rest of `inf` or `nan` being matched
+    bool has_dot = false;
+    bool has_exp = false;
+    CharT prev = 0;
+    bool operator()(CharT ch) {
+        bool result = false;
+        if (word) {
+            result = *word && ch == static_cast<CharT>(*word);
+            if (result) { ++word; }
+            return result;
+        }
+        if (ch == '+' || ch == '-') {
+            result = !prev || prev == 'e' || prev == 'E';
+        } else if (dig_v(ch) < 10) {
+            result = true;
+        } else if (ch == '.') {
+            result = !has_dot && !has_exp;
+            has_dot = true;
+        } else if (ch == 'e' || ch == 'E') {
+            result = !has_exp && (dig_v(prev) < 10 || prev == '.');
+            has_exp = true;
+        } else if ((ch == 'i' || ch == 'n') && (!prev || prev == '+' || prev == '-')) {
+            word = ch == 'i' ? "nf" : "an";
+            result = true;
+        }
+        prev = ch;
+        return result;
+    }
+};
+
+template<typename CharT>
+bool parse_integer(std::basic_string_view<CharT> s, unsigned base, bool is_signed, std::uint64_t pos_limit,
+                   std::uint64_t& val) {
+    const CharT* p = s.data();
+    const CharT* end = s.data() + s.size();
+    bool neg = false;
+    if (p != end && (*p == '+' || *p == '-')) { neg = *p++ == '-'; }
+    if (p == end) { return false; }
+    std::uint64_t v = 0;
+    for (; p != end; ++p) {
+        const unsigned dig = dig_v(*p);
+        if (dig >= base || v > (std::numeric_limits<std::uint64_t>::max() - dig) / base) { return false; }
+        v = base * v + dig;
+    }
+    if (neg) {
+        if (!is_signed || v > pos_limit + 1) { return false; }
+        v = ~v + 1;
+    } else if (v > pos_limit) {
+        return false;
+    }
+    val = v;
+    return true;
+}
+
+template<typename Ty>
+void store_value(void* p, std::uint64_t val) {
+    const Ty v = static_cast<Ty>(val);
+    std::memcpy(p, &v, sizeof(Ty));
+}
+
+template<typename Ty, typename CharT>
+bool parse_float(std::basic_string_view<CharT> s, void* val) {
+    const CharT* last = s.data();
+    const Ty v = scvt::to_float<Ty>(s.data(), s.data() + s.size(), last);
+    if (s.empty() || last != s.data() + s.size()) { return false; }
+    *static_cast<Ty*>(val) = v;
+    return true;
+}
+
+template<typename CharT, typename Input>
+scan_errc scan_integer(Input& in, detail::scan_arg arg, std::size_t width, CharT type,
+                       inline_basic_dynbuffer<CharT>& buf) {
+    unsigned base = 10;
+    switch (type) {
+        case 'x':
+        case 'X': base = 16; break;
+        case 'o': base = 8; break;
+        case 'b':
+        case 'B': base = 2; break;
+        default: break;
+    }
+    const auto s = read_field(in, width, integer_field<CharT>(base), buf);
+    std::uint64_t val = 0;
+    switch (arg.type) {
+#define UXS_SCAN_INTEGER_CASE(index, ty) \
+    case detail::scan_arg_type::index: { \
+        if (!parse_integer(s, base, std::is_signed<ty>::value, std::numeric_limits<ty>::max(), val)) { \
+            return scan_errc::invalid_value; \
+        } \
+        store_value<ty>(arg.val, val); \
+    } break;
+        UXS_SCAN_INTEGER_CASE(int8, std::int8_t)
+        UXS_SCAN_INTEGER_CASE(int16, std::int16_t)
+        UXS_SCAN_INTEGER_CASE(int32, std::int32_t)
+        UXS_SCAN_INTEGER_CASE(int64, std::int64_t)
+        UXS_SCAN_INTEGER_CASE(uint8, std::uint8_t)
+        UXS_SCAN_INTEGER_CASE(uint16, std::uint16_t)
+        UXS_SCAN_INTEGER_CASE(uint32, std::uint32_t)
+        UXS_SCAN_INTEGER_CASE(uint64, std::uint64_t)
+#undef UXS_SCAN_INTEGER_CASE
+        default: UXS_UNREACHABLE_CODE;
+    }
+    return scan_errc::ok;
+}
+
+template<typename CharT, typename Input>
+scan_errc scan_field(Input& in, detail::scan_arg arg, std::size_t width, CharT type,
+                     inline_basic_dynbuffer<CharT>& buf) {
+    if (arg.type != detail::scan_arg_type::character ? !skip_spaces(in) :
+                                                        in.curr() == in.last() && !in.fetch()) {
+        return scan_errc::eof;
+    }
+
+    buf.clear();
+    switch (arg.type) {
+        case detail::scan_arg_type::boolean: {
+            const auto s = read_field(in, width, [](CharT ch) { return is_alnum(ch); }, buf);
+            const CharT* last = s.data();
+            const bool val = scvt::to_boolean(s.data(), s.data() + s.size(), last);
+            if (s.empty() || last != s.data() + s.size()) { return scan_errc::invalid_value; }
+            *static_cast<bool*>(arg.val) = val;
+        } break;
+        case detail::scan_arg_type::character: {
+            *static_cast<CharT*>(arg.val) = *in.curr();
+            in.advance_to(in.curr() + 1);
+        } break;
+        case detail::scan_arg_type::int8:
+        case detail::scan_arg_type::int16:
+        case detail::scan_arg_type::int32:
+        case detail::scan_arg_type::int64:
+        case detail::scan_arg_type::uint8:
+        case detail::scan_arg_type::uint16:
+        case detail::scan_arg_type::uint32:
+        case detail::scan_arg_type::uint64: return scan_integer(in, arg, width, type, buf);
+        case detail::scan_arg_type::float32:
+        case detail::scan_arg_type::float64:
+        case detail::scan_arg_type::long_double: {
+            const auto s = read_field(in, width, float_field<CharT>{}, buf);
+            bool ok = false;
+            if (arg.type == detail::scan_arg_type::float32) {
+                ok = parse_float<float>(s, arg.val);
+            } else if (arg.type == detail::scan_arg_type::float64) {
+                ok = parse_float<double>(s, arg.val);
+            } else {
+                ok = parse_float<long double>(s, arg.val);
+            }
+            if (!ok) { return scan_errc::invalid_value; }
+        } break;
+        case detail::scan_arg_type::string: {
+            const auto s = read_field(in, width, [](CharT ch) { return !is_space(ch); }, buf);
+            static_cast<std::basic_string<CharT>*>(arg.val)->assign(s.data(), s.size());
+        } break;
+        case detail::scan_arg_type::string_view: {
+            if (!Input::is_contiguous) { return scan_errc::invalid_value; }
+            *static_cast<std::basic_string_view<CharT>*>(arg.val) =
+                read_field(in, width, [](CharT ch) { return !is_space(ch); }, buf);
+        } break;
+        default: return scan_errc::invalid_value;
+    }
+    return scan_errc::ok;
+}
+
+template<typename CharT, typename Input>
+scan_result vscan_impl(Input& in, std::basic_string_view<CharT> fmt, est::span<const detail::scan_arg> args) {
+    scan_result result{scan_errc::ok, 0, 0};
+    inline_basic_dynbuffer<CharT> buf;
+    std::size_t next_arg_id = 0;
+    bool manual_indexing = false;
+    for (std::size_t pos = 0; pos < fmt.size() && result.ec == scan_errc::ok;) {
+        const CharT ch = fmt[pos++];
+        if (ch == '{' && (pos == fmt.size() || fmt[pos] != '{')) {
+            std::size_t arg_id = unspecified_size, width = 0;
+            CharT type = 0;
+            pos = detail::parse_scan_field(fmt, pos, arg_id, width, type);
+            if (arg_id == unspecified_size) {
+                arg_id = manual_indexing ? unspecified_size : next_arg_id++;
+            } else if (!next_arg_id) {
+                manual_indexing = true;
+            } else {
+                arg_id = unspecified_size;
+            }
+            if (pos == std::basic_string_view<CharT>::npos || arg_id >= args.size() ||
+                !detail::is_valid_scan_type(args[arg_id].type, type)) {
+                result.ec = scan_errc::invalid_format;
+            } else if ((result.ec = scan_field(in, args[arg_id], width, type, buf)) == scan_errc::ok) {
+                ++result.count;
+            }
+            continue;
+        }
+        if (ch == '{' || ch == '}') {
+            if (pos == fmt.size() || fmt[pos++] != ch) {
+                result.ec = scan_errc::invalid_format;
+                continue;
+            }
+        } else if (is_space(ch)) {
+            skip_spaces(in);
+            continue;
+        }
+        if (in.curr() == in.last() && !in.fetch()) {
+            result.ec = scan_errc::eof;
+        } else if (*in.curr() != ch) {
+            result.ec = scan_errc::mismatch;
+        } else {
+            in.advance_to(in.curr() + 1);
+        }
+    }
+    result.n_read = in.n_read();
+    return result;
+}
+
+}  // namespace
+
+namespace uxs {
+
+template<typename CharT>
+scan_result vscan(std::basic_string_view<CharT> s, std::basic_string_view<CharT> fmt,
+                  est::span<const detail::scan_arg> args) {
+    string_scan_input<CharT> in(s);
+    return vscan_impl(in, fmt, args);
+}
+
+template<typename CharT>
+scan_result vscan(basic_ibuf<CharT>& in, std::basic_string_view<CharT> fmt, est::span<const detail::scan_arg> args) {
+    ibuf_scan_input<CharT> input(in);
+    return vscan_impl(input, fmt, args);
+}
+
+template UXS_EXPORT scan_result vscan(std::string_view, std::string_view, est::span<const detail::scan_arg>);
+template UXS_EXPORT scan_result vscan(std::wstring_view, std::wstring_view, est::span<const detail::scan_arg>);
+template UXS_EXPORT scan_result vscan(ibuf&, std::string_view, est::span<const detail::scan_arg>);
+template UXS_EXPORT scan_result vscan(wibuf&, std::wstring_view, est::span<const detail::scan_arg>);
+
+}  // namespace uxs
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "uxs/common.h"
+
+#if !defined(UXS_USE_X86_SIMD)
+#    if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#        define UXS_USE_X86_SIMD 1
+#    else
+#        define UXS_USE_X86_SIMD 0
+#    endif
+#endif  // !defined(UXS_USE_X86_SIMD)
+
+#if UXS_USE_X86_SIMD != 0
+#    if defined(_MSC_VER)
+#        include <intrin.h>
+#    endif
+#    include <immintrin.h>
+// kernels are compiled for the required instruction set and chosen at run-time
+#    if defined(__GNUC__)
+#        define UXS_SIMD_TARGET(isa) __attribute__((target(isa)))
+#    else
+#        define UXS_SIMD_TARGET(isa)
+#    endif
+#endif  // UXS_USE_X86_SIMD != 0
+
+namespace uxs {
+namespace simd {
+
+enum cpu_feature : unsigned { sse2 = 1, ssse3 = 2, sse41 = 4, avx2 = 8 };
+
+#if UXS_USE_X86_SIMD != 0
+inline unsigned detect_cpu_features() noexcept {
+    unsigned features = 0;
+#    if defined(_MSC_VER) && !defined(__clang__)
+    int regs[4];
+    __cpuid(regs, 0);
+    const int n_ids = regs[0];
+    __cpuid(regs, 1);
+    if (regs[3] & (1 << 26)) { features |= cpu_feature::sse2; }
+    if (regs[2] & (1 << 9)) { features |= cpu_feature::ssse3; }
+    if (regs[2] & (1 << 19)) { features |= cpu_feature::sse41; }
+    if (n_ids >= 7 && (regs[2] & (1 << 27))) {  // OS saves YMM registers
+        __cpuidex(regs, 7, 0);
+        if ((regs[1] & (1 << 5)) && (_xgetbv(0) & 6) == 6) { features |= cpu_feature::avx2; }
+    }
+#    else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) { features |= cpu_feature::sse2; }
+    if (__builtin_cpu_supports("ssse3")) { features |= cpu_feature::ssse3; }
+    if (__builtin_cpu_supports("sse4.1")) { features |= cpu_feature::sse41; }
+    if (__builtin_cpu_supports("avx2")) { features |= cpu_feature::avx2; }
+#    endif
+    return features;
+}
+#else   // UXS_USE_X86_SIMD != 0
+inline unsigned detect_cpu_features() noexcept { return 0; }
+#endif  // UXS_USE_X86_SIMD != 0
+
+inline bool has_cpu_feature(cpu_feature f) noexcept {
+    static const unsigned features = detect_cpu_features();
+    return (features & f) != 0;
+}
+
+#if UXS_USE_X86_SIMD != 0
+// Index of the lowest set bit of nonzero mask returned by `movemask`
+inline unsigned lowest_bit_index(std::uint32_t mask) noexcept {
+#    if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+#    else
+    return __builtin_ctz(mask);
+#    endif
+}
+#endif  // UXS_USE_X86_SIMD != 0
+
+}  // namespace simd
+}  // namespace uxs
@@ -1,11 +1,14 @@
 #include "uxs/string_alg.h"
 
+#include "simd.h"
+
+#include <cstring>
+
 namespace uxs {
 
 std::wstring from_utf8_to_wide(std::string_view s) {
-    std::wstring result;
-    result.reserve(s.size());
-    utf_string_adapter<wchar_t>{}.append(result, s);
+    std::wstring result(max_wchars_from_utf8(s.size()), '\0');
+    result.resize(from_utf8_to_wchars(s.data(), s.data() + s.size(), &result[0]) - result.data());
     return result;
 }
 
@@ -18,6 +21,188 @@ std::string from_wide_to_utf8(std::wstring_view s) {
 
 // --------------------------
 
+namespace {
+
+using find_char_fn = const char* (*)(const char*, const char*, char);
+using find_char_of_fn = const char* (*)(const char*, const char*, std::string_view);
+using find_substring_fn = const char* (*)(const char*, const char*, std::string_view);
+
+const char* find_char_generic(const char* first, const char* last, char ch) {
+    for (; first != last; ++first) {
+        if (*first == '\\') {
+            if (++first == last) { break; }
+        } else if (*first == ch) {
+            return first;
+        }
+    }
+    return last;
+}
+
+const char* find_char_of_generic(const char* first, const char* last, std::string_view chars) {
+    std::uint64_t tbl[4] = {0, 0, 0, 0};
+    for (const char ch : chars) {
+        const std::uint8_t code = static_cast<std::uint8_t>(ch);
+        tbl[code >> 6] |= std::uint64_t(1) << (code & 63);
+    }
+    for (; first != last; ++first) {
+        const std::uint8_t code = static_cast<std::uint8_t>(*first);
+        if (code == '\\') {
+            if (++first == last) { break; }
+        } else if (tbl[code >> 6] & (std::uint64_t(1) << (code & 63))) {
+            return first;
+        }
+    }
+    return last;
+}
+
+const char* find_substring_generic(const char* first, const char* last, std::string_view s) {
+    const std::size_t pos = std::string_view(first, last - first).find(s);
+    return pos != std::string_view::npos ? first + pos : last;
+}
+
+#if UXS_USE_X86_SIMD != 0
+// Escape characters are found together with target characters, so the text between them is skipped by blocks
+UXS_SIMD_TARGET("sse2")
+const char* find_char_sse2(const char* first, const char* last, char ch) {
+    const __m128i v_ch = _mm_set1_epi8(ch), v_esc = _mm_set1_epi8('\\');
+    while (last - first >= 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        const std::uint32_t mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, v_ch), _mm_cmpeq_epi8(v, v_esc)));
+        if (!mask) {
+            first += 16;
+            continue;
+        }
+        first += simd::lowest_bit_index(mask);
+        if (*first != '\\') { return first; }
+        if (last - first <= 2) { return last; }
+        first += 2;
+    }
+    return find_char_generic(first, last, ch);
+}
+
+UXS_SIMD_TARGET("avx2")
+const char* find_char_avx2(const char* first, const char* last, char ch) {
+    const __m256i v_ch = _mm256_set1_epi8(ch), v_esc = _mm256_set1_epi8('\\');
+    while (last - first >= 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        const std::uint32_t mask = _mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, v_ch), _mm256_cmpeq_epi8(v, v_esc)));
+        if (!mask) {
+            first += 32;
+            continue;
+        }
+        first += simd::lowest_bit_index(mask);
+        if (*first != '\\') { return first; }
+        if (last - first <= 2) { return last; }
+        first += 2;
+    }
+    return find_char_sse2(first, last, ch);
+}
+
+UXS_SIMD_TARGET("sse2")
+const char* find_char_of_sse2(const char* first, const char* last, std::string_view chars) {
+    enum : unsigned { max_char_count = 8 };
+    if (chars.size() > max_char_count) { return find_char_of_generic(first, last, chars); }
+    __m128i v_chars[max_char_count];
+    for (unsigned i = 0; i < chars.size(); ++i) { v_chars[i] = _mm_set1_epi8(chars[i]); }
+    const __m128i v_esc = _mm_set1_epi8('\\');
+    while (last - first >= 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        __m128i eq = _mm_cmpeq_epi8(v, v_esc);
+        for (unsigned i = 0; i < chars.size(); ++i) { eq = _mm_or_si128(eq, _mm_cmpeq_epi8(v, v_chars[i])); }
+        const std::uint32_t mask = _mm_movemask_epi8(eq);
+        if (!mask) {
+            first += 16;
+            continue;
+        }
+        first += simd::lowest_bit_index(mask);
+        if (*first != '\\') { return first; }
+        if (last - first <= 2) { return last; }
+        first += 2;
+    }
+    return find_char_of_generic(first, last, chars);
+}
+
+// Candidate positions are filtered by the first and the last characters of the substring,
+// and only candidates are compared completely
+UXS_SIMD_TARGET("sse2")
+const char* find_substring_sse2(const char* first, const char* last, std::string_view s) {
+    if (s.size() < 2) { return find_substring_generic(first, last, s); }
+    const std::size_t n = s.size() - 1;
+    const __m128i v_first = _mm_set1_epi8(s[0]), v_last = _mm_set1_epi8(s[n]);
+    for (; static_cast<std::size_t>(last - first) >= 16 + n; first += 16) {
+        const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + n));
+        std::uint32_t mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(v0, v_first), _mm_cmpeq_epi8(v1, v_last)));
+        for (; mask; mask &= mask - 1) {
+            const char* p = first + simd::lowest_bit_index(mask);
+            if (std::memcmp(p + 1, s.data() + 1, n - 1) == 0) { return p; }
+        }
+    }
+    return find_substring_generic(first, last, s);
+}
+
+UXS_SIMD_TARGET("avx2")
+const char* find_substring_avx2(const char* first, const char* last, std::string_view s) {
+    if (s.size() < 2) { return find_substring_generic(first, last, s); }
+    const std::size_t n = s.size() - 1;
+    const __m256i v_first = _mm256_set1_epi8(s[0]), v_last = _mm256_set1_epi8(s[n]);
+    for (; static_cast<std::size_t>(last - first) >= 32 + n; first += 32) {
+        const __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        const __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + n));
+        std::uint32_t mask = _mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(v0, v_first), _mm256_cmpeq_epi8(v1, v_last)));
+        for (; mask; mask &= mask - 1) {
+            const char* p = first + simd::lowest_bit_index(mask);
+            if (std::memcmp(p + 1, s.data() + 1, n - 1) == 0) { return p; }
+        }
+    }
+    return find_substring_sse2(first, last, s);
+}
+#endif  // UXS_USE_X86_SIMD != 0
+
+find_char_fn select_find_char() {
+#if UXS_USE_X86_SIMD != 0
+    if (simd::has_cpu_feature(simd::cpu_feature::avx2)) { return find_char_avx2; }
+    if (simd::has_cpu_feature(simd::cpu_feature::sse2)) { return find_char_sse2; }
+#endif  // UXS_USE_X86_SIMD != 0
+    return find_char_generic;
+}
+
+find_char_of_fn select_find_char_of() {
+#if UXS_USE_X86_SIMD != 0
+    if (simd::has_cpu_feature(simd::cpu_feature::sse2)) { return find_char_of_sse2; }
+#endif  // UXS_USE_X86_SIMD != 0
+    return find_char_of_generic;
+}
+
+find_substring_fn select_find_substring() {
+#if UXS_USE_X86_SIMD != 0
+    if (simd::has_cpu_feature(simd::cpu_feature::avx2)) { return find_substring_avx2; }
+    if (simd::has_cpu_feature(simd::cpu_feature::sse2)) { return find_substring_sse2; }
+#endif  // UXS_USE_X86_SIMD != 0
+    return find_substring_generic;
+}
+
+}  // namespace
+
+const char* detail::find_char_unescaped(const char* first, const char* last, char ch) noexcept {
+    static const find_char_fn fn = select_find_char();
+    return fn(first, last, ch);
+}
+
+const char* detail::find_char_of_unescaped(const char* first, const char* last, std::string_view chars) noexcept {
+    static const find_char_of_fn fn = select_find_char_of();
+    return fn(first, last, chars);
+}
+
+const char* detail::find_substring(const char* first, const char* last, std::string_view s) noexcept {
+    static const find_substring_fn fn = select_find_substring();
+    return fn(first, last, s);
+}
+
+// --------------------------
+
 template<typename CharT>
 std::basic_string_view<CharT> basic_trim_string(std::basic_string_view<CharT> s) {
     auto p1 = s.begin();
@@ -110,53 +295,232 @@ std::wstring decode_escapes(std::wstring_view s, std::wstring_view symb, std::ws
 
 // --------------------------
 
-template<typename CharT>
-int basic_compare_strings_nocase(std::basic_string_view<CharT> lhs, std::basic_string_view<CharT> rhs) {
+namespace {
+
+using mismatch_nocase_fn = std::size_t (*)(const char*, const char*, std::size_t);
+using change_case_fn = void (*)(char*, std::size_t);
+
+std::size_t mismatch_nocase_generic(const char* lhs, const char* rhs, std::size_t count) {
+    std::size_t pos = 0;
+    while (pos != count && to_lower(lhs[pos]) == to_lower(rhs[pos])) { ++pos; }
+    return pos;
+}
+
+void to_lower_generic(char* p, std::size_t count) {
+    for (char* p_end = p + count; p != p_end; ++p) { *p = to_lower(*p); }
+}
+
+void to_upper_generic(char* p, std::size_t count) {
+    for (char* p_end = p + count; p != p_end; ++p) { *p = to_upper(*p); }
+}
+
+#if UXS_USE_X86_SIMD != 0
+// Letters are in `(lo, hi)` range; bytes above 0x7f are negative and never fall into the range
+UXS_SIMD_TARGET("sse2")
+inline __m128i change_case_sse2(__m128i v, __m128i v_lo, __m128i v_hi) {
+    const __m128i in_range = _mm_and_si128(_mm_cmpgt_epi8(v, v_lo), _mm_cmpgt_epi8(v_hi, v));
+    return _mm_xor_si128(v, _mm_and_si128(in_range, _mm_set1_epi8('a' - 'A')));
+}
+
+UXS_SIMD_TARGET("avx2")
+inline __m256i change_case_avx2(__m256i v, __m256i v_lo, __m256i v_hi) {
+    const __m256i in_range = _mm256_and_si256(_mm256_cmpgt_epi8(v, v_lo), _mm256_cmpgt_epi8(v_hi, v));
+    return _mm256_xor_si256(v, _mm256_and_si256(in_range, _mm256_set1_epi8('a' - 'A')));
+}
+
+UXS_SIMD_TARGET("sse2")
+std::size_t mismatch_nocase_sse2(const char* lhs, const char* rhs, std::size_t count) {
+    const __m128i v_lo = _mm_set1_epi8('A' - 1), v_hi = _mm_set1_epi8('Z' + 1);
+    std::size_t pos = 0;
+    for (; count - pos >= 16; pos += 16) {
+        const __m128i v1 = change_case_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + pos)), v_lo, v_hi);
+        const __m128i v2 = change_case_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + pos)), v_lo, v_hi);
+        const std::uint32_t mask = ~_mm_movemask_epi8(_mm_cmpeq_epi8(v1, v2)) & 0xffff;
+        if (mask) { return pos + simd::lowest_bit_index(mask); }
+    }
+    return pos + mismatch_nocase_generic(lhs + pos, rhs + pos, count - pos);
+}
+
+UXS_SIMD_TARGET("avx2")
+std::size_t mismatch_nocase_avx2(const char* lhs, const char* rhs, std::size_t count) {
+    const __m256i v_lo = _mm256_set1_epi8('A' - 1), v_hi = _mm256_set1_epi8('Z' + 1);
+    std::size_t pos = 0;
+    for (; count - pos >= 32; pos += 32) {
+        const __m256i v1 = change_case_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + pos)), v_lo,
+                                            v_hi);
+        const __m256i v2 = change_case_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + pos)), v_lo,
+                                            v_hi);
+        const std::uint32_t mask = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v1, v2)));
+        if (mask) { return pos + simd::lowest_bit_index(mask); }
+    }
+    return pos + mismatch_nocase_sse2(lhs + pos, rhs + pos, count - pos);
+}
+
+UXS_SIMD_TARGET("sse2")
+void change_case_sse2(char* p, std::size_t count, char lo, char hi) {
+    const __m128i v_lo = _mm_set1_epi8(lo - 1), v_hi = _mm_set1_epi8(hi + 1);
+    for (; count >= 16; p += 16, count -= 16) {
+        __m128i* pv = reinterpret_cast<__m128i*>(p);
+        _mm_storeu_si128(pv, change_case_sse2(_mm_loadu_si128(pv), v_lo, v_hi));
+    }
+    for (char* p_end = p + count; p != p_end; ++p) {
+        if (*p >= lo && *p <= hi) { *p ^= 'a' - 'A'; }
+    }
+}
+
+UXS_SIMD_TARGET("avx2")
+void change_case_avx2(char* p, std::size_t count, char lo, char hi) {
+    const __m256i v_lo = _mm256_set1_epi8(lo - 1), v_hi = _mm256_set1_epi8(hi + 1);
+    for (; count >= 32; p += 32, count -= 32) {
+        __m256i* pv = reinterpret_cast<__m256i*>(p);
+        _mm256_storeu_si256(pv, change_case_avx2(_mm256_loadu_si256(pv), v_lo, v_hi));
+    }
+    change_case_sse2(p, count, lo, hi);
+}
+
+UXS_SIMD_TARGET("sse2")
+void to_lower_sse2(char* p, std::size_t count) { change_case_sse2(p, count, 'A', 'Z'); }
+UXS_SIMD_TARGET("sse2")
+void to_upper_sse2(char* p, std::size_t count) { change_case_sse2(p, count, 'a', 'z'); }
+UXS_SIMD_TARGET("avx2")
+void to_lower_avx2(char* p, std::size_t count) { change_case_avx2(p, count, 'A', 'Z'); }
+UXS_SIMD_TARGET("avx2")
+void to_upper_avx2(char* p, std::size_t count) { change_case_avx2(p, count, 'a', 'z'); }
+#endif  // UXS_USE_X86_SIMD != 0
+
+mismatch_nocase_fn select_mismatch_nocase() {
+#if UXS_USE_X86_SIMD != 0
+    if (simd::has_cpu_feature(simd::cpu_feature::avx2)) { return mismatch_nocase_avx2; }
+    if (simd::has_cpu_feature(simd::cpu_feature::sse2)) { return mismatch_nocase_sse2; }
+#endif  // UXS_USE_X86_SIMD != 0
+    return mismatch_nocase_generic;
+}
+
+change_case_fn select_to_lower() {
+#if UXS_USE_X86_SIMD != 0
+    if (simd::has_cpu_feature(simd::cpu_feature::avx2)) { return to_lower_avx2; }
+    if (simd::has_cpu_feature(simd::cpu_feature::sse2)) { return to_lower_sse2; }
+#endif  // UXS_USE_X86_SIMD != 0
+    return to_lower_generic;
+}
+
+change_case_fn select_to_upper() {
+#if UXS_USE_X86_SIMD != 0
+    if (simd::has_cpu_feature(simd::cpu_feature::avx2)) { return to_upper_avx2; }
+    if (simd::has_cpu_feature(simd::cpu_feature::sse2)) { return to_upper_sse2; }
+#endif  // UXS_USE_X86_SIMD != 0
+    return to_upper_generic;
+}
+
+// Converts upper case ASCII letters of 8 packed characters to lower case
+std::uint64_t to_lower_swar(std::uint64_t w) noexcept {
+    const std::uint64_t ones = 0x0101010101010101ull;
+    const std::uint64_t heptets = w & (0x7f * ones);
+    const std::uint64_t is_gt_z = heptets + (0x7f - 'Z') * ones;
+    const std::uint64_t is_ge_a = heptets + (0x80 - 'A') * ones;
+    return w | (((is_ge_a ^ is_gt_z) & ~w & (0x80 * ones)) >> 2);
+}
+
+std::uint64_t mix_hash(std::uint64_t h, std::uint64_t v) noexcept {
+    h = (h ^ v) * 0x9e3779b97f4a7c15ull;
+    return h ^ (h >> 29);
+}
+
+}  // namespace
+
+int compare_strings_nocase(std::string_view lhs, std::string_view rhs) {
+    static const mismatch_nocase_fn fn = select_mismatch_nocase();
+    const std::size_t count = std::min(lhs.size(), rhs.size());
+    const std::size_t pos = fn(lhs.data(), rhs.data(), count);
+    if (pos != count) {
+        return static_cast<std::uint8_t>(to_lower(lhs[pos])) < static_cast<std::uint8_t>(to_lower(rhs[pos])) ? -1 : 1;
+    }
+    if (lhs.size() < rhs.size()) { return -1; }
+    if (rhs.size() < lhs.size()) { return 1; }
+    return 0;
+}
+
+int compare_strings_nocase(std::wstring_view lhs, std::wstring_view rhs) {
     auto p1_end = lhs.begin() + std::min(lhs.size(), rhs.size());
     for (auto p1 = lhs.begin(), p2 = rhs.begin(); p1 != p1_end; ++p1, ++p2) {
-        CharT ch1 = to_lower(*p1);
-        CharT ch2 = to_lower(*p2);
-        if (std::basic_string_view<CharT>::traits_type::lt(ch1, ch2)) { return -1; }
-        if (std::basic_string_view<CharT>::traits_type::lt(ch2, ch1)) { return 1; }
+        wchar_t ch1 = to_lower(*p1);
+        wchar_t ch2 = to_lower(*p2);
+        if (std::wstring_view::traits_type::lt(ch1, ch2)) { return -1; }
+        if (std::wstring_view::traits_type::lt(ch2, ch1)) { return 1; }
     }
     if (lhs.size() < rhs.size()) { return -1; }
     if (rhs.size() < lhs.size()) { return 1; }
     return 0;
 }
 
-int compare_strings_nocase(std::string_view lhs, std::string_view rhs) {
-    return basic_compare_strings_nocase(lhs, rhs);
+// --------------------------
+
+// Characters are folded and hashed by 8 at once
+std::size_t hash_string_nocase(std::string_view s) noexcept {
+    std::uint64_t h = mix_hash(0, s.size());
+    const char* p = s.data();
+    std::size_t count = s.size();
+    for (std::uint64_t w = 0; count >= sizeof(w); p += sizeof(w), count -= sizeof(w)) {
+        std::memcpy(&w, p, sizeof(w));
+        h = mix_hash(h, to_lower_swar(w));
+    }
+    if (count) {
+        std::uint64_t w = 0;
+        std::memcpy(&w, p, count);
+        h = mix_hash(h, to_lower_swar(w));
+    }
+    return static_cast<std::size_t>(h);
 }
 
-int compare_strings_nocase(std::wstring_view lhs, std::wstring_view rhs) {
-    return basic_compare_strings_nocase(lhs, rhs);
+std::size_t hash_string_nocase(std::wstring_view s) noexcept {
+    std::uint64_t h = mix_hash(0, s.size());
+    for (const wchar_t ch : s) { h = mix_hash(h, static_cast<std::uint64_t>(to_lower(ch))); }
+    return static_cast<std::size_t>(h);
 }
 
 // --------------------------
 
+void to_lower_inplace(est::span<char> s) noexcept {
+    static const change_case_fn fn = select_to_lower();
+    fn(s.data(), s.size());
+}
+
+void to_lower_inplace(est::span<wchar_t> s) noexcept {
+    for (wchar_t& ch : s) { ch = to_lower(ch); }
+}
+
 std::string to_lower(std::string_view s) {
     std::string lower(s);
-    std::transform(lower.begin(), lower.end(), lower.begin(), [](int c) { return to_lower(c); });
+    to_lower_inplace(est::as_span(&lower[0], lower.size()));
     return lower;
 }
 
 std::wstring to_lower(std::wstring_view s) {
     std::wstring lower(s);
-    std::transform(lower.begin(), lower.end(), lower.begin(), [](int c) { return to_lower(c); });
+    to_lower_inplace(est::as_span(&lower[0], lower.size()));
     return lower;
 }
 
 // --------------------------
 
+void to_upper_inplace(est::span<char> s) noexcept {
+    static const change_case_fn fn = select_to_upper();
+    fn(s.data(), s.size());
+}
+
+void to_upper_inplace(est::span<wchar_t> s) noexcept {
+    for (wchar_t& ch : s) { ch = to_upper(ch); }
+}
+
 std::string to_upper(std::string_view s) {
     std::string upper(s);
-    std::transform(upper.begin(), upper.end(), upper.begin(), [](int c) { return to_upper(c); });
+    to_upper_inplace(est::as_span(&upper[0], upper.size()));
     return upper;
 }
 
 std::wstring to_upper(std::wstring_view s) {
     std::wstring upper(s);
-    std::transform(upper.begin(), upper.end(), upper.begin(), [](int c) { return to_upper(c); });
+    to_upper_inplace(est::as_span(&upper[0], upper.size()));
     return upper;
 }
 
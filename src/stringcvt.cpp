@@ -1,3 +1,4 @@
+#include "uxs/huge_page_allocator.h"
 #include "uxs/impl/stringcvt_impl.h"
 
 namespace uxs {
@@ -6,6 +7,24 @@ format_error::format_error(const char* message) : std::runtime_error(message) {}
 format_error::format_error(const std::string& message) : std::runtime_error(message) {}
 const char* format_error::what() const noexcept { return std::runtime_error::what(); }
 
+namespace detail {
+
+static_assert(static_cast<std::size_t>(dynbuffer_page_size) == huge_page_size, "dynamic buffer page size mismatch");
+
+void* alloc_dynbuffer_pages(std::size_t& sz) {
+    sz = (sz + huge_page_size - 1) & ~static_cast<std::size_t>(huge_page_size - 1);
+    return alloc_pages(sz);
+}
+
+void* realloc_dynbuffer_pages(void* p, std::size_t old_sz, std::size_t& new_sz) {
+    new_sz = (new_sz + huge_page_size - 1) & ~static_cast<std::size_t>(huge_page_size - 1);
+    return realloc_pages(p, old_sz, new_sz);
+}
+
+void free_dynbuffer_pages(void* p, std::size_t sz) noexcept { free_pages(p, sz); }
+
+}  // namespace detail
+
 namespace scvt {
 
 inline std::uint64_t umul128(std::uint64_t x, std::uint64_t y, std::uint64_t bias, std::uint64_t& result_hi) {
@@ -0,0 +1,196 @@
+#include "uxs/thread_pool.h"
+
+#include "uxs/memory.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace uxs;
+
+namespace {
+
+struct job_t {
+    void (*fn)(void*, std::size_t, std::size_t);
+    void* ctx;
+    std::size_t grain;
+    std::atomic<std::size_t> pending;  // the number of not yet processed indices
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+};
+
+struct task_t {
+    job_t* job;
+    std::size_t first;
+    std::size_t last;
+};
+
+struct alignas(64) task_queue_t {
+    std::mutex mutex;
+    std::deque<task_t> tasks;
+};
+
+}  // namespace
+
+struct thread_pool::impl {
+    // the last queue is shared by threads not belonging to the pool
+    std::vector<std::unique_ptr<task_queue_t>> queues;
+    std::vector<std::thread> threads;
+    std::atomic<std::size_t> queued_count{0};
+    std::mutex wait_mutex;
+    std::condition_variable wait_cv;
+    bool stop = false;
+
+    explicit impl(unsigned thread_count);
+    ~impl();
+    void worker_loop(std::size_t queue_index);
+    void push(std::size_t queue_index, const task_t& task);
+    bool pop(std::size_t queue_index, task_t& task);
+    bool steal(std::size_t queue_index, task_t& task);
+    void execute(std::size_t queue_index, task_t task);
+};
+
+namespace {
+struct worker_info_t {
+    const void* pool;
+    std::size_t queue_index;
+};
+thread_local worker_info_t g_worker_info{nullptr, 0};
+}  // namespace
+
+thread_pool::impl::impl(unsigned thread_count) {
+    queues.resize(thread_count);
+    for (auto& q : queues) { q = est::make_unique<task_queue_t>(); }
+    threads.reserve(thread_count - 1);
+    for (std::size_t n = 0; n < thread_count - 1; ++n) { threads.emplace_back([this, n] { worker_loop(n); }); }
+}
+
+thread_pool::impl::~impl() {
+    {
+        std::lock_guard<std::mutex> lock(wait_mutex);
+        stop = true;
+    }
+    wait_cv.notify_all();
+    for (auto& t : threads) { t.join(); }
+}
+
+void thread_pool::impl::worker_loop(std::size_t queue_index) {
+    g_worker_info = worker_info_t{this, queue_index};
+    while (true) {
+        task_t task;
+        if (pop(queue_index, task) || steal(queue_index, task)) {
+            execute(queue_index, task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(wait_mutex);
+        wait_cv.wait(lock, [this] { return stop || queued_count.load() != 0; });
+        if (stop) { return; }
+    }
+}
+
+void thread_pool::impl::push(std::size_t queue_index, const task_t& task) {
+    {
+        std::lock_guard<std::mutex> lock(queues[queue_index]->mutex);
+        queues[queue_index]->tasks.push_back(task);
+        queued_count.fetch_add(1);
+    }
+    { std::lock_guard<std::mutex> lock(wait_mutex); }
+    wait_cv.notify_one();
+}
+
+bool thread_pool::impl::pop(std::size_t queue_index, task_t& task) {
+    task_queue_t& q = *queues[queue_index];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.tasks.empty()) { return false; }
+    task = q.tasks.back();
+    q.tasks.pop_back();
+    queued_count.fetch_sub(1);
+    return true;
+}
+
+bool thread_pool::impl::steal(std::size_t queue_index, task_t& task) {
+    if (queued_count.load() == 0) { return false; }
+    for (std::size_t n = 1; n < queues.size(); ++n) {
+        task_queue_t& q = *queues[(queue_index + n) % queues.size()];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty()) { continue; }
+        task = q.tasks.front();
+        q.tasks.pop_front();
+        queued_count.fetch_sub(1);
+        return true;
+    }
+    return false;
+}
+
+// The task is halved until it becomes not longer than the grain, and the upper halves are left for other workers
+void thread_pool::impl::execute(std::size_t queue_index, task_t task) {
+    job_t& job = *task.job;
+    while (task.last - task.first > job.grain) {
+        const std::size_t mid = task.first + (task.last - task.first) / 2;
+        push(queue_index, task_t{&job, mid, task.last});
+        task.last = mid;
+    }
+    if (!job.failed.load()) {
+        try {
+            job.fn(job.ctx, task.first, task.last);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(job.error_mutex);
+            if (!job.failed.load()) { job.error = std::current_exception(), job.failed = true; }
+        }
+    }
+    const std::size_t count = task.last - task.first;
+    if (job.pending.fetch_sub(count) == count) {
+        // the job object can be destroyed just after the counter becomes zero
+        { std::lock_guard<std::mutex> lock(wait_mutex); }
+        wait_cv.notify_all();
+    }
+}
+
+// --------------------------
+
+thread_pool::thread_pool(unsigned thread_count) {
+    if (!thread_count) { thread_count = std::max(std::thread::hardware_concurrency(), 1u); }
+    impl_ = est::make_unique<impl>(thread_count);
+}
+
+thread_pool::~thread_pool() = default;
+
+unsigned thread_pool::concurrency() const noexcept { return static_cast<unsigned>(impl_->queues.size()); }
+
+thread_pool& thread_pool::instance() {
+    static thread_pool pool;
+    return pool;
+}
+
+void thread_pool::run(std::size_t count, std::size_t grain, void (*fn)(void*, std::size_t, std::size_t),
+                      void* ctx) {
+    if (!count) { return; }
+    if (!grain) { grain = 1; }
+    if (count <= grain || impl_->threads.empty()) {
+        fn(ctx, 0, count);
+        return;
+    }
+    job_t job;
+    job.fn = fn, job.ctx = ctx, job.grain = grain;
+    job.pending = count;
+    const std::size_t queue_index = g_worker_info.pool == impl_.get() ? g_worker_info.queue_index :
+                                                                         impl_->queues.size() - 1;
+    impl_->execute(queue_index, task_t{&job, 0, count});
+    // help other workers until the job is finished
+    while (job.pending.load() != 0) {
+        task_t task;
+        if (impl_->pop(queue_index, task) || impl_->steal(queue_index, task)) {
+            impl_->execute(queue_index, task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(impl_->wait_mutex);
+        impl_->wait_cv.wait(lock, [this, &job] { return job.pending.load() == 0 || impl_->queued_count.load() != 0; });
+    }
+    if (job.failed) { std::rethrow_exception(job.error); }
+}
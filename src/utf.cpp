@@ -1,6 +1,9 @@
 #include "uxs/utf.h"
 
+#include "simd.h"
+
 #include <algorithm>
+#include <cstring>
 
 namespace uxs {
 
@@ -145,4 +148,240 @@ unsigned get_utf_code_width(std::uint32_t code) noexcept {
     return lower == first || code > (*(lower - 1) & 0xffff) + (*(lower - 1) >> 16) ? 1 : 2;
 }
 
+//---------------------------------------------------------------------------------
+// Bulk transcoding
+
+namespace {
+// Block kernels convert leading ASCII characters and return their count; they are allowed to stop
+// before the end of ASCII run, the rest is processed code point by code point
+
+using ascii_utf8_to_wchars_fn = std::size_t (*)(const char*, const char*, wchar_t*);
+using ascii_wchars_to_utf8_fn = std::size_t (*)(const wchar_t*, const wchar_t*, char*);
+using skip_ascii_fn = std::size_t (*)(const char*, const char*);
+
+const std::uint64_t g_ascii_word_mask = 0x8080808080808080ull;
+
+std::size_t ascii_utf8_to_wchars_generic(const char* first, const char* last, wchar_t* out) {
+    const char* p = first;
+    for (std::uint64_t w = 0; last - p >= 8; p += 8, out += 8) {
+        std::memcpy(&w, p, sizeof(w));
+        if (w & g_ascii_word_mask) { break; }
+        for (unsigned i = 0; i < 8; ++i) { out[i] = static_cast<wchar_t>(p[i]); }
+    }
+    return p - first;
+}
+
+std::size_t ascii_wchars_to_utf8_generic(const wchar_t* first, const wchar_t* last, char* out) {
+    const wchar_t* p = first;
+    for (; p != last && static_cast<std::uint32_t>(*p) < 0x80; ++p) { *out++ = static_cast<char>(*p); }
+    return p - first;
+}
+
+std::size_t skip_ascii_generic(const char* first, const char* last) {
+    const char* p = first;
+    for (std::uint64_t w = 0; last - p >= 8; p += 8) {
+        std::memcpy(&w, p, sizeof(w));
+        if (w & g_ascii_word_mask) { break; }
+    }
+    return p - first;
+}
+
+#if UXS_USE_X86_SIMD != 0
+UXS_SIMD_TARGET("sse2")
+std::size_t ascii_utf8_to_wchars_sse2(const char* first, const char* last, wchar_t* out) {
+    const char* p = first;
+    const __m128i z = _mm_setzero_si128();
+    for (; last - p >= 16; p += 16, out += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        if (_mm_movemask_epi8(v)) { break; }
+        const __m128i lo = _mm_unpacklo_epi8(v, z), hi = _mm_unpackhi_epi8(v, z);
+#    if WCHAR_MAX > 0xffff
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi16(lo, z));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_unpackhi_epi16(lo, z));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpacklo_epi16(hi, z));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), _mm_unpackhi_epi16(hi, z));
+#    else   // WCHAR_MAX > 0xffff
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), hi);
+#    endif  // WCHAR_MAX > 0xffff
+    }
+    return p - first;
+}
+
+UXS_SIMD_TARGET("avx2")
+std::size_t ascii_utf8_to_wchars_avx2(const char* first, const char* last, wchar_t* out) {
+    const char* p = first;
+    for (; last - p >= 32; p += 32, out += 32) {
+        if (_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)))) { break; }
+#    if WCHAR_MAX > 0xffff
+        for (unsigned i = 0; i < 32; i += 8) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                                _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p + i))));
+        }
+#    else   // WCHAR_MAX > 0xffff
+        for (unsigned i = 0; i < 32; i += 16) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                                _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i))));
+        }
+#    endif  // WCHAR_MAX > 0xffff
+    }
+    return p - first;
+}
+
+UXS_SIMD_TARGET("sse2")
+std::size_t ascii_wchars_to_utf8_sse2(const wchar_t* first, const wchar_t* last, char* out) {
+    const wchar_t* p = first;
+    const __m128i z = _mm_setzero_si128();
+    for (; last - p >= 16; p += 16, out += 16) {
+        const __m128i* v = reinterpret_cast<const __m128i*>(p);
+#    if WCHAR_MAX > 0xffff
+        const __m128i a = _mm_loadu_si128(v), b = _mm_loadu_si128(v + 1);
+        const __m128i c = _mm_loadu_si128(v + 2), d = _mm_loadu_si128(v + 3);
+        const __m128i non_ascii = _mm_and_si128(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)),
+                                                _mm_set1_epi32(~0x7f));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(non_ascii, z)) != 0xffff) { break; }
+        const __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+#    else   // WCHAR_MAX > 0xffff
+        const __m128i a = _mm_loadu_si128(v), b = _mm_loadu_si128(v + 1);
+        const __m128i non_ascii = _mm_and_si128(_mm_or_si128(a, b), _mm_set1_epi16(~0x7f));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(non_ascii, z)) != 0xffff) { break; }
+        const __m128i bytes = _mm_packus_epi16(a, b);
+#    endif  // WCHAR_MAX > 0xffff
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), bytes);
+    }
+    return p - first;
+}
+
+UXS_SIMD_TARGET("sse2")
+std::size_t skip_ascii_sse2(const char* first, const char* last) {
+    const char* p = first;
+    for (; last - p >= 16; p += 16) {
+        if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)))) { break; }
+    }
+    return p - first;
+}
+
+UXS_SIMD_TARGET("avx2")
+std::size_t skip_ascii_avx2(const char* first, const char* last) {
+    const char* p = first;
+    for (; last - p >= 64; p += 64) {
+        const __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+        if (_mm256_movemask_epi8(_mm256_or_si256(v0, v1))) { break; }
+    }
+    for (; last - p >= 32; p += 32) {
+        if (_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)))) { break; }
+    }
+    return p - first;
+}
+#endif  // UXS_USE_X86_SIMD != 0
+
+ascii_utf8_to_wchars_fn select_ascii_utf8_to_wchars() {
+#if UXS_USE_X86_SIMD != 0
+    if (simd::has_cpu_feature(simd::cpu_feature::avx2)) { return ascii_utf8_to_wchars_avx2; }
+    if (simd::has_cpu_feature(simd::cpu_feature::sse2)) { return ascii_utf8_to_wchars_sse2; }
+#endif  // UXS_USE_X86_SIMD != 0
+    return ascii_utf8_to_wchars_generic;
+}
+
+ascii_wchars_to_utf8_fn select_ascii_wchars_to_utf8() {
+#if UXS_USE_X86_SIMD != 0
+    if (simd::has_cpu_feature(simd::cpu_feature::sse2)) { return ascii_wchars_to_utf8_sse2; }
+#endif  // UXS_USE_X86_SIMD != 0
+    return ascii_wchars_to_utf8_generic;
+}
+
+skip_ascii_fn select_skip_ascii() {
+#if UXS_USE_X86_SIMD != 0
+    if (simd::has_cpu_feature(simd::cpu_feature::avx2)) { return skip_ascii_avx2; }
+    if (simd::has_cpu_feature(simd::cpu_feature::sse2)) { return skip_ascii_sse2; }
+#endif  // UXS_USE_X86_SIMD != 0
+    return skip_ascii_generic;
+}
+}  // namespace
+
+wchar_t* from_utf8_to_wchars(const char* first, const char* last, wchar_t* out) noexcept {
+    static const ascii_utf8_to_wchars_fn ascii_block = select_ascii_utf8_to_wchars();
+    std::uint32_t code = 0;
+    while (first != last) {
+        if (static_cast<std::uint8_t>(*first) < 0x80) {
+            const std::size_t n = ascii_block(first, last, out);
+            first += n, out += n;
+            for (; first != last && static_cast<std::uint8_t>(*first) < 0x80; ++first) {
+                *out++ = static_cast<wchar_t>(*first);
+            }
+            if (first == last) { break; }
+        }
+        do {
+            // fast path for complete sequences, which are not too close to the end
+            const std::uint32_t b0 = static_cast<std::uint8_t>(*first);
+            if (b0 >= 0xc0 && b0 < 0xf8 && last - first >= 4 && (first[1] & 0xc0) == 0x80) {
+                if (b0 < 0xe0) {
+                    *out++ = static_cast<wchar_t>(((b0 & 0x1f) << 6) | (first[1] & 0x3f));
+                    first += 2;
+                    continue;
+                }
+                if ((first[2] & 0xc0) == 0x80) {
+                    if (b0 < 0xf0) {
+                        code = ((b0 & 0xf) << 12) | ((first[1] & 0x3f) << 6) | (first[2] & 0x3f);
+                        if ((code & 0xf800) != 0xd800) {
+                            *out++ = static_cast<wchar_t>(code);
+                            first += 3;
+                            continue;
+                        }
+                    } else if ((first[3] & 0xc0) == 0x80) {
+                        code = ((b0 & 0x7) << 18) | ((first[1] & 0x3f) << 12) | ((first[2] & 0x3f) << 6) |
+                               (first[3] & 0x3f);
+                        if (code < 0x110000 && (code & 0x1ff800) != 0xd800) {
+                            out += to_wchar(code, out);
+                            first += 4;
+                            continue;
+                        }
+                    }
+                }
+            }
+            from_utf8(first, last, first, code);
+            out += to_wchar(code, out);
+        } while (first != last && static_cast<std::uint8_t>(*first) >= 0x80);
+    }
+    return out;
+}
+
+char* from_wchars_to_utf8(const wchar_t* first, const wchar_t* last, char* out) noexcept {
+    static const ascii_wchars_to_utf8_fn ascii_block = select_ascii_wchars_to_utf8();
+    std::uint32_t code = 0;
+    while (first != last) {
+        if (static_cast<std::uint32_t>(*first) < 0x80) {
+            const std::size_t n = ascii_block(first, last, out);
+            first += n, out += n;
+            for (; first != last && static_cast<std::uint32_t>(*first) < 0x80; ++first) {
+                *out++ = static_cast<char>(*first);
+            }
+            if (first == last) { break; }
+        }
+        from_wchar(first, last, first, code);
+        out += to_utf8(code, out);
+    }
+    return out;
+}
+
+const char* find_invalid_utf8(const char* first, const char* last) noexcept {
+    static const skip_ascii_fn skip_ascii = select_skip_ascii();
+    // the least code points, which can be encoded with 2, 3 and 4 bytes: longer encodings are overlong
+    static const std::uint32_t min_code[] = {0x80, 0x800, 0x10000};
+    std::uint32_t code = 0;
+    while (first != last) {
+        if (static_cast<std::uint8_t>(*first) < 0x80) {
+            first += skip_ascii(first, last);
+            while (first != last && static_cast<std::uint8_t>(*first) < 0x80) { ++first; }
+            if (first == last) { break; }
+        }
+        const char* next = first;
+        const unsigned n = from_utf8(first, last, next, code);
+        if (n < 2 || code < min_code[n - 2]) { return first; }
+        first = next;
+    }
+    return last;
+}
+
 }  // namespace uxs
@@ -171,9 +171,185 @@ u8iobuf& operator<<(u8iobuf& os, const variant& v) {
 }
 }  // namespace uxs
 
+//---------------------------------------------------------------------------------
+// Compact serialization
+
+namespace {
+enum : unsigned { max_varint_size = 10, string_chunk_size = 0x10000 };
+
+std::uint64_t zigzag_encode(std::int64_t v) { return (static_cast<std::uint64_t>(v) << 1) ^ (v < 0 ? ~0ull : 0ull); }
+std::int64_t zigzag_decode(std::uint64_t v) { return static_cast<std::int64_t>((v >> 1) ^ (0ull - (v & 1))); }
+
+std::uint8_t* encode_varint(std::uint8_t* p, std::uint64_t v) {
+    for (; v >= 0x80; v >>= 7) { *p++ = static_cast<std::uint8_t>(v | 0x80); }
+    *p++ = static_cast<std::uint8_t>(v);
+    return p;
+}
+
+void write_varint(u8iobuf& os, std::uint64_t v) {
+    if (os.avail() >= max_varint_size) {
+        os.advance(encode_varint(os.first_avail(), v) - os.first_avail());
+        return;
+    }
+    std::uint8_t buf[max_varint_size];
+    os.write(est::as_span(buf, encode_varint(buf, v) - buf));
+}
+
+bool read_varint(u8ibuf& is, std::uint64_t& v) {
+    const std::uint8_t* p = is.first_avail();
+    if (is.avail() >= max_varint_size) {  // fast path: the whole number is in the buffer
+        std::uint64_t result = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            const std::uint8_t b = *p++;
+            result |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+            if (!(b & 0x80)) {
+                is.advance(p - is.first_avail());
+                v = result;
+                return true;
+            }
+        }
+        is.setstate(iostate_bits::fail);
+        return false;
+    }
+    std::uint64_t result = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        const auto b = is.get();
+        if (b == u8ibuf::traits_type::eof()) { return false; }
+        result |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+        if (!(b & 0x80)) {
+            v = result;
+            return true;
+        }
+    }
+    is.setstate(iostate_bits::fail);
+    return false;
+}
+
+bool serialize_compact_value(u8iobuf& os, variant_id type, const void* p) {
+    switch (type) {
+        case variant_id::string: {
+            const auto& s = *static_cast<const std::string*>(p);
+            write_varint(os, s.size());
+            os.write(est::as_span(reinterpret_cast<const std::uint8_t*>(s.data()), s.size()));
+        } break;
+        case variant_id::integer: write_varint(os, zigzag_encode(*static_cast<const std::int32_t*>(p))); break;
+        case variant_id::long_integer: write_varint(os, zigzag_encode(*static_cast<const std::int64_t*>(p))); break;
+        case variant_id::unsigned_integer: write_varint(os, *static_cast<const std::uint32_t*>(p)); break;
+        case variant_id::unsigned_long_integer: write_varint(os, *static_cast<const std::uint64_t*>(p)); break;
+        default: return false;
+    }
+    return true;
+}
+
+bool deserialize_compact_value(u8ibuf& is, variant_id type, void* p) {
+    std::uint64_t v = 0;
+    switch (type) {
+        case variant_id::string: {
+            if (!read_varint(is, v)) { return true; }
+            auto& s = *static_cast<std::string*>(p);
+            if (v > s.max_size()) {
+                is.setstate(iostate_bits::fail);
+                return true;
+            }
+            // the length is not trusted: the string grows by bounded chunks as the data is actually read,
+            // so malformed length leads to the failure at the end of input instead of a huge allocation
+            const std::size_t len = static_cast<std::size_t>(v);
+            std::size_t n = 0;
+            s.resize(std::min(len, std::max<std::size_t>(is.avail(), string_chunk_size)));  // keeps capacity
+            while (true) {
+                n += is.read(est::as_span(reinterpret_cast<std::uint8_t*>(&s[n]), s.size() - n));
+                if (n < s.size()) {
+                    s.resize(n);
+                    break;
+                }
+                if (n == len) { break; }
+                s.resize(n + std::min(len - n, std::max<std::size_t>(n, string_chunk_size)));
+            }
+        } break;
+        case variant_id::integer: {
+            if (read_varint(is, v)) { *static_cast<std::int32_t*>(p) = static_cast<std::int32_t>(zigzag_decode(v)); }
+        } break;
+        case variant_id::long_integer: {
+            if (read_varint(is, v)) { *static_cast<std::int64_t*>(p) = zigzag_decode(v); }
+        } break;
+        case variant_id::unsigned_integer: {
+            if (read_varint(is, v)) { *static_cast<std::uint32_t*>(p) = static_cast<std::uint32_t>(v); }
+        } break;
+        case variant_id::unsigned_long_integer: {
+            if (read_varint(is, v)) { *static_cast<std::uint64_t*>(p) = v; }
+        } break;
+        default: return false;
+    }
+    return true;
+}
+}  // namespace
+
+namespace uxs {
+u8ibuf& deserialize_compact(u8ibuf& is, variant& v) {
+    std::uint64_t id = 0;
+    if (!read_varint(is, id)) { return is; }
+    if (id >= variant::max_type_id) {
+        is.setstate(iostate_bits::fail);
+        return is;
+    }
+    auto* tgt_vtable = variant::get_vtable(static_cast<variant_id>(id));
+    if (v.vtable_ != tgt_vtable) {
+        v.reset();
+        if (tgt_vtable) { tgt_vtable->construct_default(&v.data_); }
+        v.vtable_ = tgt_vtable;
+    }
+    if (v.vtable_ && !deserialize_compact_value(is, v.vtable_->type, &v.data_)) {
+        v.vtable_->deserialize(is, &v.data_);
+    }
+    return is;
+}
+
+u8iobuf& serialize_compact(u8iobuf& os, const variant& v) {
+    if (!v.vtable_) {
+        os.put(static_cast<std::uint8_t>(variant_id::invalid));
+        return os;
+    }
+    write_varint(os, static_cast<std::uint32_t>(v.vtable_->type));
+    if (!serialize_compact_value(os, v.vtable_->type, &v.data_)) { v.vtable_->serialize(os, &v.data_); }
+    return os;
+}
+
+u8ibuf& deserialize(u8ibuf& is, std::vector<variant>& vs) {
+    std::uint64_t count = 0;
+    if (!read_varint(is, count)) { return is; }
+    // the count is not trusted: elements are appended one by one as they are successfully read
+    std::size_t n = 0;
+    for (; n < count && n < vs.size(); ++n) {
+        if (!deserialize_compact(is, vs[n])) { break; }
+    }
+    for (; n < count && is; ++n) {
+        vs.emplace_back();
+        if (!deserialize_compact(is, vs.back())) { break; }
+    }
+    vs.resize(n);
+    return is;
+}
+
+u8iobuf& serialize(u8iobuf& os, est::span<const variant> vs) {
+    write_varint(os, vs.size());
+    for (const variant& v : vs) { serialize_compact(os, v); }
+    return os;
+}
+}  // namespace uxs
+
 //---------------------------------------------------------------------------------
 // Basic type convertors
 
+namespace {
+// Formats a number directly into target string: no temporary string is created, and storage of the
+// target (small string buffer or previously allocated memory) is reused
+template<typename Ty>
+void assign_chars(void* to, const Ty& v, fmt_opts fmt = {}) {
+    char buf[32];
+    static_cast<std::string*>(to)->assign(buf, to_chars(buf, v, fmt));
+}
+}  // namespace
+
 bool variant_type_impl<std::int32_t>::convert_from(variant_id type, void* to, const void* from) {
     auto& result = *static_cast<std::int32_t*>(to);
     switch (type) {
@@ -189,7 +365,7 @@ bool variant_type_impl<std::int32_t>::convert_to(variant_id type, void* to, cons
     const auto& v = *static_cast<const std::int32_t*>(from);
     switch (type) {
         case variant_id::string: {
-            *static_cast<std::string*>(to) = to_string(v);
+            assign_chars(to, v);
         } break;
         case variant_id::boolean: {
             *static_cast<bool*>(to) = v != 0;
@@ -219,7 +395,7 @@ bool variant_type_impl<std::uint32_t>::convert_to(variant_id type, void* to, con
     const auto& v = *static_cast<const std::uint32_t*>(from);
     switch (type) {
         case variant_id::string: {
-            *static_cast<std::string*>(to) = to_string(v);
+            assign_chars(to, v);
         } break;
         case variant_id::boolean: {
             *static_cast<bool*>(to) = v != 0;
@@ -254,7 +430,7 @@ bool variant_type_impl<std::int64_t>::convert_to(variant_id type, void* to, cons
     const auto& v = *static_cast<const std::int64_t*>(from);
     switch (type) {
         case variant_id::string: {
-            *static_cast<std::string*>(to) = to_string(v);
+            assign_chars(to, v);
         } break;
         case variant_id::boolean: {
             *static_cast<bool*>(to) = v != 0;
@@ -302,7 +478,7 @@ bool variant_type_impl<std::uint64_t>::convert_to(variant_id type, void* to, con
     const auto& v = *static_cast<const std::uint64_t*>(from);
     switch (type) {
         case variant_id::string: {
-            *static_cast<std::string*>(to) = to_string(v);
+            assign_chars(to, v);
         } break;
         case variant_id::boolean: {
             *static_cast<bool*>(to) = v != 0;
@@ -351,7 +527,7 @@ bool variant_type_impl<double>::convert_to(variant_id type, void* to, const void
     const auto& v = *static_cast<const double*>(from);
     switch (type) {
         case variant_id::string: {
-            *static_cast<std::string*>(to) = to_string(v, fmt_opts{fmt_flags::json_compat});
+            assign_chars(to, v, fmt_opts{fmt_flags::json_compat});
         } break;
         case variant_id::boolean: {
             *static_cast<bool*>(to) = v != 0;